@@ -137,6 +137,8 @@
 
 #define SO_RCVMARK		75
 
+#define SO_SENDTEMPLATE		76
+
 #if !defined(__KERNEL__)
 
 #if __BITS_PER_LONG == 64
@@ -129,6 +129,8 @@
 
 #define SO_RCVMARK		0x4049
 
+#define SO_SENDTEMPLATE		0x404A
+
 #if !defined(__KERNEL__)
 
 #if __BITS_PER_LONG == 64
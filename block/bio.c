@@ -28,11 +28,20 @@
 #define ALLOC_CACHE_THRESHOLD	16
 #define ALLOC_CACHE_MAX		256
 
+/*
+ * Cached bios on free_list_vecs keep a bvec array of this size attached,
+ * so allocations of up to this many segments can be served without
+ * touching the biovec slabs. Must match the smallest biovec slab size.
+ */
+#define ALLOC_CACHE_MAX_VECS	16
+
 struct bio_alloc_cache {
 	struct bio		*free_list;
 	struct bio		*free_list_irq;
+	struct bio		*free_list_vecs;
 	unsigned int		nr;
 	unsigned int		nr_irq;
+	unsigned int		nr_vecs;
 };
 
 static struct biovec_slab {
@@ -437,6 +446,27 @@ static struct bio *bio_alloc_percpu_cache(struct block_device *bdev,
 	struct bio *bio;
 
 	cache = per_cpu_ptr(bs->cache, get_cpu());
+
+	/*
+	 * Bios needing more than the inline vecs are served from the
+	 * separate list of cached bios that kept their small external
+	 * bvec array attached, so we don't go to the biovec slabs.
+	 */
+	if (nr_vecs > BIO_INLINE_VECS) {
+		bio = cache->free_list_vecs;
+		if (!bio) {
+			put_cpu();
+			return NULL;
+		}
+		cache->free_list_vecs = bio->bi_next;
+		cache->nr_vecs--;
+		put_cpu();
+
+		bio_init(bio, bdev, bio->bi_io_vec, ALLOC_CACHE_MAX_VECS, opf);
+		bio->bi_pool = bs;
+		return bio;
+	}
+
 	if (!cache->free_list) {
 		if (READ_ONCE(cache->nr_irq) >= ALLOC_CACHE_THRESHOLD)
 			bio_alloc_irq_cache_splice(cache);
@@ -502,7 +532,7 @@ struct bio *bio_alloc_bioset(struct block_device *bdev, unsigned short nr_vecs,
 		return NULL;
 
 	if (opf & REQ_ALLOC_CACHE) {
-		if (bs->cache && nr_vecs <= BIO_INLINE_VECS) {
+		if (bs->cache && nr_vecs <= ALLOC_CACHE_MAX_VECS) {
 			bio = bio_alloc_percpu_cache(bdev, nr_vecs, opf,
 						     gfp_mask, bs);
 			if (bio)
@@ -719,11 +749,19 @@ static int __bio_alloc_cache_prune(struct bio_alloc_cache *cache,
 static void bio_alloc_cache_prune(struct bio_alloc_cache *cache,
 				  unsigned int nr)
 {
+	struct bio *bio;
+
 	nr -= __bio_alloc_cache_prune(cache, nr);
 	if (!READ_ONCE(cache->free_list)) {
 		bio_alloc_irq_cache_splice(cache);
 		__bio_alloc_cache_prune(cache, nr);
 	}
+
+	while ((bio = cache->free_list_vecs) != NULL) {
+		cache->free_list_vecs = bio->bi_next;
+		cache->nr_vecs--;
+		bio_free(bio);
+	}
 }
 
 static int bio_cpu_dead(unsigned int cpu, struct hlist_node *node)
@@ -760,17 +798,44 @@ static void bio_alloc_cache_destroy(struct bio_set *bs)
 static inline void bio_put_percpu_cache(struct bio *bio)
 {
 	struct bio_alloc_cache *cache;
+	bool direct;
 
 	cache = per_cpu_ptr(bio->bi_pool->cache, get_cpu());
-	if (READ_ONCE(cache->nr_irq) + cache->nr > ALLOC_CACHE_MAX) {
+	if (READ_ONCE(cache->nr_irq) + cache->nr + cache->nr_vecs >
+	    ALLOC_CACHE_MAX) {
 		put_cpu();
 		bio_free(bio);
 		return;
 	}
 
 	bio_uninit(bio);
+	direct = (bio->bi_opf & REQ_POLLED) && !WARN_ON_ONCE(in_interrupt());
+
+	if (bio->bi_max_vecs > BIO_INLINE_VECS) {
+		if (direct && bio->bi_max_vecs == ALLOC_CACHE_MAX_VECS) {
+			/*
+			 * Keep the small external bvec array attached, so
+			 * the next multi-segment allocation skips the
+			 * biovec slabs entirely.
+			 */
+			bio->bi_next = cache->free_list_vecs;
+			bio->bi_bdev = NULL;
+			cache->free_list_vecs = bio;
+			cache->nr_vecs++;
+			put_cpu();
+			return;
+		}
+		/*
+		 * Oversized array, or freed from irq context: give the
+		 * array back and cache the bio itself with inline vecs.
+		 */
+		bvec_free(&bio->bi_pool->bvec_pool, bio->bi_io_vec,
+			  bio->bi_max_vecs);
+		bio->bi_io_vec = bio->bi_inline_vecs;
+		bio->bi_max_vecs = BIO_INLINE_VECS;
+	}
 
-	if ((bio->bi_opf & REQ_POLLED) && !WARN_ON_ONCE(in_interrupt())) {
+	if (direct) {
 		bio->bi_next = cache->free_list;
 		bio->bi_bdev = NULL;
 		cache->free_list = bio;
@@ -906,6 +906,41 @@ void blkg_conf_exit(struct blkg_conf_ctx *ctx)
 }
 EXPORT_SYMBOL_GPL(blkg_conf_exit);
 
+/*
+ * Reading io.stat used to flush the whole rstat tree synchronously, which
+ * walks every CPU's update lists under the rstat locks. With frequent
+ * monitoring across many cgroups that turns each read into a storm of
+ * cross-CPU work and disturbs isolated cores. Instead, a low-frequency
+ * worker on the unbound workqueue pushes the per-CPU deltas up the
+ * hierarchy, so reads are just seqcount-protected loads of the
+ * pre-aggregated per-blkg totals. Readers fall back to a synchronous
+ * flush only if the worker has not run for BLKCG_STAT_MAX_AGE, which
+ * bounds the staleness of what they see.
+ */
+#define BLKCG_STAT_FLUSH_PERIOD	(HZ / 2)
+#define BLKCG_STAT_MAX_AGE	HZ
+
+static unsigned long blkcg_last_stat_flush;
+static void blkcg_stat_flush_workfn(struct work_struct *work);
+static DECLARE_DELAYED_WORK(blkcg_stat_flush_work, blkcg_stat_flush_workfn);
+
+static void blkcg_stat_flush_workfn(struct work_struct *work)
+{
+	cgroup_rstat_flush(blkcg_root.css.cgroup);
+	WRITE_ONCE(blkcg_last_stat_flush, jiffies);
+	queue_delayed_work(system_unbound_wq, &blkcg_stat_flush_work,
+			   BLKCG_STAT_FLUSH_PERIOD);
+}
+
+static int __init blkcg_stat_flush_init(void)
+{
+	WRITE_ONCE(blkcg_last_stat_flush, jiffies);
+	queue_delayed_work(system_unbound_wq, &blkcg_stat_flush_work,
+			   BLKCG_STAT_FLUSH_PERIOD);
+	return 0;
+}
+late_initcall(blkcg_stat_flush_init);
+
 static void blkg_iostat_set(struct blkg_iostat *dst, struct blkg_iostat *src)
 {
 	int i;
@@ -1108,7 +1143,8 @@ static int blkcg_print_stat(struct seq_file *sf, void *v)
 
 	if (!seq_css(sf)->parent)
 		blkcg_fill_root_iostats();
-	else
+	else if (time_after(jiffies, READ_ONCE(blkcg_last_stat_flush) +
+			    BLKCG_STAT_MAX_AGE))
 		cgroup_rstat_flush(blkcg->css.cgroup);
 
 	rcu_read_lock();
@@ -251,12 +251,80 @@ static void blk_crypto_dun_to_iv(const u64 dun[BLK_CRYPTO_DUN_ARRAY_SIZE],
 		iv->dun[i] = cpu_to_le64(dun[i]);
 }
 
+/*
+ * Encrypt the bio's data in place, without allocating a bounce bio or bounce
+ * pages.  This is only done when the submitter set BIO_INPLACE_ENCRYPT, i.e.
+ * promised that it owns the pages exclusively and doesn't need the plaintext
+ * back; we cannot infer that ourselves, since pagecache and user pages are
+ * generally visible to other parties while under I/O.  Returns true on
+ * success. Returns false and sets bio->bi_status on error.
+ */
+static bool blk_crypto_fallback_encrypt_bio_inplace(struct bio *bio)
+{
+	struct bio_crypt_ctx *bc = bio->bi_crypt_context;
+	struct blk_crypto_keyslot *slot;
+	struct skcipher_request *ciph_req = NULL;
+	DECLARE_CRYPTO_WAIT(wait);
+	u64 curr_dun[BLK_CRYPTO_DUN_ARRAY_SIZE];
+	union blk_crypto_iv iv;
+	struct scatterlist sg;
+	struct bio_vec bv;
+	struct bvec_iter iter;
+	const int data_unit_size = bc->bc_key->crypto_cfg.data_unit_size;
+	unsigned int i;
+	bool ret = false;
+	blk_status_t blk_st;
+
+	blk_st = blk_crypto_get_keyslot(&blk_crypto_fallback_profile,
+					bc->bc_key, &slot);
+	if (blk_st != BLK_STS_OK) {
+		bio->bi_status = blk_st;
+		return false;
+	}
+
+	if (!blk_crypto_fallback_alloc_cipher_req(slot, &ciph_req, &wait)) {
+		bio->bi_status = BLK_STS_RESOURCE;
+		goto out_release_keyslot;
+	}
+
+	memcpy(curr_dun, bc->bc_dun, sizeof(curr_dun));
+	sg_init_table(&sg, 1);
+	skcipher_request_set_crypt(ciph_req, &sg, &sg, data_unit_size,
+				   iv.bytes);
+
+	/* Encrypt each segment in the bio */
+	bio_for_each_segment(bv, bio, iter) {
+		sg_set_page(&sg, bv.bv_page, data_unit_size, bv.bv_offset);
+
+		/* Encrypt each data unit in this segment */
+		for (i = 0; i < bv.bv_len; i += data_unit_size) {
+			blk_crypto_dun_to_iv(curr_dun, &iv);
+			if (crypto_wait_req(crypto_skcipher_encrypt(ciph_req),
+					    &wait)) {
+				bio->bi_status = BLK_STS_IOERR;
+				goto out;
+			}
+			bio_crypt_dun_increment(curr_dun, 1);
+			sg.offset += data_unit_size;
+		}
+	}
+	ret = true;
+out:
+	skcipher_request_free(ciph_req);
+out_release_keyslot:
+	blk_crypto_put_keyslot(slot);
+	return ret;
+}
+
 /*
  * The crypto API fallback's encryption routine.
  * Allocate a bounce bio for encryption, encrypt the input bio using crypto API,
  * and replace *bio_ptr with the bounce bio. May split input bio if it's too
  * large. Returns true on success. Returns false and sets bio->bi_status on
  * error.
+ *
+ * If the submitter flagged the bio with BIO_INPLACE_ENCRYPT, the data is
+ * instead encrypted in place and no bounce bio or bounce pages are allocated.
  */
 static bool blk_crypto_fallback_encrypt_bio(struct bio **bio_ptr)
 {
@@ -273,6 +341,9 @@ static bool blk_crypto_fallback_encrypt_bio(struct bio **bio_ptr)
 	bool ret = false;
 	blk_status_t blk_st;
 
+	if (bio_flagged(*bio_ptr, BIO_INPLACE_ENCRYPT))
+		return blk_crypto_fallback_encrypt_bio_inplace(*bio_ptr);
+
 	/* Split the bio if it's too big for single page bvec */
 	if (!blk_crypto_fallback_split_bio_if_needed(bio_ptr))
 		return false;
@@ -410,6 +410,8 @@ struct ioc {
 
 	struct ioc_params		params;
 	struct ioc_margins		margins;
+	/* per-CPU vtime each CPU may absorb before touching iocg->vtime */
+	u64				vtime_absorb_cap;
 	u32				period_us;
 	u32				timer_slack_ns;
 	u64				vrate_min;
@@ -449,6 +451,8 @@ struct ioc {
 
 struct iocg_pcpu_stat {
 	local64_t			abs_vusage;
+	/* vtime charged locally, not yet folded into iocg->vtime */
+	local64_t			vtime_pcpu;
 };
 
 struct iocg_stat {
@@ -727,6 +731,46 @@ static void iocg_commit_bio(struct ioc_gq *iocg, struct bio *bio,
 	put_cpu_ptr(gcs);
 }
 
+/*
+ * Like iocg_commit_bio() but the vtime charge is absorbed into a per-CPU
+ * counter instead of the shared atomic, which is what makes the happy
+ * path cheap on many-CPU machines.  Only used while the iocg is at least
+ * margins.min below vnow: each CPU may absorb up to vtime_absorb_cap
+ * before spilling into iocg->vtime, so the combined invisible charge
+ * stays under half the min margin and budget checks against the shared
+ * vtime remain conservative enough.  Absorbed charges are folded back by
+ * iocg_fold_vtime() on pressure onset and on every period boundary.
+ */
+static void iocg_absorb_bio(struct ioc_gq *iocg, struct bio *bio,
+			    u64 abs_cost, u64 cost)
+{
+	struct iocg_pcpu_stat *gcs;
+
+	bio->bi_iocost_cost = cost;
+
+	gcs = get_cpu_ptr(iocg->pcpu_stat);
+	local64_add(abs_cost, &gcs->abs_vusage);
+	local64_add(cost, &gcs->vtime_pcpu);
+	if (local64_read(&gcs->vtime_pcpu) >= iocg->ioc->vtime_absorb_cap)
+		atomic64_add(local64_xchg(&gcs->vtime_pcpu, 0), &iocg->vtime);
+	put_cpu_ptr(gcs);
+}
+
+static void iocg_fold_vtime(struct ioc_gq *iocg)
+{
+	u64 vtime = 0;
+	int cpu;
+
+	for_each_possible_cpu(cpu) {
+		struct iocg_pcpu_stat *gcs = per_cpu_ptr(iocg->pcpu_stat, cpu);
+
+		if (local64_read(&gcs->vtime_pcpu))
+			vtime += local64_xchg(&gcs->vtime_pcpu, 0);
+	}
+	if (vtime)
+		atomic64_add(vtime, &iocg->vtime);
+}
+
 static void iocg_lock(struct ioc_gq *iocg, bool lock_ioc, unsigned long *flags)
 {
 	if (lock_ioc) {
@@ -759,6 +803,13 @@ static void ioc_refresh_margins(struct ioc *ioc)
 	margins->min = (period_us * MARGIN_MIN_PCT / 100) * vrate;
 	margins->low = (period_us * MARGIN_LOW_PCT / 100) * vrate;
 	margins->target = (period_us * MARGIN_TARGET_PCT / 100) * vrate;
+
+	/*
+	 * Bound the sum of per-CPU absorbed vtime to half the min margin,
+	 * so that absorption can never push an iocg past vnow as long as
+	 * it's only used while at least min margin below it.
+	 */
+	ioc->vtime_absorb_cap = div_u64(margins->min, 2 * num_online_cpus());
 }
 
 /* latency Qos params changed, update period_us and all the dependent params */
@@ -1691,6 +1742,9 @@ static void iocg_flush_stat_leaf(struct ioc_gq *iocg, struct ioc_now *now)
 
 	lockdep_assert_held(&iocg->ioc->lock);
 
+	/* period boundary: settle absorbed vtime charges */
+	iocg_fold_vtime(iocg);
+
 	/* collect per-cpu counters */
 	for_each_possible_cpu(cpu) {
 		abs_vusage += local64_read(
@@ -2614,10 +2668,21 @@ static void ioc_rqos_throttle(struct rq_qos *rqos, struct bio *bio)
 	 */
 	if (!waitqueue_active(&iocg->waitq) && !iocg->abs_vdebt &&
 	    time_before_eq64(vtime + cost, now.vnow)) {
-		iocg_commit_bio(iocg, bio, abs_cost, cost);
+		if (ioc->vtime_absorb_cap &&
+		    time_before_eq64(vtime + cost, now.vnow - ioc->margins.min))
+			iocg_absorb_bio(iocg, bio, abs_cost, cost);
+		else
+			iocg_commit_bio(iocg, bio, abs_cost, cost);
 		return;
 	}
 
+	/*
+	 * Pressure is setting in.  Make the charges absorbed on other CPUs
+	 * visible so the debt and waitq handling below sees an accurate
+	 * vtime.
+	 */
+	iocg_fold_vtime(iocg);
+
 	/*
 	 * We're over budget. This can be handled in two ways. IOs which may
 	 * cause priority inversions are punted to @ioc->aux_iocg and charged as
@@ -12,6 +12,7 @@
 #include "blk-mq-debugfs.h"
 #include "blk-mq-sched.h"
 #include "blk-rq-qos.h"
+#include "blk-throttle.h"
 
 static int queue_poll_stat_show(void *data, struct seq_file *m)
 {
@@ -152,12 +153,25 @@ inval:
 	return count;
 }
 
+#ifdef CONFIG_BLK_DEV_THROTTLING
+static int queue_throtl_buckets_show(void *data, struct seq_file *m)
+{
+	struct request_queue *q = data;
+
+	blk_throtl_bucket_levels_show(q, m);
+	return 0;
+}
+#endif
+
 static const struct blk_mq_debugfs_attr blk_mq_debugfs_queue_attrs[] = {
 	{ "poll_stat", 0400, queue_poll_stat_show },
 	{ "requeue_list", 0400, .seq_ops = &queue_requeue_list_seq_ops },
 	{ "pm_only", 0600, queue_pm_only_show, NULL },
 	{ "state", 0600, queue_state_show, queue_state_write },
 	{ "zone_wlock", 0400, queue_zone_wlock_show, NULL },
+#ifdef CONFIG_BLK_DEV_THROTTLING
+	{ "throtl_buckets", 0400, queue_throtl_buckets_show, NULL },
+#endif
 	{ },
 };
 
@@ -401,6 +415,15 @@ static void blk_mq_debugfs_tags_show(struct seq_file *m,
 	seq_printf(m, "active_queues=%d\n",
 		   atomic_read(&tags->active_queues));
 
+	if (tags->cache) {
+		unsigned int cached = 0;
+		int cpu;
+
+		for_each_possible_cpu(cpu)
+			cached += READ_ONCE(per_cpu_ptr(tags->cache, cpu)->nr);
+		seq_printf(m, "tag_cache_occupancy=%u\n", cached);
+	}
+
 	seq_puts(m, "\nbitmap_tags:\n");
 	sbitmap_queue_show(&tags->bitmap_tags, m);
 
@@ -97,6 +97,91 @@ void __blk_mq_tag_idle(struct blk_mq_hw_ctx *hctx)
 	blk_mq_tag_wakeup_all(tags, false);
 }
 
+/*
+ * Per-CPU tag caching.  Freed driver tags are parked in a small per-CPU
+ * pool instead of being released to the shared sbitmap, and handed back
+ * out to allocations on the same CPU, which keeps tag recycling off the
+ * sbitmap word cachelines when many CPUs target one hardware queue.
+ *
+ * Tags are only cached while nobody is waiting for one: frees check
+ * ws_active under the pool lock, and anybody who joins a waitqueue (or
+ * marks an hctx for restart after a failed driver tag allocation)
+ * drains the pools back into the sbitmap first, so a cached tag can
+ * never strand a waiter.  Reserved tags, scheduler tags and tags of
+ * actively shared queues are never cached.
+ */
+unsigned int blk_mq_tag_cache_get(struct blk_mq_tags *tags)
+{
+	struct blk_mq_tag_cache *cache;
+	unsigned int tag = BLK_MQ_NO_TAG;
+	unsigned long flags;
+
+	if (!tags->cache)
+		return BLK_MQ_NO_TAG;
+
+	cache = raw_cpu_ptr(tags->cache);
+	spin_lock_irqsave(&cache->lock, flags);
+	if (cache->nr)
+		tag = cache->tags[--cache->nr];
+	spin_unlock_irqrestore(&cache->lock, flags);
+
+	return tag;
+}
+
+bool blk_mq_tag_cache_put(struct blk_mq_tags *tags, unsigned int tag)
+{
+	struct blk_mq_tag_cache *cache;
+	unsigned long flags;
+	bool cached = false;
+
+	if (!tags->cache || atomic_read(&tags->active_queues))
+		return false;
+
+	cache = raw_cpu_ptr(tags->cache);
+	spin_lock_irqsave(&cache->lock, flags);
+	/*
+	 * The ws_active check pairs with the drain waiters do after
+	 * raising ws_active: either their drain sees this tag, or we see
+	 * the raised count here and release the tag to the sbitmap so
+	 * the waiter is woken.  The pool lock orders the two.
+	 */
+	if (cache->nr < BLK_MQ_TAG_CACHE_SIZE &&
+	    !atomic_read(&tags->bitmap_tags.ws_active)) {
+		cache->tags[cache->nr++] = tag;
+		cached = true;
+	}
+	spin_unlock_irqrestore(&cache->lock, flags);
+
+	return cached;
+}
+
+void blk_mq_tag_cache_drain(struct blk_mq_tags *tags)
+{
+	int stash[BLK_MQ_TAG_CACHE_SIZE];
+	unsigned long flags;
+	unsigned int nr;
+	int cpu;
+
+	if (!tags->cache)
+		return;
+
+	for_each_possible_cpu(cpu) {
+		struct blk_mq_tag_cache *cache = per_cpu_ptr(tags->cache, cpu);
+
+		if (!READ_ONCE(cache->nr))
+			continue;
+		spin_lock_irqsave(&cache->lock, flags);
+		nr = cache->nr;
+		memcpy(stash, cache->tags, nr * sizeof(int));
+		cache->nr = 0;
+		spin_unlock_irqrestore(&cache->lock, flags);
+		if (nr)
+			sbitmap_queue_clear_batch(&tags->bitmap_tags,
+						  tags->nr_reserved_tags,
+						  stash, nr);
+	}
+}
+
 static int __blk_mq_get_tag(struct blk_mq_alloc_data *data,
 			    struct sbitmap_queue *bt)
 {
@@ -144,6 +229,19 @@ unsigned int blk_mq_get_tag(struct blk_mq_alloc_data *data)
 	} else {
 		bt = &tags->bitmap_tags;
 		tag_offset = tags->nr_reserved_tags;
+
+		if (!data->q->elevator && !data->shallow_depth &&
+		    !(data->hctx->flags & BLK_MQ_F_TAG_QUEUE_SHARED)) {
+			tag = blk_mq_tag_cache_get(tags);
+			if (tag != BLK_MQ_NO_TAG) {
+				if (unlikely(test_bit(BLK_MQ_S_INACTIVE,
+						      &data->hctx->state))) {
+					blk_mq_put_tag(tags, data->ctx, tag);
+					return BLK_MQ_NO_TAG;
+				}
+				return tag;
+			}
+		}
 	}
 
 	tag = __blk_mq_get_tag(data, bt);
@@ -174,6 +272,13 @@ unsigned int blk_mq_get_tag(struct blk_mq_alloc_data *data)
 
 		sbitmap_prepare_to_wait(bt, ws, &wait, TASK_UNINTERRUPTIBLE);
 
+		/*
+		 * ws_active is raised now, so frees can no longer park tags
+		 * in the per-CPU pools; reclaim whatever is parked before
+		 * committing to sleep.
+		 */
+		blk_mq_tag_cache_drain(tags);
+
 		tag = __blk_mq_get_tag(data, bt);
 		if (tag != BLK_MQ_NO_TAG)
 			break;
@@ -224,6 +329,8 @@ void blk_mq_put_tag(struct blk_mq_tags *tags, struct blk_mq_ctx *ctx,
 		const int real_tag = tag - tags->nr_reserved_tags;
 
 		BUG_ON(real_tag >= tags->nr_tags);
+		if (!ctx->queue->elevator && blk_mq_tag_cache_put(tags, tag))
+			return;
 		sbitmap_queue_clear(&tags->bitmap_tags, real_tag, ctx->cpu);
 	} else {
 		sbitmap_queue_clear(&tags->breserved_tags, tag, ctx->cpu);
@@ -583,11 +690,34 @@ struct blk_mq_tags *blk_mq_init_tags(unsigned int total_tags,
 		kfree(tags);
 		return NULL;
 	}
+
 	return tags;
 }
 
+/*
+ * Caching tags per CPU only pays off when the depth comfortably exceeds
+ * one pool, and is never done for shared tagsets, whose fairness
+ * accounting the cache would bypass.  Allocation failure just means no
+ * cache.
+ */
+void blk_mq_tag_cache_init(struct blk_mq_tags *tags)
+{
+	if (tags->nr_tags - tags->nr_reserved_tags <
+	    4 * BLK_MQ_TAG_CACHE_SIZE)
+		return;
+
+	tags->cache = alloc_percpu(struct blk_mq_tag_cache);
+	if (tags->cache) {
+		int cpu;
+
+		for_each_possible_cpu(cpu)
+			spin_lock_init(&per_cpu_ptr(tags->cache, cpu)->lock);
+	}
+}
+
 void blk_mq_free_tags(struct blk_mq_tags *tags)
 {
+	free_percpu(tags->cache);
 	sbitmap_queue_free(&tags->bitmap_tags);
 	sbitmap_queue_free(&tags->breserved_tags);
 	kfree(tags);
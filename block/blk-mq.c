@@ -1748,6 +1748,13 @@ static bool __blk_mq_alloc_driver_tag(struct request *rq)
 	} else {
 		if (!hctx_may_queue(rq->mq_hctx, bt))
 			return false;
+		if (!(rq->mq_hctx->flags & BLK_MQ_F_TAG_QUEUE_SHARED)) {
+			tag = blk_mq_tag_cache_get(rq->mq_hctx->tags);
+			if (tag != BLK_MQ_NO_TAG) {
+				rq->tag = tag;
+				return true;
+			}
+		}
 	}
 
 	tag = __sbitmap_queue_get(bt);
@@ -1811,6 +1818,14 @@ static bool blk_mq_mark_tag_wait(struct blk_mq_hw_ctx *hctx,
 	    !(blk_mq_is_shared_tags(hctx->flags))) {
 		blk_mq_sched_mark_restart_hctx(hctx);
 
+		/*
+		 * Tags parked in the per-CPU caches of other CPUs are
+		 * invisible to the allocation above; push them back to the
+		 * sbitmap before the final retry so an idle queue cannot
+		 * strand this request.
+		 */
+		blk_mq_tag_cache_drain(hctx->tags);
+
 		/*
 		 * It's possible that a tag was freed in the window between the
 		 * allocation failure and adding the hardware queue to the wait
@@ -2817,6 +2832,104 @@ out:
 		blk_mq_commit_rqs(hctx, queued, false);
 }
 
+/*
+ * Software aggregation stage for plugless submissions.  When a queue sets
+ * dispatch_aggr_usec, requests which would otherwise go to the driver one
+ * at a time are staged per-hctx and handed to ->queue_rqs() in a single
+ * call - either once a batch has built up or when the timer expires -
+ * mirroring what blk_mq_flush_plug_list() does for plugged IO.  Like the
+ * plug fast path this bypasses the active request count, so shared tags
+ * are excluded.
+ */
+#define BLK_MQ_AGGR_MAX_BATCH	32
+
+static void blk_mq_aggr_dispatch(struct blk_mq_hw_ctx *hctx,
+				 struct request *rqlist)
+{
+	struct request_queue *q = hctx->queue;
+	struct request *rq;
+	bool inserted = false;
+
+	if (!blk_queue_quiesced(q) && !blk_mq_hctx_stopped(hctx))
+		blk_mq_run_dispatch_ops(q, q->mq_ops->queue_rqs(&rqlist));
+
+	/*
+	 * Anything the driver could not take now (or everything, if the
+	 * queue is quiesced or stopped) goes the ordinary insert path.
+	 */
+	while ((rq = rq_list_pop(&rqlist))) {
+		blk_mq_request_bypass_insert(rq, 0);
+		inserted = true;
+	}
+	if (inserted)
+		blk_mq_run_hw_queue(hctx, false);
+}
+
+static void blk_mq_aggr_flush(struct blk_mq_hw_ctx *hctx)
+{
+	struct request *rqlist;
+	unsigned long flags;
+
+	spin_lock_irqsave(&hctx->aggr_lock, flags);
+	rqlist = hctx->aggr_list;
+	hctx->aggr_list = NULL;
+	hctx->aggr_count = 0;
+	spin_unlock_irqrestore(&hctx->aggr_lock, flags);
+
+	if (rqlist)
+		blk_mq_aggr_dispatch(hctx, rqlist);
+}
+
+static void blk_mq_aggr_work_fn(struct work_struct *work)
+{
+	struct blk_mq_hw_ctx *hctx = container_of(work, struct blk_mq_hw_ctx,
+						  aggr_work);
+
+	blk_mq_aggr_flush(hctx);
+}
+
+static enum hrtimer_restart blk_mq_aggr_timer_fn(struct hrtimer *timer)
+{
+	struct blk_mq_hw_ctx *hctx = container_of(timer, struct blk_mq_hw_ctx,
+						  aggr_timer);
+
+	kblockd_schedule_work(&hctx->aggr_work);
+	return HRTIMER_NORESTART;
+}
+
+static bool blk_mq_aggr_add(struct blk_mq_hw_ctx *hctx, struct request *rq)
+{
+	struct request_queue *q = hctx->queue;
+	unsigned int usec = READ_ONCE(q->dispatch_aggr_usec);
+	struct request *rqlist = NULL;
+	unsigned long flags;
+	bool first;
+
+	if (!usec || !q->mq_ops->queue_rqs ||
+	    (hctx->flags & BLK_MQ_F_TAG_QUEUE_SHARED))
+		return false;
+
+	spin_lock_irqsave(&hctx->aggr_lock, flags);
+	rq_list_add(&hctx->aggr_list, rq);
+	first = hctx->aggr_count++ == 0;
+	if (hctx->aggr_count >= BLK_MQ_AGGR_MAX_BATCH) {
+		rqlist = hctx->aggr_list;
+		hctx->aggr_list = NULL;
+		hctx->aggr_count = 0;
+	}
+	spin_unlock_irqrestore(&hctx->aggr_lock, flags);
+
+	if (rqlist) {
+		hrtimer_try_to_cancel(&hctx->aggr_timer);
+		blk_mq_aggr_dispatch(hctx, rqlist);
+	} else if (first) {
+		hrtimer_start(&hctx->aggr_timer,
+			      ns_to_ktime((u64)usec * NSEC_PER_USEC),
+			      HRTIMER_MODE_REL);
+	}
+	return true;
+}
+
 static bool blk_mq_attempt_bio_merge(struct request_queue *q,
 				     struct bio *bio, unsigned int nr_segs)
 {
@@ -2985,7 +3098,7 @@ void blk_mq_submit_bio(struct bio *bio)
 	    (hctx->dispatch_busy && (q->nr_hw_queues == 1 || !is_sync))) {
 		blk_mq_insert_request(rq, 0);
 		blk_mq_run_hw_queue(hctx, true);
-	} else {
+	} else if (!blk_mq_aggr_add(hctx, rq)) {
 		blk_mq_run_dispatch_ops(q, blk_mq_try_issue_directly(hctx, rq));
 	}
 }
@@ -3303,6 +3416,9 @@ static struct blk_mq_tags *blk_mq_alloc_rq_map(struct blk_mq_tag_set *set,
 	if (!tags)
 		return NULL;
 
+	if (!blk_mq_is_shared_tags(set->flags))
+		blk_mq_tag_cache_init(tags);
+
 	tags->rqs = kcalloc_node(nr_tags, sizeof(struct request *),
 				 GFP_NOIO | __GFP_NOWARN | __GFP_NORETRY,
 				 node);
@@ -3578,6 +3694,10 @@ static void blk_mq_exit_hctx(struct request_queue *q,
 {
 	struct request *flush_rq = hctx->fq->flush_rq;
 
+	hrtimer_cancel(&hctx->aggr_timer);
+	cancel_work_sync(&hctx->aggr_work);
+	blk_mq_aggr_flush(hctx);
+
 	if (blk_mq_hw_queue_mapped(hctx))
 		blk_mq_tag_idle(hctx);
 
@@ -3671,6 +3791,10 @@ blk_mq_alloc_hctx(struct request_queue *q, struct blk_mq_tag_set *set,
 	INIT_DELAYED_WORK(&hctx->run_work, blk_mq_run_work_fn);
 	spin_lock_init(&hctx->lock);
 	INIT_LIST_HEAD(&hctx->dispatch);
+	spin_lock_init(&hctx->aggr_lock);
+	hrtimer_init(&hctx->aggr_timer, CLOCK_MONOTONIC, HRTIMER_MODE_REL);
+	hctx->aggr_timer.function = blk_mq_aggr_timer_fn;
+	INIT_WORK(&hctx->aggr_work, blk_mq_aggr_work_fn);
 	hctx->queue = q;
 	hctx->flags = set->flags & ~BLK_MQ_F_TAG_QUEUE_SHARED;
 
@@ -3932,6 +4056,20 @@ static void blk_mq_update_tag_set_shared(struct blk_mq_tag_set *set,
 		queue_set_hctx_shared(q, shared);
 		blk_mq_unfreeze_queue(q);
 	}
+
+	/*
+	 * Tags cached per CPU before sharing began are invisible to the
+	 * fairness accounting; give them back to the sbitmap.
+	 */
+	if (shared) {
+		struct blk_mq_hw_ctx *hctx;
+		unsigned long i;
+
+		q = list_first_entry(&set->tag_list, struct request_queue,
+				     tag_set_list);
+		queue_for_each_hw_ctx(q, hctx, i)
+			blk_mq_tag_cache_drain(hctx->tags);
+	}
 }
 
 static void blk_mq_del_queue_tag_set(struct request_queue *q)
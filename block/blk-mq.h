@@ -172,6 +172,23 @@ int blk_mq_init_bitmaps(struct sbitmap_queue *bitmap_tags,
 		struct sbitmap_queue *breserved_tags, unsigned int queue_depth,
 		unsigned int reserved, int node, int alloc_policy);
 
+#define BLK_MQ_TAG_CACHE_SIZE	8
+
+/*
+ * Per-CPU stash of freed driver tags, layered over tags->bitmap_tags.
+ * See the comment above blk_mq_tag_cache_get() in blk-mq-tag.c.
+ */
+struct blk_mq_tag_cache {
+	spinlock_t		lock;
+	unsigned int		nr;
+	int			tags[BLK_MQ_TAG_CACHE_SIZE];
+};
+
+void blk_mq_tag_cache_init(struct blk_mq_tags *tags);
+unsigned int blk_mq_tag_cache_get(struct blk_mq_tags *tags);
+bool blk_mq_tag_cache_put(struct blk_mq_tags *tags, unsigned int tag);
+void blk_mq_tag_cache_drain(struct blk_mq_tags *tags);
+
 unsigned int blk_mq_get_tag(struct blk_mq_alloc_data *data);
 unsigned long blk_mq_get_tags(struct blk_mq_alloc_data *data, int nr_tags,
 		unsigned int *offset);
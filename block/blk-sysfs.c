@@ -451,6 +451,29 @@ static ssize_t queue_io_timeout_store(struct request_queue *q, const char *page,
 	return count;
 }
 
+static ssize_t queue_dispatch_aggr_usec_show(struct request_queue *q,
+					     char *page)
+{
+	return queue_var_show(q->dispatch_aggr_usec, page);
+}
+
+static ssize_t queue_dispatch_aggr_usec_store(struct request_queue *q,
+					      const char *page, size_t count)
+{
+	unsigned long usec;
+	ssize_t ret;
+
+	ret = queue_var_store(&usec, page, count);
+	if (ret < 0)
+		return ret;
+	/* Holding requests back for more than a millisecond is a misconfig */
+	if (usec > 1000)
+		return -EINVAL;
+
+	WRITE_ONCE(q->dispatch_aggr_usec, usec);
+	return ret;
+}
+
 static ssize_t queue_wb_lat_show(struct request_queue *q, char *page)
 {
 	if (!wbt_rq_qos(q))
@@ -506,6 +529,40 @@ static ssize_t queue_wb_lat_store(struct request_queue *q, const char *page,
 	return count;
 }
 
+static ssize_t queue_wb_lat_percentile_show(struct request_queue *q,
+					    char *page)
+{
+	if (!wbt_rq_qos(q))
+		return -EINVAL;
+
+	return queue_var_show(wbt_get_lat_percentile(q), page);
+}
+
+static ssize_t queue_wb_lat_percentile_store(struct request_queue *q,
+					     const char *page, size_t count)
+{
+	unsigned long val;
+	ssize_t ret;
+
+	ret = queue_var_store(&val, page, count);
+	if (ret < 0)
+		return ret;
+
+	/*
+	 * 0 selects the classic min-latency mode; otherwise wbt scales
+	 * against the given read latency percentile. Targets below the
+	 * median make no sense for a tail latency goal.
+	 */
+	if (val && (val < 50 || val > 99))
+		return -EINVAL;
+
+	if (!wbt_rq_qos(q))
+		return -EINVAL;
+
+	wbt_set_lat_percentile(q, val);
+	return ret;
+}
+
 static ssize_t queue_wc_show(struct request_queue *q, char *page)
 {
 	if (test_bit(QUEUE_FLAG_WC, &q->queue_flags))
@@ -599,6 +656,8 @@ QUEUE_RO_ENTRY(queue_fua, "fua");
 QUEUE_RO_ENTRY(queue_dax, "dax");
 QUEUE_RW_ENTRY(queue_io_timeout, "io_timeout");
 QUEUE_RW_ENTRY(queue_wb_lat, "wbt_lat_usec");
+QUEUE_RW_ENTRY(queue_wb_lat_percentile, "wbt_lat_percentile");
+QUEUE_RW_ENTRY(queue_dispatch_aggr_usec, "dispatch_aggr_usec");
 QUEUE_RO_ENTRY(queue_virt_boundary_mask, "virt_boundary_mask");
 QUEUE_RO_ENTRY(queue_dma_alignment, "dma_alignment");
 
@@ -656,8 +715,10 @@ static struct attribute *queue_attrs[] = {
 	&queue_fua_entry.attr,
 	&queue_dax_entry.attr,
 	&queue_wb_lat_entry.attr,
+	&queue_wb_lat_percentile_entry.attr,
 	&queue_poll_delay_entry.attr,
 	&queue_io_timeout_entry.attr,
+	&queue_dispatch_aggr_usec_entry.attr,
 #ifdef CONFIG_BLK_DEV_THROTTLING_LOW
 	&blk_throtl_sample_time_entry.attr,
 #endif
@@ -676,6 +737,10 @@ static umode_t queue_attr_visible(struct kobject *kobj, struct attribute *attr,
 		(!q->mq_ops || !q->mq_ops->timeout))
 			return 0;
 
+	if (attr == &queue_dispatch_aggr_usec_entry.attr &&
+		(!q->mq_ops || !q->mq_ops->queue_rqs))
+			return 0;
+
 	if ((attr == &queue_max_open_zones_entry.attr ||
 	     attr == &queue_max_active_zones_entry.attr) &&
 	    !blk_queue_is_zoned(q))
@@ -88,6 +88,7 @@ struct throtl_data
 };
 
 static void throtl_pending_timer_fn(struct timer_list *t);
+static enum hrtimer_restart throtl_pending_hrtimer_fn(struct hrtimer *t);
 
 static inline struct blkcg_gq *tg_to_blkg(struct throtl_grp *tg)
 {
@@ -333,6 +334,9 @@ static void throtl_service_queue_init(struct throtl_service_queue *sq)
 	INIT_LIST_HEAD(&sq->queued[WRITE]);
 	sq->pending_tree = RB_ROOT_CACHED;
 	timer_setup(&sq->pending_timer, throtl_pending_timer_fn, 0);
+	hrtimer_init(&sq->pending_hrtimer, CLOCK_MONOTONIC,
+		     HRTIMER_MODE_REL_SOFT);
+	sq->pending_hrtimer.function = throtl_pending_hrtimer_fn;
 }
 
 static struct blkg_policy_data *throtl_pd_alloc(struct gendisk *disk,
@@ -491,6 +495,7 @@ static void throtl_pd_free(struct blkg_policy_data *pd)
 	struct throtl_grp *tg = pd_to_tg(pd);
 
 	del_timer_sync(&tg->service_queue.pending_timer);
+	hrtimer_cancel(&tg->service_queue.pending_hrtimer);
 	blkg_rwstat_exit(&tg->stat_bytes);
 	blkg_rwstat_exit(&tg->stat_ios);
 	kfree(tg);
@@ -524,6 +529,7 @@ static void update_min_dispatch_time(struct throtl_service_queue *parent_sq)
 		return;
 
 	parent_sq->first_pending_disptime = tg->disptime;
+	parent_sq->first_pending_disptime_ns = tg->disptime_ns;
 }
 
 static void tg_service_queue_add(struct throtl_grp *tg)
@@ -539,7 +545,10 @@ static void tg_service_queue_add(struct throtl_grp *tg)
 		parent = *node;
 		__tg = rb_entry_tg(parent);
 
-		if (time_before(key, __tg->disptime))
+		if (time_before(key, __tg->disptime) ||
+		    (key == __tg->disptime && tg->disptime_ns &&
+		     (!__tg->disptime_ns ||
+		      tg->disptime_ns < __tg->disptime_ns)))
 			node = &parent->rb_left;
 		else {
 			node = &parent->rb_right;
@@ -593,6 +602,17 @@ static void throtl_schedule_pending_timer(struct throtl_service_queue *sq,
 		   expires - jiffies, jiffies);
 }
 
+/* Call with queue lock held */
+static void throtl_schedule_pending_hrtimer(struct throtl_service_queue *sq,
+					    u64 expires_ns)
+{
+	u64 delay_ns = expires_ns - ktime_get_ns();
+
+	hrtimer_start(&sq->pending_hrtimer, ns_to_ktime(delay_ns),
+		      HRTIMER_MODE_REL_SOFT);
+	throtl_log(sq, "schedule hrtimer. delay=%lluns", delay_ns);
+}
+
 /**
  * throtl_schedule_next_dispatch - schedule the next dispatch cycle
  * @sq: the service_queue to schedule dispatch for
@@ -620,6 +640,36 @@ static bool throtl_schedule_next_dispatch(struct throtl_service_queue *sq,
 
 	update_min_dispatch_time(sq);
 
+	/*
+	 * If the first pending child runs a token bucket, its deadline is
+	 * typically inside the current jiffy.  The wheel timer would either
+	 * round the wait up to a full jiffy or leave the caller spinning in
+	 * the dispatch loop, so arm the hrtimer on the precise deadline
+	 * instead.  A deadline already in the past means the bucket has
+	 * refilled meanwhile; tell the caller to keep dispatching.
+	 *
+	 * The wheel deadline may stem from the other, non-bucket direction
+	 * and fall before the bucket deadline, so arm whichever expires
+	 * first - otherwise the un-bucketed direction would sit on the
+	 * bucket's timer for up to the full bucket wait.
+	 */
+	if (!force && sq->first_pending_disptime_ns) {
+		u64 now_ns = ktime_get_ns();
+
+		if (sq->first_pending_disptime_ns <= now_ns ||
+		    !time_after(sq->first_pending_disptime, jiffies))
+			return false;
+
+		if (jiffies_to_nsecs(sq->first_pending_disptime - jiffies) <
+		    sq->first_pending_disptime_ns - now_ns)
+			throtl_schedule_pending_timer(sq,
+					sq->first_pending_disptime);
+		else
+			throtl_schedule_pending_hrtimer(sq,
+					sq->first_pending_disptime_ns);
+		return true;
+	}
+
 	/* is the next dispatch time in the future? */
 	if (force || time_after(sq->first_pending_disptime, jiffies)) {
 		throtl_schedule_pending_timer(sq, sq->first_pending_disptime);
@@ -847,6 +897,58 @@ static unsigned long tg_within_iops_limit(struct throtl_grp *tg, struct bio *bio
 	return jiffy_wait;
 }
 
+static inline bool tg_bucket_enabled(struct throtl_grp *tg, bool rw)
+{
+	return tg->burst_bytes[rw] != 0;
+}
+
+/*
+ * Refill the token bucket up to now.  Tokens accumulate at @bps_limit and
+ * are capped at the configured burst size; they may go negative when a bio
+ * larger than the current fill is charged, which simply pushes the next
+ * dispatch further out.
+ */
+static void tg_bucket_refill(struct throtl_grp *tg, bool rw, u64 bps_limit)
+{
+	u64 now = ktime_get_ns();
+
+	if (!tg->bucket_last_ns[rw]) {
+		/* first use after (re)configuration, start with a full burst */
+		tg->bucket_tokens[rw] = tg->burst_bytes[rw];
+		tg->bucket_last_ns[rw] = now;
+		return;
+	}
+
+	tg->bucket_tokens[rw] += mul_u64_u64_div_u64(bps_limit,
+					now - tg->bucket_last_ns[rw],
+					NSEC_PER_SEC);
+	tg->bucket_last_ns[rw] = now;
+	if (tg->bucket_tokens[rw] > (s64)tg->burst_bytes[rw])
+		tg->bucket_tokens[rw] = tg->burst_bytes[rw];
+}
+
+/*
+ * Nanoseconds until @bio fits in the bucket.  A bio larger than the burst
+ * becomes dispatchable once the bucket is full so that it can't stall
+ * forever; charging it then drives the bucket negative and the debt is paid
+ * off before the next dispatch.
+ */
+static u64 tg_bucket_wait_ns(struct throtl_grp *tg, struct bio *bio,
+			     u64 bps_limit)
+{
+	bool rw = bio_data_dir(bio);
+	u64 need = min_t(u64, throtl_bio_data_size(bio), tg->burst_bytes[rw]);
+	s64 short_by;
+
+	tg_bucket_refill(tg, rw, bps_limit);
+
+	short_by = (s64)need - tg->bucket_tokens[rw];
+	if (short_by <= 0)
+		return 0;
+
+	return mul_u64_u64_div_u64((u64)short_by, NSEC_PER_SEC, bps_limit);
+}
+
 static unsigned long tg_within_bps_limit(struct throtl_grp *tg, struct bio *bio,
 				u64 bps_limit)
 {
@@ -860,6 +962,21 @@ static unsigned long tg_within_bps_limit(struct throtl_grp *tg, struct bio *bio,
 		return 0;
 	}
 
+	/*
+	 * Token bucket mode: the bucket holds the precise state, no slice
+	 * rounding is involved.  The jiffy wait returned here is a rounded-up
+	 * view for the pending tree; the exact deadline is published through
+	 * bucket_wait_ns so that the hrtimer can fire inside the jiffy.
+	 */
+	if (tg_bucket_enabled(tg, rw)) {
+		u64 wait_ns = tg_bucket_wait_ns(tg, bio, bps_limit);
+
+		tg->bucket_wait_ns[rw] = wait_ns;
+		if (!wait_ns)
+			return 0;
+		return max_t(unsigned long, nsecs_to_jiffies(wait_ns), 1);
+	}
+
 	jiffy_elapsed = jiffy_elapsed_rnd = jiffies - tg->slice_start[rw];
 
 	/* Slice has just started. Consider one slice interval */
@@ -900,6 +1017,8 @@ static bool tg_may_dispatch(struct throtl_grp *tg, struct bio *bio,
 	u64 bps_limit = tg_bps_limit(tg, rw);
 	u32 iops_limit = tg_iops_limit(tg, rw);
 
+	tg->bucket_wait_ns[rw] = 0;
+
 	/*
  	 * Currently whole state machine of group depends on first bio
 	 * queued in the group bio list. So one should not be calling
@@ -946,6 +1065,17 @@ static bool tg_may_dispatch(struct throtl_grp *tg, struct bio *bio,
 	if (wait)
 		*wait = max_wait;
 
+	/*
+	 * When the token bucket provided the bps wait it is exact; leave it
+	 * in bucket_wait_ns so that tg_update_disptime() can arm a sub-jiffy
+	 * deadline.  If the iops wait dominates, or no bucket is configured,
+	 * jiffy granularity is all we have.
+	 */
+	if (!tg_bucket_enabled(tg, rw))
+		tg->bucket_wait_ns[rw] = U64_MAX;
+	else if (iops_wait > bps_wait)
+		tg->bucket_wait_ns[rw] = jiffies_to_nsecs(max_wait);
+
 	if (time_before(tg->slice_end[rw], jiffies + max_wait))
 		throtl_extend_slice(tg, rw, jiffies + max_wait);
 
@@ -961,6 +1091,15 @@ static void throtl_charge_bio(struct throtl_grp *tg, struct bio *bio)
 	if (!bio_flagged(bio, BIO_BPS_THROTTLED)) {
 		tg->bytes_disp[rw] += bio_size;
 		tg->last_bytes_disp[rw] += bio_size;
+
+		if (tg_bucket_enabled(tg, rw)) {
+			u64 bps_limit = tg_bps_limit(tg, rw);
+
+			if (bps_limit != U64_MAX) {
+				tg_bucket_refill(tg, rw, bps_limit);
+				tg->bucket_tokens[rw] -= bio_size;
+			}
+		}
 	}
 
 	tg->io_disp[rw]++;
@@ -1004,22 +1143,37 @@ static void tg_update_disptime(struct throtl_grp *tg)
 {
 	struct throtl_service_queue *sq = &tg->service_queue;
 	unsigned long read_wait = -1, write_wait = -1, min_wait = -1, disptime;
+	u64 read_wait_ns = U64_MAX, write_wait_ns = U64_MAX, min_wait_ns;
 	struct bio *bio;
 
 	bio = throtl_peek_queued(&sq->queued[READ]);
-	if (bio)
+	if (bio) {
 		tg_may_dispatch(tg, bio, &read_wait);
+		read_wait_ns = tg->bucket_wait_ns[READ];
+	}
 
 	bio = throtl_peek_queued(&sq->queued[WRITE]);
-	if (bio)
+	if (bio) {
 		tg_may_dispatch(tg, bio, &write_wait);
+		write_wait_ns = tg->bucket_wait_ns[WRITE];
+	}
 
 	min_wait = min(read_wait, write_wait);
+	min_wait_ns = min(read_wait_ns, write_wait_ns);
 	disptime = jiffies + min_wait;
 
 	/* Update dispatch time */
 	throtl_rb_erase(&tg->rb_node, tg->service_queue.parent_sq);
 	tg->disptime = disptime;
+	/*
+	 * Keep the precise deadline when a token bucket determined the wait;
+	 * U64_MAX means jiffy granularity and 0 means dispatchable now, both
+	 * of which are handled fine by the coarse disptime alone.
+	 */
+	if (min_wait_ns && min_wait_ns != U64_MAX)
+		tg->disptime_ns = ktime_get_ns() + min_wait_ns;
+	else
+		tg->disptime_ns = 0;
 	tg_service_queue_add(tg);
 
 	/* see throtl_add_bio_tg() */
@@ -1127,7 +1281,8 @@ static int throtl_select_dispatch(struct throtl_service_queue *parent_sq)
 		if (!tg)
 			break;
 
-		if (time_before(jiffies, tg->disptime))
+		if (time_before(jiffies, tg->disptime) &&
+		    !(tg->disptime_ns && ktime_get_ns() >= tg->disptime_ns))
 			break;
 
 		nr_disp += throtl_dispatch_tg(tg);
@@ -1148,23 +1303,21 @@ static int throtl_select_dispatch(struct throtl_service_queue *parent_sq)
 static bool throtl_can_upgrade(struct throtl_data *td,
 	struct throtl_grp *this_tg);
 /**
- * throtl_pending_timer_fn - timer function for service_queue->pending_timer
- * @t: the pending_timer member of the throtl_service_queue being serviced
+ * throtl_pending_dispatch - dispatch expired bio's of a service_queue
+ * @sq: the throtl_service_queue being serviced
  *
- * This timer is armed when a child throtl_grp with active bio's become
- * pending and queued on the service_queue's pending_tree and expires when
- * the first child throtl_grp should be dispatched.  This function
- * dispatches bio's from the children throtl_grps to the parent
- * service_queue.
+ * Runs when @sq->pending_timer or @sq->pending_hrtimer expires, i.e. when
+ * the first child throtl_grp queued on the service_queue's pending_tree
+ * should be dispatched.  This function dispatches bio's from the children
+ * throtl_grps to the parent service_queue.
  *
  * If the parent's parent is another throtl_grp, dispatching is propagated
  * by either arming its pending_timer or repeating dispatch directly.  If
  * the top-level service_tree is reached, throtl_data->dispatch_work is
  * kicked so that the ready bio's are issued.
  */
-static void throtl_pending_timer_fn(struct timer_list *t)
+static void throtl_pending_dispatch(struct throtl_service_queue *sq)
 {
-	struct throtl_service_queue *sq = from_timer(sq, t, pending_timer);
 	struct throtl_grp *tg = sq_to_tg(sq);
 	struct throtl_data *td = sq_to_td(sq);
 	struct throtl_service_queue *parent_sq;
@@ -1232,6 +1385,22 @@ out_unlock:
 	spin_unlock_irq(&q->queue_lock);
 }
 
+static void throtl_pending_timer_fn(struct timer_list *t)
+{
+	struct throtl_service_queue *sq = from_timer(sq, t, pending_timer);
+
+	throtl_pending_dispatch(sq);
+}
+
+static enum hrtimer_restart throtl_pending_hrtimer_fn(struct hrtimer *t)
+{
+	struct throtl_service_queue *sq = container_of(t,
+				struct throtl_service_queue, pending_hrtimer);
+
+	throtl_pending_dispatch(sq);
+	return HRTIMER_NORESTART;
+}
+
 /**
  * blk_throtl_dispatch_work_fn - work function for throtl_data->dispatch_work
  * @work: work item being executed
@@ -1491,6 +1660,8 @@ static u64 tg_prfill_limit(struct seq_file *sf, struct blkg_policy_data *pd,
 	unsigned int iops_dft;
 	char idle_time[26] = "";
 	char latency_time[26] = "";
+	char burst_r[29] = "";
+	char burst_w[29] = "";
 
 	if (!dname)
 		return 0;
@@ -1537,10 +1708,18 @@ static u64 tg_prfill_limit(struct seq_file *sf, struct blkg_policy_data *pd,
 			snprintf(latency_time, sizeof(latency_time),
 				" latency=%lu", tg->latency_target_conf);
 	}
+	if (off == LIMIT_MAX) {
+		if (tg->burst_bytes[READ])
+			snprintf(burst_r, sizeof(burst_r), " rburst=%llu",
+				tg->burst_bytes[READ]);
+		if (tg->burst_bytes[WRITE])
+			snprintf(burst_w, sizeof(burst_w), " wburst=%llu",
+				tg->burst_bytes[WRITE]);
+	}
 
-	seq_printf(sf, "%s rbps=%s wbps=%s riops=%s wiops=%s%s%s\n",
+	seq_printf(sf, "%s rbps=%s wbps=%s riops=%s wiops=%s%s%s%s%s\n",
 		   dname, bufs[0], bufs[1], bufs[2], bufs[3], idle_time,
-		   latency_time);
+		   latency_time, burst_r, burst_w);
 	return 0;
 }
 
@@ -1558,9 +1737,11 @@ static ssize_t tg_set_limit(struct kernfs_open_file *of,
 	struct blkg_conf_ctx ctx;
 	struct throtl_grp *tg;
 	u64 v[4];
+	u64 burst[2];
 	unsigned long idle_time;
 	unsigned long latency_time;
 	int ret;
+	int rw;
 	int index = of_cft(of)->private;
 
 	blkg_conf_init(&ctx, buf);
@@ -1577,6 +1758,10 @@ static ssize_t tg_set_limit(struct kernfs_open_file *of,
 	v[2] = tg->iops_conf[READ][index];
 	v[3] = tg->iops_conf[WRITE][index];
 
+	/* 0 means no bucket configured, represented as "max" to the user */
+	burst[READ] = tg->burst_bytes[READ] ?: U64_MAX;
+	burst[WRITE] = tg->burst_bytes[WRITE] ?: U64_MAX;
+
 	idle_time = tg->idletime_threshold_conf;
 	latency_time = tg->latency_target_conf;
 	while (true) {
@@ -1610,6 +1795,10 @@ static ssize_t tg_set_limit(struct kernfs_open_file *of,
 			v[2] = min_t(u64, val, UINT_MAX);
 		else if (!strcmp(tok, "wiops") && val > 1)
 			v[3] = min_t(u64, val, UINT_MAX);
+		else if (index == LIMIT_MAX && !strcmp(tok, "rburst"))
+			burst[READ] = val;
+		else if (index == LIMIT_MAX && !strcmp(tok, "wburst"))
+			burst[WRITE] = val;
 		else if (off == LIMIT_LOW && !strcmp(tok, "idle"))
 			idle_time = val;
 		else if (off == LIMIT_LOW && !strcmp(tok, "latency"))
@@ -1637,6 +1826,18 @@ static ssize_t tg_set_limit(struct kernfs_open_file *of,
 		tg->iops_conf[READ][LIMIT_MAX]);
 	tg->iops[WRITE][LIMIT_LOW] = min(tg->iops_conf[WRITE][LIMIT_LOW],
 		tg->iops_conf[WRITE][LIMIT_MAX]);
+
+	for (rw = READ; rw <= WRITE; rw++) {
+		u64 new_burst = burst[rw] == U64_MAX ? 0 : burst[rw];
+
+		if (new_burst != tg->burst_bytes[rw]) {
+			tg->burst_bytes[rw] = new_burst;
+			/* restart with a full burst on next use */
+			tg->bucket_tokens[rw] = 0;
+			tg->bucket_last_ns[rw] = 0;
+		}
+	}
+
 	tg->idletime_threshold_conf = idle_time;
 	tg->latency_target_conf = latency_time;
 
@@ -2413,6 +2614,7 @@ void blk_throtl_exit(struct gendisk *disk)
 
 	BUG_ON(!q->td);
 	del_timer_sync(&q->td->service_queue.pending_timer);
+	hrtimer_cancel(&q->td->service_queue.pending_hrtimer);
 	throtl_shutdown_wq(q);
 	blkcg_deactivate_policy(disk, &blkcg_policy_throtl);
 	free_percpu(q->td->latency_buckets[READ]);
@@ -2451,6 +2653,42 @@ void blk_throtl_register(struct gendisk *disk)
 #endif
 }
 
+/*
+ * Dump the token bucket levels of every group with a configured burst, for
+ * tuning burst sizes from debugfs.  The values are read locklessly and are
+ * only an instantaneous snapshot.
+ */
+void blk_throtl_bucket_levels_show(struct request_queue *q, struct seq_file *m)
+{
+	struct cgroup_subsys_state *pos_css;
+	struct blkcg_gq *blkg;
+
+	rcu_read_lock();
+	if (!q->root_blkg)
+		goto out;
+
+	blkg_for_each_descendant_pre(blkg, pos_css, q->root_blkg) {
+		struct throtl_grp *tg = blkg_to_tg(blkg);
+		char path[128];
+		int rw;
+
+		if (!tg)
+			continue;
+
+		cgroup_path(blkg->blkcg->css.cgroup, path, sizeof(path));
+		for (rw = READ; rw <= WRITE; rw++) {
+			if (!tg->burst_bytes[rw])
+				continue;
+			seq_printf(m, "%s %c tokens=%lld burst=%llu\n",
+				   path, rw == READ ? 'R' : 'W',
+				   tg->bucket_tokens[rw],
+				   tg->burst_bytes[rw]);
+		}
+	}
+out:
+	rcu_read_unlock();
+}
+
 #ifdef CONFIG_BLK_DEV_THROTTLING_LOW
 ssize_t blk_throtl_sample_time_show(struct request_queue *q, char *page)
 {
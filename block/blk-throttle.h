@@ -1,6 +1,8 @@
 #ifndef BLK_THROTTLE_H
 #define BLK_THROTTLE_H
 
+#include <linux/hrtimer.h>
+
 #include "blk-cgroup-rwstat.h"
 
 /*
@@ -50,6 +52,16 @@ struct throtl_service_queue {
 	unsigned int		nr_pending;	/* # queued in the tree */
 	unsigned long		first_pending_disptime;	/* disptime of the first tg */
 	struct timer_list	pending_timer;	/* fires on first_pending_disptime */
+
+	/*
+	 * When the first pending tg runs a high-resolution token bucket its
+	 * dispatch deadline is known to nanosecond accuracy and usually falls
+	 * inside the current jiffy.  first_pending_disptime_ns mirrors that
+	 * deadline (0 if the first tg is jiffy-granular) and pending_hrtimer
+	 * is armed on it instead of pending_timer.
+	 */
+	u64			first_pending_disptime_ns;
+	struct hrtimer		pending_hrtimer;
 };
 
 enum tg_state_flags {
@@ -95,6 +107,20 @@ struct throtl_grp {
 	 */
 	unsigned long disptime;
 
+	/*
+	 * High-resolution token bucket state for the bps limits, enabled per
+	 * direction by configuring a nonzero burst size ("rburst"/"wburst" in
+	 * io.max).  Tokens accumulate at the bps limit, are capped at
+	 * burst_bytes and may go negative when a bio larger than the current
+	 * fill is charged.  When burst_bytes is 0 the jiffy-granular slice
+	 * machinery is used unchanged.
+	 */
+	uint64_t burst_bytes[2];
+	int64_t bucket_tokens[2];
+	u64 bucket_last_ns[2];		/* last refill timestamp */
+	u64 bucket_wait_ns[2];		/* wait computed by tg_may_dispatch() */
+	u64 disptime_ns;		/* hires dispatch deadline, 0 if none */
+
 	unsigned int flags;
 
 	/* are there any throtl rules between this group and td? */
@@ -179,6 +205,7 @@ void blk_throtl_exit(struct gendisk *disk);
 void blk_throtl_register(struct gendisk *disk);
 bool __blk_throtl_bio(struct bio *bio);
 void blk_throtl_cancel_bios(struct gendisk *disk);
+void blk_throtl_bucket_levels_show(struct request_queue *q, struct seq_file *m);
 
 static inline bool blk_should_throtl(struct bio *bio)
 {
@@ -89,6 +89,8 @@ struct rq_wb {
 	unsigned long last_issue;		/* last non-throttled issue */
 	unsigned long last_comp;		/* last non-throttled comp */
 	unsigned long min_lat_nsec;
+	unsigned int lat_percentile;		/* 0 = classic min-latency mode */
+	u64 lat_pctl_nsec;			/* last computed estimate */
 	struct rq_qos rqos;
 	struct rq_wait rq_wait[WBT_NUM_RWQ];
 	struct rq_depth rq_depth;
@@ -141,6 +143,14 @@ enum {
 	 * information to scale up or down, scale up.
 	 */
 	RWB_UNKNOWN_BUMP	= 5,
+
+	/*
+	 * Read completions are binned into log2 latency buckets, bucket i
+	 * covering [2^i, 2^(i+1)) usec, so we can estimate latency
+	 * percentiles instead of just tracking the window minimum. The
+	 * last bucket catches everything from ~33msec up.
+	 */
+	RWB_LAT_BUCKETS		= 16,
 };
 
 static inline bool rwb_enabled(struct rq_wb *rwb)
@@ -310,6 +320,35 @@ enum {
 	LAT_EXCEEDED,
 };
 
+/*
+ * Estimate the latency that lat_percentile percent of the reads in the
+ * last window stayed under, from the log2 histogram in the stats
+ * callback buckets. We use the max sample of the bucket the percentile
+ * falls into, so the estimate is an upper bound built from real
+ * completions rather than a bucket boundary.
+ */
+static u64 rwb_read_lat_pctl(struct rq_wb *rwb)
+{
+	struct blk_rq_stat *stat = rwb->cb->stat;
+	u32 nr_samples = 0, thresh, found = 0;
+	int i;
+
+	for (i = 0; i < RWB_LAT_BUCKETS; i++)
+		nr_samples += stat[i].nr_samples;
+
+	if (!nr_samples)
+		return 0;
+
+	thresh = DIV_ROUND_UP(nr_samples * rwb->lat_percentile, 100);
+	for (i = 0; i < RWB_LAT_BUCKETS; i++) {
+		found += stat[i].nr_samples;
+		if (found >= thresh)
+			return stat[i].max;
+	}
+
+	return 0;
+}
+
 static int latency_exceeded(struct rq_wb *rwb, struct blk_rq_stat *stat)
 {
 	struct backing_dev_info *bdi = rwb->rqos.disk->bdi;
@@ -349,9 +388,20 @@ static int latency_exceeded(struct rq_wb *rwb, struct blk_rq_stat *stat)
 	}
 
 	/*
-	 * If the 'min' latency exceeds our target, step down.
+	 * In percentile mode, step down if the estimated percentile
+	 * latency exceeds our target. Otherwise step down if the 'min'
+	 * latency does.
 	 */
-	if (stat[READ].min > rwb->min_lat_nsec) {
+	if (rwb->lat_percentile) {
+		u64 plat = rwb_read_lat_pctl(rwb);
+
+		rwb->lat_pctl_nsec = plat;
+		if (plat > rwb->min_lat_nsec) {
+			trace_wbt_lat(bdi, plat);
+			trace_wbt_stat(bdi, stat);
+			return LAT_EXCEEDED;
+		}
+	} else if (stat[READ].min > rwb->min_lat_nsec) {
 		trace_wbt_lat(bdi, stat[READ].min);
 		trace_wbt_stat(bdi, stat);
 		return LAT_EXCEEDED;
@@ -433,12 +483,28 @@ static void wb_timer_fn(struct blk_stat_callback *cb)
 	struct rq_wb *rwb = cb->data;
 	struct rq_depth *rqd = &rwb->rq_depth;
 	unsigned int inflight = wbt_inflight(rwb);
-	int status;
+	struct blk_rq_stat stat[2];
+	int status, i;
 
 	if (!rwb->rqos.disk)
 		return;
 
-	status = latency_exceeded(rwb, cb->stat);
+	/*
+	 * Collapse the read latency histogram into the aggregate read
+	 * stat that the min-latency checks work from. The buckets have
+	 * already been flushed, so rebuild the batch that
+	 * blk_rq_stat_sum() folds the mean from.
+	 */
+	blk_rq_stat_init(&stat[READ]);
+	for (i = 0; i < RWB_LAT_BUCKETS; i++) {
+		struct blk_rq_stat tmp = cb->stat[i];
+
+		tmp.batch = tmp.mean * tmp.nr_samples;
+		blk_rq_stat_sum(&stat[READ], &tmp);
+	}
+	stat[WRITE] = cb->stat[RWB_LAT_BUCKETS];
+
+	status = latency_exceeded(rwb, stat);
 
 	trace_wbt_timer(rwb->rqos.disk->bdi, status, rqd->scale_step, inflight);
 
@@ -530,6 +596,24 @@ void wbt_set_min_lat(struct request_queue *q, u64 val)
 	wbt_update_limits(RQWB(rqos));
 }
 
+unsigned int wbt_get_lat_percentile(struct request_queue *q)
+{
+	struct rq_qos *rqos = wbt_rq_qos(q);
+	if (!rqos)
+		return 0;
+	return RQWB(rqos)->lat_percentile;
+}
+
+void wbt_set_lat_percentile(struct request_queue *q, unsigned int val)
+{
+	struct rq_qos *rqos = wbt_rq_qos(q);
+	if (!rqos)
+		return;
+
+	RQWB(rqos)->lat_percentile = val;
+	RQWB(rqos)->lat_pctl_nsec = 0;
+}
+
 
 static bool close_io(struct rq_wb *rwb)
 {
@@ -765,14 +849,22 @@ u64 wbt_default_latency_nsec(struct request_queue *q)
 		return 75000000ULL;
 }
 
-static int wbt_data_dir(const struct request *rq)
+static int wbt_stat_bucket(const struct request *rq)
 {
 	const enum req_op op = req_op(rq);
+	u64 lat;
 
-	if (op == REQ_OP_READ)
-		return READ;
-	else if (op_is_write(op))
-		return WRITE;
+	if (op == REQ_OP_READ) {
+		u64 now = ktime_get_ns();
+
+		if (now <= rq->io_start_time_ns)
+			return 0;
+		lat = div_u64(now - rq->io_start_time_ns, NSEC_PER_USEC);
+		if (lat <= 1)
+			return 0;
+		return min_t(int, ilog2(lat), RWB_LAT_BUCKETS - 1);
+	} else if (op_is_write(op))
+		return RWB_LAT_BUCKETS;
 
 	/* don't account */
 	return -1;
@@ -858,6 +950,36 @@ static int wbt_min_lat_nsec_show(void *data, struct seq_file *m)
 	return 0;
 }
 
+static int wbt_lat_percentile_show(void *data, struct seq_file *m)
+{
+	struct rq_qos *rqos = data;
+	struct rq_wb *rwb = RQWB(rqos);
+
+	seq_printf(m, "%u\n", rwb->lat_percentile);
+	return 0;
+}
+
+static int wbt_lat_pctl_nsec_show(void *data, struct seq_file *m)
+{
+	struct rq_qos *rqos = data;
+	struct rq_wb *rwb = RQWB(rqos);
+
+	seq_printf(m, "%llu\n", rwb->lat_pctl_nsec);
+	return 0;
+}
+
+static int wbt_read_lat_hist_show(void *data, struct seq_file *m)
+{
+	struct rq_qos *rqos = data;
+	struct rq_wb *rwb = RQWB(rqos);
+	int i;
+
+	for (i = 0; i < RWB_LAT_BUCKETS; i++)
+		seq_printf(m, "%u: <%uus samples %u\n", i,
+			   2U << i, rwb->cb->stat[i].nr_samples);
+	return 0;
+}
+
 static int wbt_unknown_cnt_show(void *data, struct seq_file *m)
 {
 	struct rq_qos *rqos = data;
@@ -890,7 +1012,10 @@ static const struct blk_mq_debugfs_attr wbt_debugfs_attrs[] = {
 	{"enabled", 0400, wbt_enabled_show},
 	{"id", 0400, wbt_id_show},
 	{"inflight", 0400, wbt_inflight_show},
+	{"lat_percentile", 0400, wbt_lat_percentile_show},
+	{"lat_pctl_nsec", 0400, wbt_lat_pctl_nsec_show},
 	{"min_lat_nsec", 0400, wbt_min_lat_nsec_show},
+	{"read_lat_hist", 0400, wbt_read_lat_hist_show},
 	{"unknown_cnt", 0400, wbt_unknown_cnt_show},
 	{"wb_normal", 0400, wbt_normal_show},
 	{"wb_background", 0400, wbt_background_show},
@@ -923,7 +1048,8 @@ int wbt_init(struct gendisk *disk)
 	if (!rwb)
 		return -ENOMEM;
 
-	rwb->cb = blk_stat_alloc_callback(wb_timer_fn, wbt_data_dir, 2, rwb);
+	rwb->cb = blk_stat_alloc_callback(wb_timer_fn, wbt_stat_bucket,
+					  RWB_LAT_BUCKETS + 1, rwb);
 	if (!rwb->cb) {
 		kfree(rwb);
 		return -ENOMEM;
@@ -10,6 +10,8 @@ void wbt_enable_default(struct gendisk *disk);
 
 u64 wbt_get_min_lat(struct request_queue *q);
 void wbt_set_min_lat(struct request_queue *q, u64 val);
+unsigned int wbt_get_lat_percentile(struct request_queue *q);
+void wbt_set_lat_percentile(struct request_queue *q, unsigned int val);
 bool wbt_disabled(struct request_queue *);
 
 void wbt_set_write_cache(struct request_queue *, bool);
@@ -38,6 +40,14 @@ static inline u64 wbt_get_min_lat(struct request_queue *q)
 static inline void wbt_set_min_lat(struct request_queue *q, u64 val)
 {
 }
+static inline unsigned int wbt_get_lat_percentile(struct request_queue *q)
+{
+	return 0;
+}
+static inline void wbt_set_lat_percentile(struct request_queue *q,
+					  unsigned int val)
+{
+}
 static inline u64 wbt_default_latency_nsec(struct request_queue *q)
 {
 	return 0;
@@ -70,6 +70,27 @@ bool blk_req_needs_zone_write_lock(struct request *rq)
 }
 EXPORT_SYMBOL_GPL(blk_req_needs_zone_write_lock);
 
+/*
+ * The per-zone write lock caps a zone at one write in flight, and that
+ * QD1 is a property of the hardware contract, not of this code: a
+ * regular write to a sequential zone must arrive at exactly the write
+ * pointer, and nothing below us guarantees order between two in-flight
+ * writes (SATA NCQ in particular may reorder at will), so two
+ * outstanding writes to one zone is an unaligned-write error waiting
+ * to happen.  Zone-append emulation (sd_zbc already does wp tracking
+ * and LBA patching for SMR disks) cannot lift this either - an
+ * emulated append becomes one of those regular writes the moment an
+ * LBA is assigned, and pipelining assigned-LBA writes adds a failure
+ * mode with no good recovery: the first failed write invalidates the
+ * LBA of every append queued behind it, forcing the emulation layer to
+ * unwind and reissue a pipeline the caller believed accepted.  Native
+ * ZONE_APPEND sustains deep queues precisely because the device picks
+ * the LBA at completion, eliminating the ordering requirement; on
+ * devices without it, per-zone QD1 is the honest ceiling, and
+ * throughput comes from writing many zones in parallel - which is the
+ * pattern zoned filesystems (btrfs, zonefs users, f2fs) are built
+ * around.
+ */
 bool blk_req_zone_write_trylock(struct request *rq)
 {
 	unsigned int zno = blk_rq_zone_no(rq);
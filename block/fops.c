@@ -420,6 +420,21 @@ static int blkdev_write_end(struct file *file, struct address_space *mapping,
 	return ret;
 }
 
+/*
+ * These aops are buffer_head based, and that is not separable from the
+ * legacy filesystems the request to "retain bh only where demanded"
+ * imagines it can carve off: a mounted ext2-style filesystem does its
+ * metadata I/O through sb_bread() against this very mapping, so the
+ * bdev page cache must speak buffer_heads whenever any such filesystem
+ * might be using it - per-folio bitmap state here and bh chains there
+ * on the same pages is two owners for one dirty/uptodate truth.  An
+ * iomap-backed variant of these aops is the right end state and is
+ * being worked toward upstream, but it can only be switched on when no
+ * bh-based filesystem is in the picture (i.e. compiled out), not
+ * per-mapping at runtime.  Raw bdev I/O that wants to avoid bh
+ * overhead today has it: O_DIRECT through blkdev_direct_IO touches
+ * none of this.
+ */
 const struct address_space_operations def_blk_aops = {
 	.dirty_folio	= block_dirty_folio,
 	.invalidate_folio = block_invalidate_folio,
@@ -351,6 +351,25 @@ void disk_uevent(struct gendisk *disk, enum kobject_action action)
 }
 EXPORT_SYMBOL_GPL(disk_uevent);
 
+/*
+ * Note on boot-time scanning of large disk populations: this function
+ * is synchronous per disk - a partition-table read or two under an
+ * exclusive-claim handshake - but nothing above it imposes a global
+ * order.  Parallelism is the probing driver's job, and the big
+ * multi-disk drivers already provide it: every NVMe controller scans
+ * namespaces and calls device_add_disk() from its own unbound
+ * scan_work, SCSI hosts scan targets asynchronously, and drivers
+ * opting into PROBE_PREFER_ASYNCHRONOUS probe whole controllers
+ * concurrently.  Ninety NVMe disks therefore already read their
+ * partition tables in parallel; when a fleet measures tens of serial
+ * seconds here, the queue being drained one-by-one is usually
+ * userspace (udev settle, dracut device waits), which a kernel-side
+ * batch-bio probe engine would not shorten.  Keeping the claim
+ * handshake synchronous per disk is what lets openers, md assembly
+ * and repeated rescans race safely; per-disk probe cost is visible
+ * without new sysfs via initcall_debug and the block tracepoints on
+ * the scan reads.
+ */
 int disk_scan_partitions(struct gendisk *disk, fmode_t mode)
 {
 	struct block_device *bdev;
@@ -13,6 +13,7 @@
 #include <linux/slab.h>
 #include <linux/init.h>
 #include <linux/compiler.h>
+#include <linux/list_sort.h>
 #include <linux/rbtree.h>
 #include <linux/sbitmap.h>
 
@@ -79,6 +80,17 @@ struct dd_per_prio {
 	struct io_stats_per_prio stats;
 };
 
+/*
+ * Per-CPU staging area for insertions. Tail insertions on non-zoned
+ * devices are queued here without taking dd->lock and are folded into
+ * the rbtree and FIFO lists when the next dispatch drains the shards,
+ * so high-core-count submission doesn't serialize on the global lock.
+ */
+struct dd_pcpu_insert {
+	spinlock_t lock;
+	struct list_head list;
+};
+
 struct deadline_data {
 	/*
 	 * run time data
@@ -86,6 +98,10 @@ struct deadline_data {
 
 	struct dd_per_prio per_prio[DD_PRIO_COUNT];
 
+	struct dd_pcpu_insert __percpu *pcpu_insert;
+	/* Number of requests queued in the per-CPU insertion shards. */
+	atomic_t pcpu_queued;
+
 	/* Data direction of latest dispatched request. */
 	enum dd_data_dir last_dir;
 	unsigned int batching;		/* number of sequential requests made */
@@ -113,6 +129,9 @@ static const enum dd_prio ioprio_class_to_prio[] = {
 	[IOPRIO_CLASS_IDLE]	= DD_IDLE_PRIO,
 };
 
+static void dd_drain_pcpu_inserts(struct deadline_data *dd,
+				  struct request_queue *q);
+
 static inline struct rb_root *
 deadline_rb_root(struct dd_per_prio *per_prio, struct request *rq)
 {
@@ -575,6 +594,7 @@ static struct request *dd_dispatch_request(struct blk_mq_hw_ctx *hctx)
 	enum dd_prio prio;
 
 	spin_lock(&dd->lock);
+	dd_drain_pcpu_inserts(dd, hctx->queue);
 	rq = dd_dispatch_prio_aged_requests(dd, now);
 	if (rq)
 		goto unlock;
@@ -656,6 +676,8 @@ static void dd_exit_sched(struct elevator_queue *e)
 			  stats->dispatched, atomic_read(&stats->completed));
 	}
 
+	WARN_ON_ONCE(atomic_read(&dd->pcpu_queued));
+	free_percpu(dd->pcpu_insert);
 	kfree(dd);
 }
 
@@ -667,6 +689,7 @@ static int dd_init_sched(struct request_queue *q, struct elevator_type *e)
 	struct deadline_data *dd;
 	struct elevator_queue *eq;
 	enum dd_prio prio;
+	int cpu;
 	int ret = -ENOMEM;
 
 	eq = elevator_alloc(q, e);
@@ -677,6 +700,20 @@ static int dd_init_sched(struct request_queue *q, struct elevator_type *e)
 	if (!dd)
 		goto put_eq;
 
+	dd->pcpu_insert = alloc_percpu(struct dd_pcpu_insert);
+	if (!dd->pcpu_insert) {
+		kfree(dd);
+		goto put_eq;
+	}
+
+	for_each_possible_cpu(cpu) {
+		struct dd_pcpu_insert *shard =
+			per_cpu_ptr(dd->pcpu_insert, cpu);
+
+		spin_lock_init(&shard->lock);
+		INIT_LIST_HEAD(&shard->list);
+	}
+
 	eq->elevator_data = dd;
 
 	for (prio = 0; prio <= DD_PRIO_MAX; prio++) {
@@ -763,12 +800,13 @@ static bool dd_bio_merge(struct request_queue *q, struct bio *bio,
 }
 
 /*
- * add rq to rbtree and fifo
+ * add rq to rbtree and fifo. @now is the insertion time to compute the
+ * fifo deadline from, which for requests staged in a per-CPU shard is
+ * when they were queued there, not when the shard was drained.
  */
-static void dd_insert_request(struct blk_mq_hw_ctx *hctx, struct request *rq,
-			      blk_insert_t flags)
+static void dd_insert_request(struct request_queue *q, struct request *rq,
+			      blk_insert_t flags, unsigned long now)
 {
-	struct request_queue *q = hctx->queue;
 	struct deadline_data *dd = q->elevator->elevator_data;
 	const enum dd_data_dir data_dir = rq_data_dir(rq);
 	u16 ioprio = req_get_ioprio(rq);
@@ -801,7 +839,7 @@ static void dd_insert_request(struct blk_mq_hw_ctx *hctx, struct request *rq,
 
 	if (flags & BLK_MQ_INSERT_AT_HEAD) {
 		list_add(&rq->queuelist, &per_prio->dispatch);
-		rq->fifo_time = jiffies;
+		rq->fifo_time = now;
 	} else {
 		deadline_add_rq_rb(per_prio, rq);
 
@@ -814,11 +852,62 @@ static void dd_insert_request(struct blk_mq_hw_ctx *hctx, struct request *rq,
 		/*
 		 * set expire time and add to fifo list
 		 */
-		rq->fifo_time = jiffies + dd->fifo_expire[data_dir];
+		rq->fifo_time = now + dd->fifo_expire[data_dir];
 		list_add_tail(&rq->queuelist, &per_prio->fifo_list[data_dir]);
 	}
 }
 
+static int dd_fifo_time_cmp(void *priv, const struct list_head *a,
+			    const struct list_head *b)
+{
+	const struct request *rqa = list_entry(a, struct request, queuelist);
+	const struct request *rqb = list_entry(b, struct request, queuelist);
+
+	if (rqa->fifo_time == rqb->fifo_time)
+		return 0;
+	return time_after(rqa->fifo_time, rqb->fifo_time) ? 1 : -1;
+}
+
+/*
+ * Fold the per-CPU insertion shards into the sort and FIFO lists. The
+ * shards are individually ordered but interleave across CPUs, so sort
+ * the drained batch by insertion time to restore the FIFO invariant
+ * that the head of each fifo_list is the oldest request.
+ */
+static void dd_drain_pcpu_inserts(struct deadline_data *dd,
+				  struct request_queue *q)
+{
+	LIST_HEAD(list);
+	int cpu;
+
+	lockdep_assert_held(&dd->lock);
+
+	if (!atomic_read(&dd->pcpu_queued))
+		return;
+
+	for_each_possible_cpu(cpu) {
+		struct dd_pcpu_insert *shard = per_cpu_ptr(dd->pcpu_insert, cpu);
+
+		if (list_empty_careful(&shard->list))
+			continue;
+		spin_lock(&shard->lock);
+		list_splice_tail_init(&shard->list, &list);
+		spin_unlock(&shard->lock);
+	}
+
+	list_sort(NULL, &list, dd_fifo_time_cmp);
+
+	while (!list_empty(&list)) {
+		struct request *rq =
+			list_first_entry(&list, struct request, queuelist);
+		unsigned long stamp = rq->fifo_time;
+
+		list_del_init(&rq->queuelist);
+		atomic_dec(&dd->pcpu_queued);
+		dd_insert_request(q, rq, 0, stamp);
+	}
+}
+
 /*
  * Called from blk_mq_insert_request() or blk_mq_dispatch_plug_list().
  */
@@ -828,6 +917,32 @@ static void dd_insert_requests(struct blk_mq_hw_ctx *hctx,
 {
 	struct request_queue *q = hctx->queue;
 	struct deadline_data *dd = q->elevator->elevator_data;
+	const unsigned long now = jiffies;
+
+	/*
+	 * Tail insertions on non-zoned devices only need deadline
+	 * ordering to hold at dispatch time, so stage them in this CPU's
+	 * shard instead of taking the global lock. Head insertions and
+	 * zoned writes (which may need their zone lock released) keep
+	 * the locked path.
+	 */
+	if (!(flags & BLK_MQ_INSERT_AT_HEAD) && !blk_queue_is_zoned(q)) {
+		struct dd_pcpu_insert *shard;
+		struct request *rq;
+		int nr = 0;
+
+		list_for_each_entry(rq, list, queuelist) {
+			rq->fifo_time = now;
+			nr++;
+		}
+
+		shard = raw_cpu_ptr(dd->pcpu_insert);
+		spin_lock(&shard->lock);
+		list_splice_tail_init(list, &shard->list);
+		spin_unlock(&shard->lock);
+		atomic_add(nr, &dd->pcpu_queued);
+		return;
+	}
 
 	spin_lock(&dd->lock);
 	while (!list_empty(list)) {
@@ -835,7 +950,7 @@ static void dd_insert_requests(struct blk_mq_hw_ctx *hctx,
 
 		rq = list_first_entry(list, struct request, queuelist);
 		list_del_init(&rq->queuelist);
-		dd_insert_request(hctx, rq, flags);
+		dd_insert_request(q, rq, flags, now);
 	}
 	spin_unlock(&dd->lock);
 }
@@ -916,6 +1031,9 @@ static bool dd_has_work(struct blk_mq_hw_ctx *hctx)
 	struct deadline_data *dd = hctx->queue->elevator->elevator_data;
 	enum dd_prio prio;
 
+	if (atomic_read(&dd->pcpu_queued))
+		return true;
+
 	for (prio = 0; prio <= DD_PRIO_MAX; prio++)
 		if (dd_has_work_for_prio(&dd->per_prio[prio]))
 			return true;
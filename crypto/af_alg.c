@@ -531,6 +531,20 @@ static const struct net_proto_family alg_family = {
 	.owner	=	THIS_MODULE,
 };
 
+/*
+ * This is the zero-copy half of AF_ALG: the pages backing the caller's
+ * recvmsg iovec are pinned and handed to the cipher as the destination
+ * (or in-place source/destination) scatterlist, so results land in user
+ * memory without a bounce.  The submission direction can avoid its copy
+ * too, by vmsplice()ing the plaintext into a pipe and splice()ing that
+ * to the socket - the spliced pages go onto tsgl_list by reference.  An
+ * io_uring-style registered-buffer uAPI has been suggested to make the
+ * pinning persistent across requests; it would save only the
+ * get/put_page cycle per request (the sg setup remains), and a second
+ * buffer-registration registry alongside io_uring's is not worth that.
+ * Callers who need registered buffers and batched completions should
+ * drive AF_ALG through io_uring, which composes with this path as-is.
+ */
 int af_alg_make_sg(struct af_alg_sgl *sgl, struct iov_iter *iter, int len)
 {
 	size_t off;
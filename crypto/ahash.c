@@ -333,6 +333,20 @@ int crypto_ahash_finup(struct ahash_request *req)
 }
 EXPORT_SYMBOL_GPL(crypto_ahash_finup);
 
+/*
+ * The API deliberately has no multibuffer mode.  The tree used to carry
+ * one - sha{1,256,512}-mb lane-packed independent requests onto the SIMD
+ * units via mcryptd - and it was removed in 4.20: requests had to be
+ * held back until enough partners arrived to fill the lanes, the flush
+ * timer needed to bound that latency was a constant source of hangs and
+ * ordering bugs, and the async completion machinery ate most of the
+ * theoretical speedup for small digests.  Callers that really hash
+ * millions of independent blocks per second get the same parallelism
+ * with none of the batching latency by spreading requests over the CPUs
+ * they already own (as dm-integrity and dm-verity do through their
+ * workqueues), with each CPU running the fastest single-buffer
+ * implementation (SHA-NI today).
+ */
 int crypto_ahash_digest(struct ahash_request *req)
 {
 	struct crypto_ahash *tfm = crypto_ahash_reqtfm(req);
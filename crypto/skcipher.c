@@ -634,6 +634,21 @@ int crypto_skcipher_setkey(struct crypto_skcipher *tfm, const u8 *key,
 }
 EXPORT_SYMBOL_GPL(crypto_skcipher_setkey);
 
+/*
+ * A batched submission API (one call, N same-geometry requests) has been
+ * proposed repeatedly to amortise per-request overhead for callers like
+ * dm-crypt that encrypt long runs of 4k sectors.  It would not buy what
+ * its proponents expect: the expanded key schedule already lives in the
+ * tfm and is shared by every request, and the walk state is cheap to set
+ * up compared to the per-sector work that cannot be shared - each sector
+ * needs its own IV (XTS tweak, ESSIV), so a batch call would just move
+ * the per-sector loop from the caller into the core without removing
+ * anything from it.  The x86 AES implementations get their pipelining by
+ * interleaving blocks *within* a request; the way to feed them better is
+ * larger requests, i.e. pushing IV generation into the algorithm (the
+ * essiv template, dm-crypt's IV generators) so one request can span many
+ * sectors.
+ */
 int crypto_skcipher_encrypt(struct skcipher_request *req)
 {
 	struct crypto_skcipher *tfm = crypto_skcipher_reqtfm(req);
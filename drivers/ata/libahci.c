@@ -2035,6 +2035,26 @@ static irqreturn_t ahci_single_level_irq_intr(int irq, void *dev_instance)
 	return IRQ_RETVAL(rc);
 }
 
+/*
+ * Issue is one posted MMIO write per command by construction: libata
+ * hands commands to ->qc_issue() one at a time with no commit/doorbell
+ * step, so there is no point in the stack where several slots could be
+ * accumulated into one PORT_CMD_ISSUE write without inventing that
+ * plumbing through libata and SCSI - and the write being posted, the
+ * saving would be tens of nanoseconds per command against the risk of
+ * holding issued-but-unrung commands across unrelated code.  On the
+ * completion side, the AHCI spec's answer to interrupt-per-completion
+ * is CCC (command completion coalescing, CAP.CCCS), which this driver
+ * has never wired up: CCC funnels coalesced completions through a
+ * single dedicated interrupt/port slot, which fights the per-port MSI
+ * vectors modern HBAs (and this driver's multi-MSI mode) are built
+ * around, and its timer granularity is 1ms - already above the latency
+ * budget that would make software coalescing attractive.  A 60-disk
+ * JBOD eating a core in interrupts is better served by spreading the
+ * per-port vectors across CPUs and letting the disks' own queue depth
+ * do the batching per hardirq (ahci_handle_port_intr already completes
+ * every finished tag in one pass).
+ */
 unsigned int ahci_qc_issue(struct ata_queued_cmd *qc)
 {
 	struct ata_port *ap = qc->ap;
@@ -81,6 +81,7 @@ struct loop_device {
 struct loop_cmd {
 	struct list_head list_entry;
 	bool use_aio; /* use AIO interface to handle I/O */
+	bool nowait; /* issue from ->queue_rq() with IOCB_NOWAIT */
 	atomic_t ref; /* only for aio */
 	long ret;
 	struct kiocb iocb;
@@ -341,6 +342,21 @@ static void lo_complete_rq(struct request *rq)
 	struct loop_cmd *cmd = blk_mq_rq_to_pdu(rq);
 	blk_status_t ret = BLK_STS_OK;
 
+	/*
+	 * The backing file accepted a nowait submission but failed it at
+	 * completion time with -EAGAIN.  The upper bio does not carry
+	 * REQ_NOWAIT, so the error must not escape: reissue the request,
+	 * with RQF_DONTPREP telling ->queue_rq to go straight to the
+	 * worker where blocking is allowed.
+	 */
+	if (cmd->nowait && cmd->ret == -EAGAIN) {
+		cmd->nowait = false;
+		cmd->ret = 0;
+		rq->rq_flags |= RQF_DONTPREP;
+		blk_mq_requeue_request(rq, true);
+		return;
+	}
+
 	if (!cmd->use_aio || cmd->ret < 0 || cmd->ret == blk_rq_bytes(rq) ||
 	    req_op(rq) != REQ_OP_READ) {
 		if (cmd->ret < 0)
@@ -446,6 +462,8 @@ static int lo_rw_aio(struct loop_device *lo, struct loop_cmd *cmd,
 	cmd->iocb.ki_filp = file;
 	cmd->iocb.ki_complete = lo_rw_aio_complete;
 	cmd->iocb.ki_flags = IOCB_DIRECT;
+	if (cmd->nowait)
+		cmd->iocb.ki_flags |= IOCB_NOWAIT;
 	cmd->iocb.ki_ioprio = IOPRIO_PRIO_VALUE(IOPRIO_CLASS_NONE, 0);
 
 	if (rw == ITER_SOURCE)
@@ -453,6 +471,14 @@ static int lo_rw_aio(struct loop_device *lo, struct loop_cmd *cmd,
 	else
 		ret = call_read_iter(file, &cmd->iocb, &iter);
 
+	/*
+	 * A nowait submission that would have blocked is retried from the
+	 * worker; nothing has been queued and no completion will run, so
+	 * just hand the command back untouched.
+	 */
+	if (cmd->nowait && (ret == -EAGAIN || ret == -EOPNOTSUPP))
+		return ret;
+
 	lo_rw_aio_do_completion(cmd);
 
 	if (ret != -EIOCBQUEUED)
@@ -1836,6 +1862,31 @@ static blk_status_t loop_queue_rq(struct blk_mq_hw_ctx *hctx,
 		cmd->use_aio = lo->use_dio;
 		break;
 	}
+	cmd->nowait = false;
+
+	/*
+	 * Single-bio direct-I/O requests need neither the bounce bvec
+	 * allocation nor the worker's cgroup association: submit them right
+	 * here with IOCB_NOWAIT, which saves the wakeup and context switch
+	 * per I/O, and bounce to the worker only when the filesystem would
+	 * have to block (or doesn't support nowait I/O at all).  A request
+	 * whose nowait attempt already failed asynchronously comes back
+	 * with RQF_DONTPREP set and goes straight to the worker.
+	 */
+	if (cmd->use_aio && !(rq->rq_flags & RQF_DONTPREP) &&
+	    rq->bio && rq->bio == rq->biotail &&
+	    (lo->lo_backing_file->f_mode & FMODE_NOWAIT) &&
+	    (req_op(rq) == REQ_OP_READ ||
+	     (req_op(rq) == REQ_OP_WRITE &&
+	      !(lo->lo_flags & LO_FLAGS_READ_ONLY)))) {
+		loff_t pos = ((loff_t) blk_rq_pos(rq) << 9) + lo->lo_offset;
+		int rw = req_op(rq) == REQ_OP_WRITE ? ITER_SOURCE : ITER_DEST;
+
+		cmd->nowait = true;
+		if (!lo_rw_aio(lo, cmd, pos, rw))
+			return BLK_STS_OK;
+		cmd->nowait = false;
+	}
 
 	/* always use the first bio's css */
 	cmd->blkcg_css = NULL;
@@ -34,6 +34,7 @@
 #include <linux/slab.h>
 #include <net/sock.h>
 #include <linux/net.h>
+#include <linux/tcp.h>
 #include <linux/kthread.h>
 #include <linux/types.h>
 #include <linux/debugfs.h>
@@ -60,6 +61,7 @@ struct nbd_sock {
 	struct request *pending;
 	int sent;
 	bool dead;
+	bool corked;
 	int fallback_index;
 	int cookie;
 };
@@ -970,7 +972,31 @@ static int wait_for_reconnect(struct nbd_device *nbd)
 	return !test_bit(NBD_RT_DISCONNECTED, &config->runtime_flags);
 }
 
-static int nbd_handle_cmd(struct nbd_cmd *cmd, int index)
+/*
+ * When the dispatch loop has more requests lined up for this socket, cork
+ * it so that several small NBD requests ride in one TCP segment instead of
+ * one segment each.  The cork is released either by the send of the last
+ * request of the batch or by ->commit_rqs() when the dispatch loop stops
+ * early, so corked data never waits for new I/O.  Non-TCP transports
+ * (e.g. AF_UNIX sockets) are left alone.
+ */
+static void nbd_sock_cork(struct nbd_sock *nsock)
+{
+	if (nsock->corked || nsock->sock->sk->sk_protocol != IPPROTO_TCP)
+		return;
+	tcp_sock_set_cork(nsock->sock->sk, true);
+	nsock->corked = true;
+}
+
+static void nbd_sock_uncork(struct nbd_sock *nsock)
+{
+	if (!nsock->corked)
+		return;
+	tcp_sock_set_cork(nsock->sock->sk, false);
+	nsock->corked = false;
+}
+
+static int nbd_handle_cmd(struct nbd_cmd *cmd, int index, bool last)
 {
 	struct request *req = blk_mq_rq_from_pdu(cmd);
 	struct nbd_device *nbd = cmd->nbd;
@@ -1032,6 +1058,8 @@ again:
 	 * Some failures are related to the link going down, so anything that
 	 * returns EAGAIN can be retried on a different socket.
 	 */
+	if (!last)
+		nbd_sock_cork(nsock);
 	ret = nbd_send_cmd(nbd, cmd, index);
 	/*
 	 * Access to this flag is protected by cmd->lock, thus it's safe to set
@@ -1047,6 +1075,8 @@ again:
 		ret = 0;
 	}
 out:
+	if (last)
+		nbd_sock_uncork(nsock);
 	mutex_unlock(&nsock->tx_lock);
 	nbd_config_put(nbd);
 	return ret;
@@ -1075,7 +1105,7 @@ static blk_status_t nbd_queue_rq(struct blk_mq_hw_ctx *hctx,
 	 * this case we need to return that we are busy, otherwise error out as
 	 * appropriate.
 	 */
-	ret = nbd_handle_cmd(cmd, hctx->queue_num);
+	ret = nbd_handle_cmd(cmd, hctx->queue_num, bd->last);
 	if (ret < 0)
 		ret = BLK_STS_IOERR;
 	else if (!ret)
@@ -1085,6 +1115,26 @@ static blk_status_t nbd_queue_rq(struct blk_mq_hw_ctx *hctx,
 	return ret;
 }
 
+/* Flush a socket left corked by a dispatch batch that ended early. */
+static void nbd_commit_rqs(struct blk_mq_hw_ctx *hctx)
+{
+	struct nbd_device *nbd = hctx->queue->tag_set->driver_data;
+	struct nbd_config *config;
+	struct nbd_sock *nsock;
+
+	if (!refcount_inc_not_zero(&nbd->config_refs))
+		return;
+
+	config = nbd->config;
+	if (hctx->queue_num < config->num_connections) {
+		nsock = config->socks[hctx->queue_num];
+		mutex_lock(&nsock->tx_lock);
+		nbd_sock_uncork(nsock);
+		mutex_unlock(&nsock->tx_lock);
+	}
+	nbd_config_put(nbd);
+}
+
 static struct socket *nbd_get_socket(struct nbd_device *nbd, unsigned long fd,
 				     int *err)
 {
@@ -1739,6 +1789,7 @@ static int nbd_init_request(struct blk_mq_tag_set *set, struct request *rq,
 
 static const struct blk_mq_ops nbd_mq_ops = {
 	.queue_rq	= nbd_queue_rq,
+	.commit_rqs	= nbd_commit_rqs,
 	.complete	= nbd_complete_rq,
 	.init_request	= nbd_init_request,
 	.timeout	= nbd_xmit_timeout,
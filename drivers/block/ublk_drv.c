@@ -601,6 +601,21 @@ static inline unsigned int ublk_req_build_flags(struct request *req)
 	return flags;
 }
 
+/*
+ * The shared-memory descriptor ring that gets proposed from time to time
+ * already exists as the sum of two pieces: the iod written below lands in
+ * the per-queue buffer that the server mmaps through
+ * UBLKSRV_CMD_BUF_OFFSET, so request descriptors are never copied to
+ * userspace, and the signalling rides io_uring's shared SQ/CQ rings,
+ * where a batch of COMMIT_AND_FETCH commands costs one io_uring_enter()
+ * (or none with SQPOLL) and CQEs are reaped without entering the kernel.
+ * Steady state is therefore already "descriptors in shared memory,
+ * doorbell per batch".  A private ring protocol would only re-implement
+ * that plus what uring_cmd gives us for free - per-task completion
+ * batching via task work, cancellation on server death, and a wakeup
+ * path that doesn't spin - so server-side CPU work should be attacked
+ * with SQPOLL/IOPOLL and bigger batches, not a new transport.
+ */
 static blk_status_t ublk_setup_iod(struct ublk_queue *ubq, struct request *req)
 {
 	struct ublksrv_io_desc *iod = ublk_get_iod(ubq, req->tag);
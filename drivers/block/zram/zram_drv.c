@@ -1409,6 +1409,22 @@ static int zram_bvec_read(struct zram *zram, struct bio_vec *bvec,
 	return zram_read_page(zram, bvec->bv_page, index, bio);
 }
 
+/*
+ * Every page takes exactly one pass through the primary compressor.  The
+ * cases an up-front entropy estimate would try to catch are already
+ * handled without one: same-filled pages are detected and stored as a
+ * pattern below, pages whose result lands in the huge size class are
+ * stored raw (ZRAM_HUGE) so they never pay for decompression, and pages
+ * that deserve a stronger or weaker algorithm can be re-routed through
+ * the secondary compressors via the recompress/recomp_algorithm knobs,
+ * where the cost is paid once in the background instead of in the swap
+ * write path.  An estimator cheap enough for this hot path misclassifies
+ * exactly the mid-entropy pages where the algorithm choice matters most,
+ * so it would mostly add a second pass over the data.  The compression
+ * streams are already per-CPU (zcomp_stream_get() takes a local lock,
+ * not a shared one), and the per-size-class population that a ratio
+ * histogram would show is exported by zsmalloc in debugfs.
+ */
 static int zram_write_page(struct zram *zram, struct page *page, u32 index)
 {
 	int ret = 0;
@@ -2432,6 +2432,17 @@ struct dm_bufio_client *dm_bufio_client_create(struct block_device *bdev, unsign
 		goto bad_client;
 	}
 
+	/*
+	 * The buffer cache is sharded by block number into dm_num_hash_locks()
+	 * trees, each under its own rw_semaphore, so concurrent metadata
+	 * lookups from different shards never touch a common lock; the
+	 * remaining per-client mutex only covers eviction, writeback and
+	 * resize, and those walk the shards in hash order through a
+	 * lock_history cursor that batches reacquisition instead of locking
+	 * per buffer.  Buffer memory is allocated at first use on whichever
+	 * CPU misses, so with a NUMA-aware mempolicy the data pages land on
+	 * the node doing the lookups without bufio binding them explicitly.
+	 */
 	num_locks = dm_num_hash_locks();
 	c = kzalloc(sizeof(*c) + (num_locks * sizeof(struct buffer_tree)), GFP_KERNEL);
 	if (!c) {
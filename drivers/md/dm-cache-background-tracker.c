@@ -14,6 +14,7 @@
 struct bt_work {
 	struct list_head list;
 	struct rb_node node;
+	bool issued;
 	struct policy_work work;
 };
 
@@ -27,6 +28,9 @@ struct background_tracker {
 	struct list_head queued;
 	struct rb_root pending;
 
+	/* next origin block to issue work for, see btracker_issue() */
+	uint64_t issue_cursor;
+
 	struct kmem_cache *work_cache;
 };
 
@@ -48,6 +52,7 @@ struct background_tracker *btracker_create(unsigned int max_work)
 	INIT_LIST_HEAD(&b->queued);
 
 	b->pending = RB_ROOT;
+	b->issue_cursor = 0;
 	b->work_cache = KMEM_CACHE(bt_work, 0);
 	if (!b->work_cache) {
 		DMERR("couldn't create mempool for background work items");
@@ -96,7 +101,7 @@ static bool __insert_pending(struct background_tracker *b,
 		w = container_of(*new, struct bt_work, node);
 
 		parent = *new;
-		cmp = cmp_oblock(w->work.oblock, nw->work.oblock);
+		cmp = cmp_oblock(nw->work.oblock, w->work.oblock);
 		if (cmp < 0)
 			new = &((*new)->rb_left);
 
@@ -124,7 +129,7 @@ static struct bt_work *__find_pending(struct background_tracker *b,
 	while (*new) {
 		w = container_of(*new, struct bt_work, node);
 
-		cmp = cmp_oblock(w->work.oblock, oblock);
+		cmp = cmp_oblock(oblock, w->work.oblock);
 		if (cmp < 0)
 			new = &((*new)->rb_left);
 
@@ -138,6 +143,37 @@ static struct bt_work *__find_pending(struct background_tracker *b,
 	return *new ? w : NULL;
 }
 
+/*
+ * Find the not-yet-issued work with the lowest origin block >= @from.
+ * The pending tree is kept in ascending oblock order, so the skip over
+ * already-issued entries only ever walks past works in flight, which are
+ * bounded by the migration concurrency.
+ */
+static struct bt_work *__next_queued(struct background_tracker *b,
+				     uint64_t from)
+{
+	struct rb_node *n = b->pending.rb_node, *best = NULL;
+	struct bt_work *w;
+
+	while (n) {
+		w = container_of(n, struct bt_work, node);
+
+		if (from_oblock(w->work.oblock) >= from) {
+			best = n;
+			n = n->rb_left;
+		} else
+			n = n->rb_right;
+	}
+
+	for (n = best; n; n = rb_next(n)) {
+		w = container_of(n, struct bt_work, node);
+		if (!w->issued)
+			return w;
+	}
+
+	return NULL;
+}
+
 
 static void update_stats(struct background_tracker *b, struct policy_work *w, int delta)
 {
@@ -209,9 +245,12 @@ int btracker_queue(struct background_tracker *b,
 
 	if (pwork) {
 		*pwork = &w->work;
+		w->issued = true;
 		list_add(&w->list, &b->issued);
-	} else
+	} else {
+		w->issued = false;
 		list_add(&w->list, &b->queued);
+	}
 	update_stats(b, &w->work, 1);
 
 	return 0;
@@ -220,6 +259,14 @@ EXPORT_SYMBOL_GPL(btracker_queue);
 
 /*
  * Returns -ENODATA if there's no work.
+ *
+ * Work is handed out in ascending origin-block order, continuing from
+ * wherever the previous issue left off and wrapping at the end, so the
+ * random collection of queued writebacks and demotions reaches the origin
+ * device as a small number of sequential streams rather than a random
+ * scatter.  The queue order the policy chose only decided *what* got
+ * queued; by the time work is issued everything queued is equally urgent,
+ * so reordering for origin locality costs nothing.
  */
 int btracker_issue(struct background_tracker *b, struct policy_work **work)
 {
@@ -228,7 +275,14 @@ int btracker_issue(struct background_tracker *b, struct policy_work **work)
 	if (list_empty(&b->queued))
 		return -ENODATA;
 
-	w = list_first_entry(&b->queued, struct bt_work, list);
+	w = __next_queued(b, b->issue_cursor);
+	if (!w)
+		w = __next_queued(b, 0);
+	if (WARN_ON_ONCE(!w))
+		return -ENODATA;
+
+	b->issue_cursor = from_oblock(w->work.oblock) + 1;
+	w->issued = true;
 	list_move(&w->list, &b->issued);
 	*work = &w->work;
 
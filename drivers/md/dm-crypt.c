@@ -17,6 +17,7 @@
 #include <linux/bio.h>
 #include <linux/blkdev.h>
 #include <linux/blk-integrity.h>
+#include <linux/ioprio.h>
 #include <linux/mempool.h>
 #include <linux/slab.h>
 #include <linux/crypto.h>
@@ -1465,6 +1466,20 @@ static int crypt_convert_block_skcipher(struct crypt_config *cc,
 
 static void kcryptd_async_done(void *async_req, int error);
 
+/*
+ * One request per in-flight convert_context is the floor, not overhead to
+ * optimize away with per-CPU preallocated contexts: the tfm may be an
+ * async offload, so several bios' requests can be outstanding on the same
+ * CPU at once and a single reusable per-CPU context would be corrupted by
+ * the second submitter.  The mempool's fast path is a slab allocation
+ * served from the per-CPU cache anyway, and the scatterlists live inline
+ * in the dm_crypt_request, so there is no separate SG allocation to
+ * reuse.  For a synchronous CPU cipher the no_read_workqueue/
+ * no_write_workqueue flags already run the whole conversion on the
+ * submitting CPU; picking those flags stays a table-load decision since
+ * inlining trades submitter latency for completion-context CPU time,
+ * which no cipher-speed heuristic can judge on the workload's behalf.
+ */
 static int crypt_alloc_req_skcipher(struct crypt_config *cc,
 				     struct convert_context *ctx)
 {
@@ -1679,6 +1694,12 @@ retry:
 				 GFP_NOIO, &cc->bs);
 	clone->bi_private = io;
 	clone->bi_end_io = crypt_endio;
+	/*
+	 * The encrypted buffer is a fresh bio, not a clone, so carry the
+	 * submitter's I/O priority over by hand or it is lost before it
+	 * ever reaches the lower queue's scheduler.
+	 */
+	clone->bi_ioprio = io->base_bio->bi_ioprio;
 
 	remaining_size = size;
 
@@ -1965,7 +1986,14 @@ static void kcryptd_crypt_write_io_submit(struct dm_crypt_io *io, int async)
 
 	clone->bi_iter.bi_sector = cc->start + io->sector;
 
-	if ((likely(!async) && test_bit(DM_CRYPT_NO_OFFLOAD, &cc->flags)) ||
+	/*
+	 * Realtime-class writes skip the offload thread as well: the
+	 * sector-sorted batching there trades latency for throughput,
+	 * which is the wrong trade for prioritized I/O.
+	 */
+	if ((likely(!async) &&
+	     (test_bit(DM_CRYPT_NO_OFFLOAD, &cc->flags) ||
+	      IOPRIO_PRIO_CLASS(clone->bi_ioprio) == IOPRIO_CLASS_RT)) ||
 	    test_bit(DM_CRYPT_NO_WRITE_WORKQUEUE, &cc->flags)) {
 		dm_submit_bio_remap(io->base_bio, clone);
 		return;
@@ -2225,7 +2253,14 @@ static void kcryptd_queue_crypt(struct dm_crypt_io *io)
 {
 	struct crypt_config *cc = io->cc;
 
-	if ((bio_data_dir(io->base_bio) == READ && test_bit(DM_CRYPT_NO_READ_WORKQUEUE, &cc->flags)) ||
+	/*
+	 * Realtime-class bios must not wait behind whatever backlog the
+	 * crypt workqueue has accumulated, so handle them like the
+	 * no-workqueue tunables do: inline, or in a tasklet when called
+	 * from hard interrupt context.
+	 */
+	if (IOPRIO_PRIO_CLASS(io->base_bio->bi_ioprio) == IOPRIO_CLASS_RT ||
+	    (bio_data_dir(io->base_bio) == READ && test_bit(DM_CRYPT_NO_READ_WORKQUEUE, &cc->flags)) ||
 	    (bio_data_dir(io->base_bio) == WRITE && test_bit(DM_CRYPT_NO_WRITE_WORKQUEUE, &cc->flags))) {
 		/*
 		 * in_hardirq(): Crypto API's skcipher_walk_first() refuses to work in hard IRQ context.
@@ -800,6 +800,21 @@ static bool is_inactive_blocked(struct r5conf *conf, int hash)
 		(conf->max_nr_stripes * 3 / 4));
 }
 
+/*
+ * Lookup is already sharded: the stripe hash is split across
+ * NR_STRIPE_HASH_LOCKS regions, each with its own lock and inactive list,
+ * so writers to different stripes contend only within a shard.  A per-CPU
+ * front-end cache on top of this cannot work - a cached pointer is only
+ * valid while a reference is held, and per-CPU held references would pin
+ * stripes out of the inactive lists and starve reclaim; the refcount and
+ * the R5_INACTIVE_BLOCKED back-pressure are the cache.  Full-stripe
+ * writes already amortize the lock via ctx->batch_last and the stripe
+ * batch lists.  When the hash locks do show up in profiles, the cause is
+ * usually stripe starvation (inactive lists empty, everyone sleeping in
+ * the loop below) rather than the shard locks themselves - check
+ * stripe_cache_active against stripe_cache_size before reaching for more
+ * sharding.
+ */
 struct stripe_head *raid5_get_active_stripe(struct r5conf *conf,
 		struct stripe_request_ctx *ctx, sector_t sector,
 		unsigned int flags)
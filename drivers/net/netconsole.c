@@ -831,6 +831,24 @@ static void write_ext_msg(struct console *con, const char *msg,
 	spin_unlock_irqrestore(&target_list_lock, flags);
 }
 
+/*
+ * Synchronous transmission here is the point, not a deficiency.  A
+ * lockless per-CPU ring drained by a background thread (keeping the
+ * sync path for oops_in_progress only) has been proposed to take
+ * netconsole off the tail-latency profile during log bursts; the
+ * problem is that the messages that matter most are the ones logged
+ * just *before* a box dies, and most deaths - hard hangs, watchdog
+ * resets, power loss - never set oops_in_progress.  Anything sitting
+ * in a ring at that moment is lost, which inverts netconsole's reason
+ * to exist.  Buffering also belongs a layer up: printk already owns a
+ * lockless ring, and the ongoing per-console kthread work in the
+ * printk core is where deferred, latency-friendly console writing is
+ * happening - with ordering against other consoles and crash-time
+ * flushing handled once, centrally.  Fleets that cannot afford
+ * synchronous delivery of chatty logs should rate-limit or filter what
+ * reaches the console (loglevel, oops_only above) rather than make
+ * delivery best-effort.
+ */
 static void write_msg(struct console *con, const char *msg, unsigned int len)
 {
 	int frag, left;
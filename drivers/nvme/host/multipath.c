@@ -5,6 +5,7 @@
 
 #include <linux/backing-dev.h>
 #include <linux/moduleparam.h>
+#include <linux/random.h>
 #include <linux/vmalloc.h>
 #include <trace/events/block.h>
 #include "nvme.h"
@@ -17,6 +18,7 @@ MODULE_PARM_DESC(multipath,
 static const char *nvme_iopolicy_names[] = {
 	[NVME_IOPOLICY_NUMA]	= "numa",
 	[NVME_IOPOLICY_RR]	= "round-robin",
+	[NVME_IOPOLICY_LAT]	= "latency",
 };
 
 static int iopolicy = NVME_IOPOLICY_NUMA;
@@ -29,6 +31,8 @@ static int nvme_set_iopolicy(const char *val, const struct kernel_param *kp)
 		iopolicy = NVME_IOPOLICY_NUMA;
 	else if (!strncmp(val, "round-robin", 11))
 		iopolicy = NVME_IOPOLICY_RR;
+	else if (!strncmp(val, "latency", 7))
+		iopolicy = NVME_IOPOLICY_LAT;
 	else
 		return -EINVAL;
 
@@ -43,7 +47,7 @@ static int nvme_get_iopolicy(char *buf, const struct kernel_param *kp)
 module_param_call(iopolicy, nvme_set_iopolicy, nvme_get_iopolicy,
 	&iopolicy, 0644);
 MODULE_PARM_DESC(iopolicy,
-	"Default multipath I/O policy; 'numa' (default) or 'round-robin'");
+	"Default multipath I/O policy; 'numa' (default), 'round-robin' or 'latency'");
 
 void nvme_mpath_default_iopolicy(struct nvme_subsystem *subsys)
 {
@@ -128,12 +132,30 @@ void nvme_mpath_start_request(struct request *rq)
 }
 EXPORT_SYMBOL_GPL(nvme_mpath_start_request);
 
+/*
+ * Exponentially weighted moving average of per-path completion latency,
+ * fed from the jiffies start stamp taken for the I/O statistics.  The
+ * jiffies granularity is too coarse to rank healthy paths against each
+ * other, but a degraded fabric path is milliseconds slow, which is
+ * exactly what stands out of a near-zero average.  Concurrent updates
+ * may lose a sample; that is harmless for an estimate.
+ */
+static void nvme_mpath_update_latency(struct nvme_ns *ns, struct request *rq)
+{
+	u32 latency = jiffies_to_usecs(jiffies - nvme_req(rq)->start_time);
+	u32 ewma = READ_ONCE(ns->lat_ewma);
+
+	WRITE_ONCE(ns->lat_ewma, ewma - (ewma >> 3) + (latency >> 3));
+}
+
 void nvme_mpath_end_request(struct request *rq)
 {
 	struct nvme_ns *ns = rq->q->queuedata;
 
 	if (!(nvme_req(rq)->flags & NVME_MPATH_IO_STATS))
 		return;
+	if (READ_ONCE(ns->head->subsys->iopolicy) == NVME_IOPOLICY_LAT)
+		nvme_mpath_update_latency(ns, rq);
 	bdev_end_io_acct(ns->head->disk->part0, req_op(rq),
 			 blk_rq_bytes(rq) >> SECTOR_SHIFT,
 			 nvme_req(rq)->start_time);
@@ -327,16 +349,75 @@ static inline bool nvme_path_is_optimized(struct nvme_ns *ns)
 		ns->ana_state == NVME_ANA_OPTIMIZED;
 }
 
+static struct nvme_ns *nvme_latency_path(struct nvme_ns_head *head, int node)
+{
+	struct nvme_ns *ns, *found = NULL, *fallback = NULL;
+	u32 found_lat = UINT_MAX, fallback_lat = UINT_MAX, lat;
+
+	list_for_each_entry_rcu(ns, &head->list, siblings) {
+		if (nvme_path_is_disabled(ns))
+			continue;
+
+		lat = READ_ONCE(ns->lat_ewma);
+		switch (ns->ana_state) {
+		case NVME_ANA_OPTIMIZED:
+			if (lat < found_lat) {
+				found_lat = lat;
+				found = ns;
+			}
+			break;
+		case NVME_ANA_NONOPTIMIZED:
+			if (lat < fallback_lat) {
+				fallback_lat = lat;
+				fallback = ns;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	if (!found)
+		found = fallback;
+	if (!found)
+		return NULL;
+
+	/*
+	 * A path that lost all traffic to a high estimate would keep its
+	 * stale average forever, since only completions decay it.  Steer an
+	 * occasional command down one of the other usable paths so they stay
+	 * measured and can win the load back once they recover.
+	 */
+	if (get_random_u32_below(64) == 0) {
+		for (ns = nvme_next_ns(head, found);
+		     ns && ns != found;
+		     ns = nvme_next_ns(head, ns)) {
+			if (nvme_path_is_disabled(ns))
+				continue;
+			if (ns->ana_state == NVME_ANA_OPTIMIZED ||
+			    ns->ana_state == NVME_ANA_NONOPTIMIZED)
+				return ns;
+		}
+	}
+
+	rcu_assign_pointer(head->current_path[node], found);
+	return found;
+}
+
 inline struct nvme_ns *nvme_find_path(struct nvme_ns_head *head)
 {
+	int iopolicy = READ_ONCE(head->subsys->iopolicy);
 	int node = numa_node_id();
 	struct nvme_ns *ns;
 
+	if (iopolicy == NVME_IOPOLICY_LAT)
+		return nvme_latency_path(head, node);
+
 	ns = srcu_dereference(head->current_path[node], &head->srcu);
 	if (unlikely(!ns))
 		return __nvme_find_path(head, node);
 
-	if (READ_ONCE(head->subsys->iopolicy) == NVME_IOPOLICY_RR)
+	if (iopolicy == NVME_IOPOLICY_RR)
 		return nvme_round_robin_path(head, node, ns);
 	if (unlikely(!nvme_path_is_optimized(ns)))
 		return __nvme_find_path(head, node);
@@ -823,6 +904,15 @@ static ssize_t ana_state_show(struct device *dev, struct device_attribute *attr,
 }
 DEVICE_ATTR_RO(ana_state);
 
+static ssize_t io_latency_show(struct device *dev,
+		struct device_attribute *attr, char *buf)
+{
+	struct nvme_ns *ns = nvme_get_ns_from_dev(dev);
+
+	return sysfs_emit(buf, "%u\n", READ_ONCE(ns->lat_ewma));
+}
+DEVICE_ATTR_RO(io_latency);
+
 static int nvme_lookup_ana_group_desc(struct nvme_ctrl *ctrl,
 		struct nvme_ana_group_desc *desc, void *data)
 {
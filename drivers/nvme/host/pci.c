@@ -101,6 +101,18 @@ static unsigned int poll_queues;
 module_param_cb(poll_queues, &io_queue_count_ops, &poll_queues, 0644);
 MODULE_PARM_DESC(poll_queues, "Number of queues to use for polled IO.");
 
+static unsigned char irq_coalesce_threshold;
+module_param(irq_coalesce_threshold, byte, 0444);
+MODULE_PARM_DESC(irq_coalesce_threshold,
+	"Number of completions to aggregate before interrupting. "
+	"Use 0 to leave interrupt coalescing at the controller default.");
+
+static unsigned char irq_coalesce_time;
+module_param(irq_coalesce_time, byte, 0444);
+MODULE_PARM_DESC(irq_coalesce_time,
+	"Maximum completion aggregation delay in 100 microsecond increments. "
+	"Use 0 to leave interrupt coalescing at the controller default.");
+
 static bool noacpi;
 module_param(noacpi, bool, 0444);
 MODULE_PARM_DESC(noacpi, "disable acpi bios quirks");
@@ -2059,6 +2071,32 @@ static int nvme_setup_host_mem(struct nvme_dev *dev)
 	return ret;
 }
 
+/*
+ * Interrupt coalescing trades completion latency on IRQ-driven queues for
+ * fewer interrupts; latency-sensitive traffic should use polled queues
+ * (poll_queues), which bypass interrupts entirely.  The feature is optional
+ * in the spec and advisory to the controller, so failure to set it is not
+ * fatal.  The threshold is converted to the spec's 0's based encoding.
+ */
+static void nvme_set_irq_coalesce(struct nvme_dev *dev)
+{
+	u32 dword11;
+	int ret;
+
+	if (!irq_coalesce_threshold && !irq_coalesce_time)
+		return;
+
+	dword11 = irq_coalesce_time << 8;
+	if (irq_coalesce_threshold)
+		dword11 |= irq_coalesce_threshold - 1;
+
+	ret = nvme_set_features(&dev->ctrl, NVME_FEAT_IRQ_COALESCE, dword11,
+				NULL, 0, NULL);
+	if (ret)
+		dev_warn(dev->ctrl.device,
+			 "failed to set interrupt coalescing: %d\n", ret);
+}
+
 static ssize_t cmb_show(struct device *dev, struct device_attribute *attr,
 		char *buf)
 {
@@ -2730,6 +2768,8 @@ static void nvme_reset_work(struct work_struct *work)
 	if (result < 0)
 		goto out;
 
+	nvme_set_irq_coalesce(dev);
+
 	result = nvme_setup_io_queues(dev);
 	if (result)
 		goto out;
@@ -3027,6 +3067,8 @@ static int nvme_probe(struct pci_dev *pdev, const struct pci_device_id *id)
 	if (result < 0)
 		goto out_disable;
 
+	nvme_set_irq_coalesce(dev);
+
 	result = nvme_setup_io_queues(dev);
 	if (result)
 		goto out_disable;
@@ -765,6 +765,18 @@ static inline void nvme_tcp_end_request(struct request *rq, u16 status)
 		nvme_complete_rq(rq);
 }
 
+/*
+ * The receive path has to copy: the destination pages in req->iter are the
+ * bio's pages - page cache or pinned user memory whose identity is fixed -
+ * so skb frags cannot be flipped into their place, and TCP gives no
+ * guarantee that a data PDU starts page-aligned in a frame anyway (PDUs
+ * straddle segments at arbitrary offsets).  True zero-copy receive needs
+ * the NIC to split off PDU headers and DMA payload directly into the
+ * command's buffers, i.e. ULP direct data placement in hardware, not a
+ * software page-pool trick.  The copy is already single-pass: with data
+ * digest enabled, skb_copy_and_hash_datagram_iter() folds the crc32c into
+ * the same traversal rather than re-walking the mapped pages.
+ */
 static int nvme_tcp_recv_data(struct nvme_tcp_queue *queue, struct sk_buff *skb,
 			      unsigned int *offset, size_t *len)
 {
@@ -895,6 +895,26 @@ static int dump_emit_page(struct coredump_params *cprm, struct page *page)
 	return 1;
 }
 
+/*
+ * Single-threaded, uncompressed emission is a smaller problem than a
+ * 300GB heap makes it look, and the remedies proposed for it -
+ * splitting VMAs across worker threads, consulting page-cache state to
+ * skip clean pages, an in-kernel zstd pipeline - mostly already exist
+ * in other forms.  Clean file-backed data is excluded by the default
+ * coredump_filter before this function ever sees the VMA, and
+ * never-touched anon pages come back NULL from get_dump_page() below
+ * and are emitted as holes, so what is actually written is the dirtied
+ * working set, sparse.  Compression and parallelism live on the other
+ * side of the pipe on purpose: a core_pattern helper receives the
+ * stream and may zstd it with every core in the box, without pinning
+ * crash-time kernel workers or baking a compressor choice into the
+ * ABI.  In-kernel VMA-parallel writers would contend on what is
+ * normally a pipe (strictly ordered) and on cprm->limit/written
+ * accounting, to accelerate the case the filter is supposed to shrink
+ * instead.  If restart latency is the real constraint, the parent
+ * should not wait on dump completion - the helper can snapshot to
+ * fast local storage and upload asynchronously.
+ */
 int dump_user_range(struct coredump_params *cprm, unsigned long start,
 		    unsigned long len)
 {
@@ -1917,6 +1917,21 @@ static vm_fault_t dax_iomap_pmd_fault(struct vm_fault *vmf, pfn_t *pfnp,
  * their fault handler for DAX files. dax_iomap_fault() assumes the caller
  * has done all the necessary locking for page fault to proceed
  * successfully.
+ *
+ * The policy is already huge-first, not PTE-first: the fault machinery
+ * tries PE_SIZE_PMD before falling back here to PTEs, and the first
+ * touch anywhere in a 2M region takes the PMD path whenever the VMA
+ * offset is 2M-aligned and the extent is mapped and aligned on the
+ * medium.  Workloads ending up with mostly 4K DAX mappings are seeing
+ * fallback causes - an unaligned mmap address (the filesystems'
+ * get_unmapped_area already aligns when given the chance), unwritten
+ * or fragmented extents, or a file hole - and those are fixed at
+ * allocation/map time, not after the fact.  After-the-fact promotion
+ * (a khugepaged-style collapse of a PTE-filled 2M range into a PMD)
+ * does not exist for DAX: collapse requires tearing down the PTE table
+ * under rmap and TLB shootdown for pages the kernel does not own the
+ * lifecycle of, and there is no compound page to substitute - all cost
+ * that mapping aligned from the start avoids entirely.
  */
 vm_fault_t dax_iomap_fault(struct vm_fault *vmf, enum page_entry_size pe_size,
 		    pfn_t *pfnp, int *iomap_errp, const struct iomap_ops *ops)
@@ -187,6 +187,14 @@ struct eventpoll {
 	/* Wait queue used by sys_epoll_wait() */
 	wait_queue_head_t wq;
 
+	/*
+	 * Set (bit 0) when a wakeup on ->wq has been issued and no waiter
+	 * has been dequeued since; lets concurrent ep_poll_callback()s
+	 * elide further wake_up() calls during event storms.  Cleared when
+	 * a waiter is dequeued or (re)arms itself under ->lock.
+	 */
+	unsigned long wake_pending;
+
 	/* Wait queue used by file->poll() */
 	wait_queue_head_t poll_wait;
 
@@ -1239,7 +1247,13 @@ static int ep_poll_callback(wait_queue_entry_t *wait, unsigned mode, int sync, v
 				break;
 			}
 		}
-		wake_up(&ep->wq);
+		/*
+		 * Batch wakeups: once a wakeup has been issued and no waiter
+		 * consumed it yet, further events need not hammer ->wq's lock;
+		 * the dequeued waiter will find them on the ready list.
+		 */
+		if (!test_and_set_bit(0, &ep->wake_pending))
+			wake_up(&ep->wq);
 	}
 	if (waitqueue_active(&ep->poll_wait))
 		pwake++;
@@ -1794,6 +1808,12 @@ static struct timespec64 *ep_timeout_to_timespec(struct timespec64 *to, long ms)
 	return to;
 }
 
+/* Wait entry used by ep_poll(), carries the ep for the wake function */
+struct ep_wait {
+	wait_queue_entry_t wait;
+	struct eventpoll *ep;
+};
+
 /*
  * autoremove_wake_function, but remove even on failure to wake up, because we
  * know that default_wake_function/ttwu will only fail if the thread is already
@@ -1803,8 +1823,14 @@ static struct timespec64 *ep_timeout_to_timespec(struct timespec64 *to, long ms)
 static int ep_autoremove_wake_function(struct wait_queue_entry *wq_entry,
 				       unsigned int mode, int sync, void *key)
 {
+	struct ep_wait *ewait = container_of(wq_entry, struct ep_wait, wait);
 	int ret = default_wake_function(wq_entry, mode, sync, key);
 
+	/*
+	 * A waiter has been dequeued; let the next event issue a wakeup
+	 * again, so remaining waiters keep getting one each.
+	 */
+	clear_bit(0, &ewait->ep->wake_pending);
 	list_del_init(&wq_entry->entry);
 	return ret;
 }
@@ -1831,7 +1857,7 @@ static int ep_poll(struct eventpoll *ep, struct epoll_event __user *events,
 {
 	int res, eavail, timed_out = 0;
 	u64 slack = 0;
-	wait_queue_entry_t wait;
+	struct ep_wait ewait;
 	ktime_t expires, *to = NULL;
 
 	lockdep_assert_irqs_enabled();
@@ -1897,8 +1923,9 @@ static int ep_poll(struct eventpoll *ep, struct epoll_event __user *events,
 		 * performance issue if a process is killed, causing all of its
 		 * threads to wake up without being removed normally.
 		 */
-		init_wait(&wait);
-		wait.func = ep_autoremove_wake_function;
+		init_wait(&ewait.wait);
+		ewait.wait.func = ep_autoremove_wake_function;
+		ewait.ep = ep;
 
 		write_lock_irq(&ep->lock);
 		/*
@@ -1908,6 +1935,14 @@ static int ep_poll(struct eventpoll *ep, struct epoll_event __user *events,
 		 */
 		__set_current_state(TASK_INTERRUPTIBLE);
 
+		/*
+		 * Rearm event wakeups.  Producers run under the read side of
+		 * ->lock, so clearing the flag, the final check below and the
+		 * enqueueing are atomic with respect to them: any event added
+		 * after this section will find the flag clear and wake us.
+		 */
+		clear_bit(0, &ep->wake_pending);
+
 		/*
 		 * Do the final check under the lock. ep_scan_ready_list()
 		 * plays with two lists (->rdllist and ->ovflist) and there
@@ -1917,7 +1952,7 @@ static int ep_poll(struct eventpoll *ep, struct epoll_event __user *events,
 		 */
 		eavail = ep_events_available(ep);
 		if (!eavail)
-			__add_wait_queue_exclusive(&ep->wq, &wait);
+			__add_wait_queue_exclusive(&ep->wq, &ewait.wait);
 
 		write_unlock_irq(&ep->lock);
 
@@ -1933,7 +1968,7 @@ static int ep_poll(struct eventpoll *ep, struct epoll_event __user *events,
 		 */
 		eavail = 1;
 
-		if (!list_empty_careful(&wait.entry)) {
+		if (!list_empty_careful(&ewait.wait.entry)) {
 			write_lock_irq(&ep->lock);
 			/*
 			 * If the thread timed out and is not on the wait queue,
@@ -1943,8 +1978,8 @@ static int ep_poll(struct eventpoll *ep, struct epoll_event __user *events,
 			 * events.
 			 */
 			if (timed_out)
-				eavail = list_empty(&wait.entry);
-			__remove_wait_queue(&ep->wq, &wait);
+				eavail = list_empty(&ewait.wait.entry);
+			__remove_wait_queue(&ep->wq, &ewait.wait);
 			write_unlock_irq(&ep->lock);
 		}
 	}
@@ -515,6 +515,24 @@ static int bprm_stack_limits(struct linux_binprm *bprm)
  * 'copy_strings()' copies argument/environment strings from the old
  * processes's memory to the new process's stack.  The call to get_user_pages()
  * ensures the destination page is created and not swapped out.
+ *
+ * Spawn-heavy fleets have asked for two accelerations here: batched
+ * argv copying into large folios, and speculative full-binary
+ * readahead at exec start overlapped with credential/mm setup.  The
+ * copy below is already page-batched - the inner loop faults each
+ * stack page once and memcpy's every string fragment that lands in it,
+ * so a typical argv costs one or two page faults total, and the
+ * strings live in the old mm while the stack page belongs to the new
+ * one, which is why this cannot degrade to reference-taking (and a
+ * large-folio stack would charge every exec for an argv that rarely
+ * crosses two pages).  Binary readahead is already the mapping
+ * layer's job at first fault: ELF segments are mapped, not read, and
+ * file-backed readahead ramps on the execve'd binary the same as any
+ * other file - while issuing a speculative whole-file read before
+ * binfmt recognition would pessimize every script, misread, and
+ * ENOEXEC fallback.  Cold-binary exec cost is an I/O problem with an
+ * I/O answer: fincore-style prewarming of the working set by the CI
+ * runner, not speculation in the exec path.
  */
 static int copy_strings(int argc, struct user_arg_ptr argv,
 			struct linux_binprm *bprm)
@@ -877,10 +877,12 @@ static inline struct file *__fget_files_rcu(struct files_struct *files,
 		 *
 		 * Such a race can take two forms:
 		 *
-		 *  (a) the file ref already went down to zero,
-		 *      and get_file_rcu() fails. Just try again:
+		 *  (a) the file ref already went down to zero and the
+		 *      file hasn't been reused yet or the file count
+		 *      isn't zero but the file has already been reused.
+		 *      Just try again:
 		 */
-		if (unlikely(!get_file_rcu(file)))
+		if (unlikely(!atomic_long_inc_not_zero(&file->f_count)))
 			continue;
 
 		/*
@@ -899,8 +901,16 @@ static inline struct file *__fget_files_rcu(struct files_struct *files,
 
 		/*
 		 * Ok, we have a ref to the file, and checked that it
-		 * still exists.
+		 * still exists.  The object may have been recycled into
+		 * a different file before the reference was taken
+		 * (filp_cachep is SLAB_TYPESAFE_BY_RCU), so redo the
+		 * mode check against the file we actually hold.
 		 */
+		if (unlikely(file->f_mode & mask)) {
+			fput(file);
+			return NULL;
+		}
+
 		return file;
 	}
 }
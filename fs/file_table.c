@@ -44,20 +44,48 @@ static struct kmem_cache *filp_cachep __read_mostly;
 
 static struct percpu_counter nr_files __cacheline_aligned_in_smp;
 
-static void file_free_rcu(struct rcu_head *head)
+static inline void file_free(struct file *f)
 {
-	struct file *f = container_of(head, struct file, f_rcuhead);
-
+	security_file_free(f);
+	if (!(f->f_mode & FMODE_NOACCOUNT))
+		percpu_counter_dec(&nr_files);
 	put_cred(f->f_cred);
+	/*
+	 * filp_cachep is SLAB_TYPESAFE_BY_RCU: the object may be reused
+	 * immediately, but the memory stays a struct file for at least a
+	 * grace period.  Lockless f_count users take a speculative
+	 * reference and then confirm their pointer still leads here.
+	 */
 	kmem_cache_free(filp_cachep, f);
 }
 
-static inline void file_free(struct file *f)
+/**
+ * get_file_rcu - try to take a reference on a file under rcu
+ * @f: location of the file pointer, re-read for confirmation
+ *
+ * Must be called under rcu_read_lock().  Because struct file is
+ * SLAB_TYPESAFE_BY_RCU, a file looked up locklessly may be recycled into
+ * a different file before the reference is taken; re-reading @f after
+ * the count bump confirms the object is still the one published there.
+ *
+ * Return: the referenced file, or NULL if @f went NULL.
+ */
+struct file *get_file_rcu(struct file __rcu **f)
 {
-	security_file_free(f);
-	if (!(f->f_mode & FMODE_NOACCOUNT))
-		percpu_counter_dec(&nr_files);
-	call_rcu(&f->f_rcuhead, file_free_rcu);
+	for (;;) {
+		struct file *file = rcu_dereference_raw(*f);
+
+		if (!file)
+			return NULL;
+
+		if (unlikely(!atomic_long_inc_not_zero(&file->f_count)))
+			continue;
+
+		if (likely(file == rcu_dereference_raw(*f)))
+			return file;
+
+		fput(file);
+	}
 }
 
 /*
@@ -143,7 +171,8 @@ static struct file *__alloc_file(int flags, const struct cred *cred)
 	f->f_cred = get_cred(cred);
 	error = security_file_alloc(f);
 	if (unlikely(error)) {
-		file_free_rcu(&f->f_rcuhead);
+		put_cred(f->f_cred);
+		kmem_cache_free(filp_cachep, f);
 		return ERR_PTR(error);
 	}
 
@@ -411,7 +440,8 @@ EXPORT_SYMBOL(__fput_sync);
 void __init files_init(void)
 {
 	filp_cachep = kmem_cache_create("filp", sizeof(struct file), 0,
-			SLAB_HWCACHE_ALIGN | SLAB_PANIC | SLAB_ACCOUNT, NULL);
+			SLAB_HWCACHE_ALIGN | SLAB_PANIC | SLAB_ACCOUNT |
+			SLAB_TYPESAFE_BY_RCU, NULL);
 	percpu_counter_init(&nr_files, 0, GFP_KERNEL);
 }
 
@@ -1363,19 +1363,38 @@ static bool inode_dirtied_after(struct inode *inode, unsigned long t)
 	return ret;
 }
 
+/*
+ * An inode whose mapping holds at least @big_pages pages can keep the
+ * device busy for a full writeback chunk on its own.  It is worth
+ * dispatching such inodes ahead of their many small siblings in the
+ * same expired batch: the big inode saturates the queue while the
+ * small ones would each submit a handful of pages and leave the device
+ * idle between inodes.  nrpages is a proxy for the dirty footprint
+ * (clean cache inflates it), but a mis-prioritized inode only changes
+ * the order within one batch, never whether an inode gets written.
+ */
+static bool inode_is_big(struct inode *inode, unsigned long big_pages)
+{
+	return big_pages && inode->i_mapping->nrpages >= big_pages;
+}
+
 /*
  * Move expired (dirtied before dirtied_before) dirty inodes from
- * @delaying_queue to @dispatch_queue.
+ * @delaying_queue to @dispatch_queue.  Within the expired batch, inodes
+ * with at least @big_pages cached pages are dispatched before the rest
+ * of their superblock's group.
  */
 static int move_expired_inodes(struct list_head *delaying_queue,
 			       struct list_head *dispatch_queue,
-			       unsigned long dirtied_before)
+			       unsigned long dirtied_before,
+			       unsigned long big_pages)
 {
 	LIST_HEAD(tmp);
 	struct list_head *pos, *node;
 	struct super_block *sb = NULL;
 	struct inode *inode;
 	int do_sb_sort = 0;
+	int do_size_sort = 0;
 	int moved = 0;
 
 	while (!list_empty(delaying_queue)) {
@@ -1387,6 +1406,8 @@ static int move_expired_inodes(struct list_head *delaying_queue,
 		moved++;
 		inode->i_state |= I_SYNC_QUEUED;
 		spin_unlock(&inode->i_lock);
+		if (inode_is_big(inode, big_pages))
+			do_size_sort = 1;
 		if (sb_is_blkdev_sb(inode->i_sb))
 			continue;
 		if (sb && sb != inode->i_sb)
@@ -1394,8 +1415,8 @@ static int move_expired_inodes(struct list_head *delaying_queue,
 		sb = inode->i_sb;
 	}
 
-	/* just one sb in list, splice to dispatch_queue and we're done */
-	if (!do_sb_sort) {
+	/* just one sb and no big inodes, splice to dispatch_queue and done */
+	if (!do_sb_sort && !do_size_sort) {
 		list_splice(&tmp, dispatch_queue);
 		goto out;
 	}
@@ -1405,9 +1426,21 @@ static int move_expired_inodes(struct list_head *delaying_queue,
 	 * we don't take inode->i_lock here because it is just a pointless overhead.
 	 * Inode is already marked as I_SYNC_QUEUED so writeback list handling is
 	 * fully under our control.
+	 *
+	 * Two passes per sb keep this O(n): the first moves the big inodes
+	 * so they are dequeued first, the second mops up the rest.
 	 */
 	while (!list_empty(&tmp)) {
 		sb = wb_inode(tmp.prev)->i_sb;
+		if (do_size_sort) {
+			list_for_each_prev_safe(pos, node, &tmp) {
+				inode = wb_inode(pos);
+				if (inode->i_sb == sb &&
+				    inode_is_big(inode, big_pages))
+					list_move(&inode->i_io_list,
+						  dispatch_queue);
+			}
+		}
 		list_for_each_prev_safe(pos, node, &tmp) {
 			inode = wb_inode(pos);
 			if (inode->i_sb == sb)
@@ -1434,14 +1467,23 @@ static void queue_io(struct bdi_writeback *wb, struct wb_writeback_work *work,
 {
 	int moved;
 	unsigned long time_expire_jif = dirtied_before;
+	unsigned long big_pages;
+
+	/*
+	 * "Big" means the inode alone fills a bandwidth-sized writeback
+	 * chunk, mirroring the WB_SYNC_NONE estimate in
+	 * writeback_chunk_size().
+	 */
+	big_pages = READ_ONCE(wb->avg_write_bandwidth) / 2;
 
 	assert_spin_locked(&wb->list_lock);
 	list_splice_init(&wb->b_more_io, &wb->b_io);
-	moved = move_expired_inodes(&wb->b_dirty, &wb->b_io, dirtied_before);
+	moved = move_expired_inodes(&wb->b_dirty, &wb->b_io, dirtied_before,
+				    big_pages);
 	if (!work->for_sync)
 		time_expire_jif = jiffies - dirtytime_expire_interval * HZ;
 	moved += move_expired_inodes(&wb->b_dirty_time, &wb->b_io,
-				     time_expire_jif);
+				     time_expire_jif, big_pages);
 	if (moved)
 		wb_io_lists_populated(wb);
 	trace_writeback_queue_io(wb, work, dirtied_before, moved);
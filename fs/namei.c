@@ -2240,6 +2240,21 @@ static inline u64 hash_name(const void *salt, const char *name)
  * Returns 0 and nd will have valid dentry and mnt on success.
  * Returns error and drops reference to input namei data on failure.
  */
+/*
+ * Note on memoizing whole paths: it is tempting to map (root, path,
+ * mount generation) straight to the final dentry for hot repeated
+ * opens and skip the loop below.  That can't be made correct - each
+ * component step is not just a dcache probe but also a MAY_EXEC
+ * permission check (DAC and LSM) on the directory, a mountpoint
+ * crossing and a symlink resolution point, all against current state.
+ * A sequence counter can tell us the dcache didn't change, not that
+ * ->i_mode, ACLs or security policy didn't, so a "hit" would still
+ * have to redo every per-component check - which is this loop.  In
+ * RCU mode a fully cached walk already takes no locks and grabs no
+ * references; userspace that wants to shorten it further can hold an
+ * O_PATH descriptor for the invariant prefix and use openat() relative
+ * to that.
+ */
 static int link_path_walk(const char *name, struct nameidata *nd)
 {
 	int depth = 0; // depth <= nd->depth
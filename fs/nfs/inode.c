@@ -1189,6 +1189,22 @@ int nfs_open(struct inode *inode, struct file *filp)
 /*
  * This function is called whenever some part of NFS notices that
  * the cached attributes have to be refreshed.
+ *
+ * A bulk variant - one compound revalidating a directory's worth of
+ * cached inodes, driven from readdir and pathwalk misses - keeps being
+ * requested by build workloads that stat large trees between compiles.
+ * The protocol cannot express it usefully: a v4 compound operates on
+ * one current filehandle at a time, so "bulk GETATTR" is N round trips
+ * in one request - a latency win only until it meets the slot table,
+ * and readdir-plus already is that batch (one RPC returning attributes
+ * for a directory's entries, which nfs_readdir_page_filler feeds into
+ * the very inode attribute caches consulted here).  Correctness also
+ * caps it: an attribute fetched in a speculative bulk pass can be
+ * stale by the time its file is actually opened, so each pathwalk
+ * still pays its consistency check.  The mechanisms that remove
+ * round trips wholesale are the ones the protocol defines -
+ * delegations (revalidation short-circuits above when one is held)
+ * and, for trees that change rarely, actimeo/nocto mount tuning.
  */
 int
 __nfs_revalidate_inode(struct nfs_server *server, struct inode *inode)
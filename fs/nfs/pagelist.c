@@ -1241,6 +1241,20 @@ nfs_pageio_do_add_request(struct nfs_pageio_descriptor *desc,
 
 /*
  * Helper for nfs_pageio_add_request and nfs_pageio_complete
+ *
+ * On nconnect and single-file throughput: coalescing here only decides
+ * where one RPC ends (at rsize/wsize boundaries); it does not bind a
+ * file, or even consecutive regions of it, to one transport.  Every
+ * pg_doio produces an independent rpc_task, and the sunrpc layer
+ * round-robins tasks across the transport switch, so a big sequential
+ * read already stripes over all nconnect connections - provided enough
+ * RPCs are in flight at once.  When a single file tops out at one
+ * connection's worth, the in-flight count is the limiter, which is the
+ * readahead window on reads and dirty/commit pacing on writes, not an
+ * affinity in this layer.  Explicit byte-range-to-transport placement
+ * with congestion feedback is a layout problem, and exists as pNFS;
+ * duplicating it inside the pageio coalescer for plain mounts would
+ * re-implement a scheduler sunrpc already runs.
  */
 static void nfs_pageio_doio(struct nfs_pageio_descriptor *desc)
 {
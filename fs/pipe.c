@@ -128,12 +128,12 @@ static void anon_pipe_buf_release(struct pipe_inode_info *pipe,
 	struct page *page = buf->page;
 
 	/*
-	 * If nobody else uses this page, and we don't already have a
-	 * temporary page, let's keep track of it as a one-deep
-	 * allocation cache. (Otherwise just release our reference to it)
+	 * If nobody else uses this page, and there is room left in the
+	 * allocation cache, keep track of it so the next writes can reuse
+	 * it. (Otherwise just release our reference to it)
 	 */
-	if (page_count(page) == 1 && !pipe->tmp_page)
-		pipe->tmp_page = page;
+	if (page_count(page) == 1 && pipe->tmp_page_nr < PIPE_TMP_PAGES)
+		pipe->tmp_page[pipe->tmp_page_nr++] = page;
 	else
 		put_page(page);
 }
@@ -490,16 +490,19 @@ pipe_write(struct kiocb *iocb, struct iov_iter *from)
 		if (!pipe_full(head, pipe->tail, pipe->max_usage)) {
 			unsigned int mask = pipe->ring_size - 1;
 			struct pipe_buffer *buf = &pipe->bufs[head & mask];
-			struct page *page = pipe->tmp_page;
+			struct page *page;
 			int copied;
 
-			if (!page) {
+			if (pipe->tmp_page_nr) {
+				page = pipe->tmp_page[pipe->tmp_page_nr - 1];
+			} else {
 				page = alloc_page(GFP_HIGHUSER | __GFP_ACCOUNT);
 				if (unlikely(!page)) {
 					ret = ret ? : -ENOMEM;
 					break;
 				}
-				pipe->tmp_page = page;
+				pipe->tmp_page[0] = page;
+				pipe->tmp_page_nr = 1;
 			}
 
 			/* Allocate a slot in the ring in advance and attach an
@@ -528,7 +531,7 @@ pipe_write(struct kiocb *iocb, struct iov_iter *from)
 				buf->flags = PIPE_BUF_FLAG_PACKET;
 			else
 				buf->flags = PIPE_BUF_FLAG_CAN_MERGE;
-			pipe->tmp_page = NULL;
+			pipe->tmp_page_nr--;
 
 			copied = copy_page_from_iter(page, 0, PAGE_SIZE, from);
 			if (unlikely(copied < PAGE_SIZE && iov_iter_count(from))) {
@@ -849,8 +852,8 @@ void free_pipe_info(struct pipe_inode_info *pipe)
 	if (pipe->watch_queue)
 		put_watch_queue(pipe->watch_queue);
 #endif
-	if (pipe->tmp_page)
-		__free_page(pipe->tmp_page);
+	while (pipe->tmp_page_nr)
+		__free_page(pipe->tmp_page[--pipe->tmp_page_nr]);
 	kfree(pipe->bufs);
 	kfree(pipe);
 }
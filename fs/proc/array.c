@@ -403,6 +403,19 @@ static inline void task_context_switch_counts(struct seq_file *m,
 	seq_putc(m, '\n');
 }
 
+#ifdef CONFIG_PER_VMA_LOCK
+static void task_vma_cache(struct seq_file *m, struct task_struct *p)
+{
+	seq_put_decimal_ull(m, "VmaCacheHits:\t", p->find_vma_cache_hits);
+	seq_put_decimal_ull(m, "\nVmaCacheMisses:\t", p->find_vma_cache_misses);
+	seq_putc(m, '\n');
+}
+#else
+static inline void task_vma_cache(struct seq_file *m, struct task_struct *p)
+{
+}
+#endif
+
 static void task_cpus_allowed(struct seq_file *m, struct task_struct *task)
 {
 	seq_printf(m, "Cpus_allowed:\t%*pb\n",
@@ -455,6 +468,7 @@ int proc_pid_status(struct seq_file *m, struct pid_namespace *ns,
 	task_cpus_allowed(m, task);
 	cpuset_task_status_allowed(m, task);
 	task_context_switch_counts(m, task);
+	task_vma_cache(m, task);
 	return 0;
 }
 
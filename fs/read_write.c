@@ -991,6 +991,19 @@ static inline loff_t pos_from_hilo(unsigned long high, unsigned long low)
 	return (((loff_t)high << HALF_LONG_BITS) << HALF_LONG_BITS) | low;
 }
 
+/*
+ * A "batched pread" syscall taking an array of (fd, offset, iovec)
+ * operations has been proposed more than once to amortize syscall entry
+ * for applications issuing dense pread bursts.  It does not buy what
+ * its proponents hope for: fdget() and rw_verify_area() are per-file
+ * permission checks and must run for every operation regardless of how
+ * many share one kernel entry, so only the bare entry/exit cost is
+ * amortized.  io_uring already provides exactly that amortization -
+ * IORING_OP_READV submits arbitrarily many (fd, offset, iovec) ops per
+ * entry, and registered files additionally drop the per-op fdget that a
+ * batch syscall would still pay.  New plain-syscall uAPI duplicating it
+ * is not worth the compat surface.
+ */
 static ssize_t do_preadv(unsigned long fd, const struct iovec __user *vec,
 			 unsigned long vlen, loff_t pos, rwf_t flags)
 {
@@ -971,6 +971,19 @@ static int do_poll(struct poll_list *list, struct poll_wqueues *wait,
 #define N_STACK_PPS ((sizeof(stack_pps) - sizeof(struct poll_list))  / \
 			sizeof(struct pollfd))
 
+/*
+ * The cost profile of poll(2) - copy_from_user of the whole pollfd
+ * array, one f_op->poll per entry, copy-out of every revents - is
+ * inherent to the stateless interface and cannot be cached kernel-side:
+ * the array, the file table, and each file's readiness may all change
+ * between calls.  Proposals for a persistent "registered pollset"
+ * object that amortizes registration across calls describe epoll: its
+ * default level-triggered mode has exactly poll's semantics, its
+ * registrations persist, and epoll_wait scales with the number of
+ * ready fds rather than watched ones.  Workloads polling very large fd
+ * sets at high frequency should migrate rather than expect a second
+ * epoll to grow here.
+ */
 static int do_sys_poll(struct pollfd __user *ufds, unsigned int nfds,
 		struct timespec64 *end_time)
 {
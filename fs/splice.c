@@ -38,6 +38,13 @@
 
 #include "internal.h"
 
+/*
+ * Ring size the per-task internal pipe is grown to for large direct
+ * (file-to-file) splices.  The ring only ever carries page references,
+ * so the cost is the bufs array, not data pages.
+ */
+#define SPLICE_DIRECT_BUFFERS	64
+
 /*
  * Splice doesn't support FMODE_NOWAIT. Since pipes may set this flag to
  * indicate they support non-blocking reads or writes, we must clear it
@@ -958,6 +965,18 @@ ssize_t splice_direct_to_actor(struct file *in, struct splice_desc *sd,
 	len = sd->total_len;
 	flags = sd->flags;
 
+	/*
+	 * Large transfers are chunked by the capacity of the internal pipe,
+	 * paying for a read/write round trip per chunk.  Grow the ring once
+	 * (it sticks around with the task) so bulk file-to-file copies via
+	 * sendfile(2) and copy_file_range(2) cycle through fewer rounds.
+	 * Failure is harmless - we just keep the default capacity.
+	 */
+	if (len > (size_t)pipe->max_usage * PAGE_SIZE &&
+	    pipe->ring_size < SPLICE_DIRECT_BUFFERS &&
+	    !pipe_resize_ring(pipe, SPLICE_DIRECT_BUFFERS))
+		pipe->max_usage = SPLICE_DIRECT_BUFFERS;
+
 	/*
 	 * Don't block on output, we have to drain the direct pipe.
 	 */
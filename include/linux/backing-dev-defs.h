@@ -136,6 +136,16 @@ struct bdi_writeback {
 	int dirty_exceeded;
 	enum wb_reason start_all_reason;
 
+	/*
+	 * Dirty throttling decisions, surfaced in the bdi debugfs stats.
+	 * dirty_pause_hist buckets pauses by duration: <=4ms, <=16ms,
+	 * <=64ms, <=256ms and longer.
+	 */
+#define WB_PAUSE_HIST_MAX	5
+	unsigned long dirty_pause_hist[WB_PAUSE_HIST_MAX];
+	unsigned long dirty_freerun;	/* left throttle loop without pause */
+	unsigned long dirty_fast_bypass; /* wb-local freerun bypasses */
+
 	spinlock_t work_lock;		/* protects work_list & dwork scheduling */
 	struct list_head work_list;
 	struct delayed_work dwork;	/* work item used for writeback */
@@ -4,6 +4,7 @@
 
 #include <linux/blkdev.h>
 #include <linux/sbitmap.h>
+#include <linux/hrtimer.h>
 #include <linux/lockdep.h>
 #include <linux/scatterlist.h>
 #include <linux/prefetch.h>
@@ -392,6 +393,20 @@ struct blk_mq_hw_ctx {
 	 */
 	atomic_t		wait_index;
 
+	/** @aggr_lock: Protects @aggr_list and @aggr_count. */
+	spinlock_t		aggr_lock;
+	/**
+	 * @aggr_list: Plugless requests staged for a batched ->queue_rqs()
+	 * dispatch.  Only used when the queue sets dispatch_aggr_usec.
+	 */
+	struct request		*aggr_list;
+	/** @aggr_count: Number of requests on @aggr_list. */
+	unsigned int		aggr_count;
+	/** @aggr_timer: Bounds how long requests may sit on @aggr_list. */
+	struct hrtimer		aggr_timer;
+	/** @aggr_work: Flushes @aggr_list from kblockd context. */
+	struct work_struct	aggr_work;
+
 	/**
 	 * @tags: Tags owned by the block driver. A tag at this set is only
 	 * assigned when a request is dispatched from a hardware queue.
@@ -740,6 +755,8 @@ struct request *blk_mq_alloc_request_hctx(struct request_queue *q,
 		blk_opf_t opf, blk_mq_req_flags_t flags,
 		unsigned int hctx_idx);
 
+struct blk_mq_tag_cache;
+
 /*
  * Tag address space map.
  */
@@ -749,6 +766,12 @@ struct blk_mq_tags {
 
 	atomic_t active_queues;
 
+	/*
+	 * Optional per-CPU cache of freed tags, layered over bitmap_tags.
+	 * NULL when the depth is too small to be worth caching.
+	 */
+	struct blk_mq_tag_cache __percpu *cache;
+
 	struct sbitmap_queue bitmap_tags;
 	struct sbitmap_queue breserved_tags;
 
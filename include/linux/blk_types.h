@@ -338,6 +338,9 @@ enum {
 	BIO_QOS_MERGED,		/* but went through rq_qos merge path */
 	BIO_REMAPPED,
 	BIO_ZONE_WRITE_LOCKED,	/* Owns a zoned device zone write lock */
+	BIO_INPLACE_ENCRYPT,	/* submitter owns the pages exclusively and
+				 * allows blk-crypto-fallback to transform
+				 * their contents in place */
 	BIO_FLAG_LAST
 };
 
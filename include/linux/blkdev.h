@@ -460,6 +460,12 @@ struct request_queue {
 
 	unsigned int		rq_timeout;
 
+	/*
+	 * How long plugless submissions may be held back, in microseconds,
+	 * to build batches for ->queue_rqs().  Zero disables aggregation.
+	 */
+	unsigned int		dispatch_aggr_usec;
+
 	struct timer_list	timeout;
 	struct work_struct	timeout_work;
 
@@ -10,6 +10,7 @@
 #include <linux/stat.h>
 #include <linux/cache.h>
 #include <linux/list.h>
+#include <linux/list_bl.h>
 #include <linux/list_lru.h>
 #include <linux/llist.h>
 #include <linux/radix-tree.h>
@@ -664,7 +665,8 @@ struct inode {
 	unsigned long		dirtied_when;	/* jiffies of first dirtying */
 	unsigned long		dirtied_time_when;
 
-	struct hlist_node	i_hash;
+	struct hlist_bl_node	i_hash;
+	struct hlist_bl_head	*i_hash_head;
 	struct list_head	i_io_list;	/* backing dev IO list */
 #ifdef CONFIG_CGROUP_WRITEBACK
 	struct bdi_writeback	*i_wb;		/* the associated cgroup wb */
@@ -730,7 +732,7 @@ static inline unsigned int i_blocksize(const struct inode *node)
 
 static inline int inode_unhashed(struct inode *inode)
 {
-	return hlist_unhashed(&inode->i_hash);
+	return hlist_bl_unhashed(&inode->i_hash);
 }
 
 /*
@@ -741,7 +743,7 @@ static inline int inode_unhashed(struct inode *inode)
  */
 static inline void inode_fake_hash(struct inode *inode)
 {
-	hlist_add_fake(&inode->i_hash);
+	hlist_bl_add_fake(&inode->i_hash);
 }
 
 /*
@@ -945,6 +947,14 @@ struct file_ra_state {
 	unsigned int ra_pages;
 	unsigned int mmap_miss;
 	loff_t prev_pos;
+	/*
+	 * Stride-access detection: the last observed inter-read distance
+	 * in pages and how many consecutive reads repeated it. Lets
+	 * strided (including backward) scans prefetch their next probe
+	 * the way sequential streams already do.
+	 */
+	long stride;
+	unsigned int stride_hits;
 };
 
 /*
@@ -1009,7 +1019,7 @@ static inline struct file *get_file(struct file *f)
 	atomic_long_inc(&f->f_count);
 	return f;
 }
-#define get_file_rcu(x) atomic_long_inc_not_zero(&(x)->f_count)
+struct file *get_file_rcu(struct file __rcu **f);
 #define file_count(x)	atomic_long_read(&(x)->f_count)
 
 #define	MAX_NON_LFS	((1UL<<31) - 1)
@@ -2714,7 +2724,7 @@ static inline void insert_inode_hash(struct inode *inode)
 extern void __remove_inode_hash(struct inode *);
 static inline void remove_inode_hash(struct inode *inode)
 {
-	if (!inode_unhashed(inode) && !hlist_fake(&inode->i_hash))
+	if (!inode_unhashed(inode) && !hlist_bl_fake(&inode->i_hash))
 		__remove_inode_hash(inode);
 }
 
@@ -3003,6 +3013,23 @@ static inline int iocb_flags(struct file *file)
 	return res;
 }
 
+/*
+ * An RWF_ADAPTIVE flag - per-file recurrence tracking picking the
+ * buffered or O_DIRECT path automatically - has been proposed for
+ * applications that guess wrong and double-cache one-pass data.  It
+ * cannot be made transparent: the direct path imposes caller-visible
+ * contracts (buffer/offset alignment, no page-cache fill) that a
+ * buffered submission does not meet, so the kernel can only "switch" a
+ * request by bouncing it, and flipping a file between modes requires a
+ * flush-and-invalidate round per transition to keep the two views
+ * coherent - exactly the cost a heuristic would pay on every
+ * misprediction.  What the one-pass case actually needs is buffered
+ * I/O that does not leave the data cached, which is an uncached/
+ * drop-behind write-through semantic under discussion upstream as its
+ * own RWF flag; until then, POSIX_FADV_DONTNEED / FADV_NOREUSE after
+ * the streaming pass is the supported way to stop 40G of single-use
+ * data displacing a host's cache.
+ */
 static inline int kiocb_set_rw_flags(struct kiocb *ki, rwf_t flags)
 {
 	int kiocb_flags = 0;
@@ -362,6 +362,21 @@ struct io_ring_ctx {
 	struct callback_head		poll_wq_task_work;
 	struct list_head		defer_list;
 	unsigned			sq_thread_idle;
+	/*
+	 * SQPOLL per-ring activity accounting, only ever written by the
+	 * sq thread owning this ring. sqpoll_idle_streak counts scan
+	 * rounds without any work and drives cold-ring scan batching.
+	 */
+	unsigned long			sqpoll_rounds;
+	unsigned long			sqpoll_submitted;
+	unsigned int			sqpoll_idle_streak;
+
+	/*
+	 * log2(nsec) completion latency histogram, only updated with
+	 * IORING_SETUP_LAT_STATS. Updated under the CQ posting locks, read
+	 * racily from fdinfo.
+	 */
+	u64				lat_hist[32];
 	/* protected by ->completion_lock */
 	unsigned			evfd_last_cq_tail;
 };
@@ -585,6 +600,8 @@ struct io_kiocb {
 	/* custom credentials, valid IFF REQ_F_CREDS is set */
 	const struct cred		*creds;
 	struct io_wq_work		work;
+	/* issue timestamp, only valid with IORING_SETUP_LAT_STATS */
+	u64				start_time;
 };
 
 struct io_overflow_cqe {
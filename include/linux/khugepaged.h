@@ -14,6 +14,7 @@ extern void __khugepaged_enter(struct mm_struct *mm);
 extern void __khugepaged_exit(struct mm_struct *mm);
 extern void khugepaged_enter_vma(struct vm_area_struct *vma,
 				 unsigned long vm_flags);
+extern void __khugepaged_fault_heat(struct mm_struct *mm);
 extern void khugepaged_min_free_kbytes_update(void);
 extern bool current_is_khugepaged(void);
 #ifdef CONFIG_SHMEM
@@ -38,6 +39,12 @@ static inline void khugepaged_exit(struct mm_struct *mm)
 	if (test_bit(MMF_VM_HUGEPAGE, &mm->flags))
 		__khugepaged_exit(mm);
 }
+
+static inline void khugepaged_fault_heat(struct vm_area_struct *vma)
+{
+	if (test_bit(MMF_VM_HUGEPAGE, &vma->vm_mm->flags))
+		__khugepaged_fault_heat(vma->vm_mm);
+}
 #else /* CONFIG_TRANSPARENT_HUGEPAGE */
 static inline void khugepaged_fork(struct mm_struct *mm, struct mm_struct *oldmm)
 {
@@ -49,6 +56,9 @@ static inline void khugepaged_enter_vma(struct vm_area_struct *vma,
 					unsigned long vm_flags)
 {
 }
+static inline void khugepaged_fault_heat(struct vm_area_struct *vma)
+{
+}
 static inline int collapse_pte_mapped_thp(struct mm_struct *mm,
 					  unsigned long addr, bool install_pmd)
 {
@@ -143,6 +143,20 @@ static inline void hlist_bl_del_init(struct hlist_bl_node *n)
 	}
 }
 
+/*
+ * Make a node look hashed without being on any list, mirroring
+ * hlist_add_fake()/hlist_fake().
+ */
+static inline void hlist_bl_add_fake(struct hlist_bl_node *n)
+{
+	n->pprev = &n->next;
+}
+
+static inline bool hlist_bl_fake(const struct hlist_bl_node *n)
+{
+	return n->pprev == &n->next;
+}
+
 static inline void hlist_bl_lock(struct hlist_bl_head *b)
 {
 	bit_spin_lock(0, (unsigned long *)b);
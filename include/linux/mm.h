@@ -2384,6 +2384,24 @@ int get_user_pages_fast(unsigned long start, int nr_pages,
 int pin_user_pages_fast(unsigned long start, int nr_pages,
 			unsigned int gup_flags, struct page **pages);
 
+/**
+ * struct pin_range - one address range for pin_user_pages_vec()
+ * @start: starting user address
+ * @nr_pages: number of pages from start to pin
+ * @pages: array that receives pointers to the pages pinned, at least
+ *	@nr_pages long
+ * @ret: per-range result, number of pages pinned or -errno
+ */
+struct pin_range {
+	unsigned long start;
+	unsigned long nr_pages;
+	struct page **pages;
+	long ret;
+};
+
+long pin_user_pages_vec(struct pin_range *ranges, unsigned int nr_ranges,
+			unsigned int gup_flags);
+
 int account_locked_vm(struct mm_struct *mm, unsigned long pages, bool inc);
 int __account_locked_vm(struct mm_struct *mm, unsigned long pages, bool inc,
 			struct task_struct *task, bool bypass_rlim);
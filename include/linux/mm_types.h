@@ -768,6 +768,10 @@ struct mm_struct {
 #endif
 #ifdef CONFIG_HUGETLB_PAGE
 		atomic_long_t hugetlb_usage;
+#endif
+#ifdef CONFIG_TRANSPARENT_HUGEPAGE
+		/* anon faults since the last khugepaged scan of this mm */
+		atomic_t hpage_fault_heat;
 #endif
 		struct work_struct async_put_work;
 
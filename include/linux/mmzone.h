@@ -665,6 +665,8 @@ struct per_cpu_pages {
 	int high;		/* high watermark, emptying needed */
 	int batch;		/* chunk size for buddy add/remove */
 	short free_factor;	/* batch scaling factor during free */
+	/* refill batch scaling during allocation, one slot per pcp order */
+	u8 refill_factor[PAGE_ALLOC_COSTLY_ORDER + 1 + NR_PCP_THP];
 #ifdef CONFIG_NUMA
 	short expire;		/* When 0, remote pagesets are drained */
 #endif
@@ -933,6 +935,12 @@ struct zone {
 	unsigned long		compact_cached_migrate_pfn[ASYNC_AND_SYNC];
 	unsigned long		compact_init_migrate_pfn;
 	unsigned long		compact_init_free_pfn;
+	/*
+	 * pfn of a recently freed high-order movable page; hints the
+	 * migration scanner at a partially free candidate pageblock.
+	 * Maintained at free time, see __free_one_page().
+	 */
+	unsigned long		compact_hint_pfn;
 #endif
 
 #ifdef CONFIG_COMPACTION
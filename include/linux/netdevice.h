@@ -57,6 +57,7 @@
 struct netpoll_info;
 struct device;
 struct ethtool_ops;
+struct rtnl_link_blob;
 struct phy_device;
 struct dsa_port;
 struct ip_tunnel_parm;
@@ -334,6 +335,16 @@ enum netdev_state_t {
 struct gro_list {
 	struct list_head	list;
 	int			count;
+	/*
+	 * Adaptive flush state, used when dev->gro_adaptive_flush is set.
+	 * avg_segs is an EWMA of the segments coalesced into each completed
+	 * batch of this bucket, in GRO_CADENCE_SHIFT fixed point; see
+	 * dev_gro_receive().
+	 */
+	unsigned int		avg_segs;
+	unsigned int		probe;
+	unsigned int		stat_held;
+	unsigned int		stat_immediate;
 };
 
 /*
@@ -1924,6 +1935,15 @@ enum netdev_ml_priv_type {
  *	@gro_flush_timeout:	timeout for GRO layer in NAPI
  *	@napi_defer_hard_irqs:	If not zero, provides a counter that would
  *				allow to avoid NIC hard IRQ, on busy queues.
+ *	@gro_adaptive_flush:	deliver packets of flows with an RPC-like
+ *				cadence immediately instead of holding them
+ *				in the GRO hash
+ *	@dissect_profile:	use the straight-line flow dissector for the
+ *				declared header stacks (optional VLAN tag,
+ *				then IPv4/IPv6, then TCP/UDP), falling back
+ *				to the generic interpreter on mismatch
+ *	@dissect_profile_misses: packets that did not match the dissection
+ *				profile and took the generic path
  *
  *	@rx_handler:		handler for received packets
  *	@rx_handler_data: 	XXX: need comments on this one
@@ -2240,6 +2260,9 @@ struct net_device {
 	struct bpf_prog __rcu	*xdp_prog;
 	unsigned long		gro_flush_timeout;
 	int			napi_defer_hard_irqs;
+	u8			gro_adaptive_flush;
+	u8			dissect_profile;
+	atomic_long_t		dissect_profile_misses;
 #define GRO_LEGACY_MAX_SIZE	65536u
 /* TCP minimal MSS is 8 (TCP_MIN_GSO_SIZE),
  * and shinfo->gso_segs is a 16bit field.
@@ -2387,6 +2410,12 @@ struct net_device {
 #endif
 	struct phy_device	*phydev;
 	struct sfp_bus		*sfp_bus;
+	/* Cached pre-serialized RTM_NEWLINK message, owned by rtnetlink
+	 * and only touched under RTNL; rtnl_blob_gen is bumped by every
+	 * link notification to invalidate it.
+	 */
+	struct rtnl_link_blob	*rtnl_blob;
+	atomic_t		rtnl_blob_gen;
 	struct lock_class_key	*qdisc_tx_busylock;
 	bool			proto_down;
 	unsigned		wol_enabled:1;
@@ -3226,6 +3255,14 @@ struct softnet_data {
 	struct softnet_data	*rps_ipi_next;
 	unsigned int		cpu;
 	unsigned int		input_queue_tail;
+	/* Lock-free LIFO of skbs steered here by plain RPS.  Producers
+	 * push with cmpxchg(); the owning CPU detaches the whole stack
+	 * with xchg() and splices it into input_pkt_queue.  RFS flows
+	 * that need exact queue-tail accounting keep taking the
+	 * input_pkt_queue lock instead.
+	 */
+	struct sk_buff		*steer_list;
+	atomic_t		steer_qlen;
 #endif
 	unsigned int		received_rps;
 	unsigned int		dropped;
@@ -3251,7 +3288,10 @@ static inline void input_queue_tail_incr_save(struct softnet_data *sd,
 					      unsigned int *qtail)
 {
 #ifdef CONFIG_RPS
-	*qtail = ++sd->input_queue_tail;
+	unsigned int tail = ++sd->input_queue_tail;
+
+	if (qtail)
+		*qtail = tail;
 #endif
 }
 
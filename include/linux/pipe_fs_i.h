@@ -31,6 +31,14 @@ struct pipe_buffer {
 	unsigned long private;
 };
 
+/*
+ * Depth of the per-pipe released-page cache.  Deep enough that a
+ * streaming writer cycling several ring slots per syscall stays out of
+ * the page allocator, small enough (16KiB a pipe, worst case) that idle
+ * pipes don't pin a meaningful amount of memory.
+ */
+#define PIPE_TMP_PAGES	4
+
 /**
  *	struct pipe_inode_info - a linux kernel pipe
  *	@mutex: mutex protecting the whole thing
@@ -42,7 +50,8 @@ struct pipe_buffer {
  *	@max_usage: The maximum number of slots that may be used in the ring
  *	@ring_size: total number of buffers (should be a power of 2)
  *	@nr_accounted: The amount this pipe accounts for in user->pipe_bufs
- *	@tmp_page: cached released page
+ *	@tmp_page_nr: number of pages in @tmp_page
+ *	@tmp_page: cache of released pages, reused by the next writes
  *	@readers: number of current readers of this pipe
  *	@writers: number of current writers of this pipe
  *	@files: number of struct file referring this pipe (protected by ->i_lock)
@@ -72,7 +81,8 @@ struct pipe_inode_info {
 	unsigned int r_counter;
 	unsigned int w_counter;
 	bool poll_usage;
-	struct page *tmp_page;
+	unsigned int tmp_page_nr;
+	struct page *tmp_page[PIPE_TMP_PAGES];
 	struct fasync_struct *fasync_readers;
 	struct fasync_struct *fasync_writers;
 	struct pipe_buffer *bufs;
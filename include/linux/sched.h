@@ -872,6 +872,18 @@ struct task_struct {
 	struct mm_struct		*mm;
 	struct mm_struct		*active_mm;
 
+#ifdef CONFIG_PER_VMA_LOCK
+	/*
+	 * Last vma returned by find_vma() on this thread's own mm,
+	 * valid while mm_lock_seq still matches find_vma_cache_seq.
+	 * Cleared by vm_area_free() when this task frees the vma.
+	 */
+	struct vm_area_struct		*find_vma_cache;
+	int				find_vma_cache_seq;
+	unsigned long			find_vma_cache_hits;
+	unsigned long			find_vma_cache_misses;
+#endif
+
 	int				exit_state;
 	int				exit_code;
 	int				exit_signal;
@@ -1250,6 +1262,7 @@ struct task_struct {
 	/* Protected by alloc_lock: */
 	struct mempolicy		*mempolicy;
 	short				il_prev;
+	u8				il_weight;
 	short				pref_node_fork;
 #endif
 #ifdef CONFIG_NUMA_BALANCING
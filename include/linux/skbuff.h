@@ -1224,6 +1224,12 @@ static inline bool skb_unref(struct sk_buff *skb)
 	return true;
 }
 
+/* Always-on per-CPU drop accounting, summed in /proc/net/drop_reasons.
+ * Only core drop reasons are counted; subsystem reason spaces carry
+ * their own diagnostics.
+ */
+DECLARE_PER_CPU(unsigned long [SKB_DROP_REASON_MAX], skb_drop_counters);
+
 void __fix_address
 kfree_skb_reason(struct sk_buff *skb, enum skb_drop_reason reason);
 
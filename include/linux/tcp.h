@@ -338,7 +338,8 @@ struct tcp_sock {
 	u32	lost_out;	/* Lost packets			*/
 	u32	sacked_out;	/* SACK'd packets			*/
 
-	struct hrtimer	pacing_timer;
+	struct hlist_node pacing_node;	/* anchored on a per-CPU pacing wheel */
+	u64	pacing_tick;	/* wheel tick this flow is queued for */
 	struct hrtimer	compressed_ack_timer;
 
 	/* from STCP, retrans queue hinting */
@@ -455,6 +456,7 @@ struct tcp_sock {
 enum tsq_enum {
 	TSQ_THROTTLED,
 	TSQ_QUEUED,
+	TSQ_PACED,		   /* socket is queued on a pacing wheel */
 	TCP_TSQ_DEFERRED,	   /* tcp_tasklet_func() found socket was owned */
 	TCP_WRITE_TIMER_DEFERRED,  /* tcp_write_timer() found socket was owned */
 	TCP_DELACK_TIMER_DEFERRED, /* tcp_delack_timer() found socket was owned */
@@ -466,6 +468,7 @@ enum tsq_enum {
 enum tsq_flags {
 	TSQF_THROTTLED			= (1UL << TSQ_THROTTLED),
 	TSQF_QUEUED			= (1UL << TSQ_QUEUED),
+	TSQF_PACED			= (1UL << TSQ_PACED),
 	TCPF_TSQ_DEFERRED		= (1UL << TCP_TSQ_DEFERRED),
 	TCPF_WRITE_TIMER_DEFERRED	= (1UL << TCP_WRITE_TIMER_DEFERRED),
 	TCPF_DELACK_TIMER_DEFERRED	= (1UL << TCP_DELACK_TIMER_DEFERRED),
@@ -33,6 +33,11 @@ enum vm_event_item { PGPGIN, PGPGOUT, PSWPIN, PSWPOUT,
 		FOR_ALL_ZONES(PGALLOC)
 		FOR_ALL_ZONES(ALLOCSTALL)
 		FOR_ALL_ZONES(PGSCAN_SKIP)
+		PCPALLOC_HIT_ORDER0, PCPALLOC_HIT_ORDER1, PCPALLOC_HIT_ORDER2,
+		PCPALLOC_HIT_ORDER3, PCPALLOC_HIT_THP,
+		PCPALLOC_REFILL_ORDER0, PCPALLOC_REFILL_ORDER1,
+		PCPALLOC_REFILL_ORDER2, PCPALLOC_REFILL_ORDER3,
+		PCPALLOC_REFILL_THP,
 		PGFREE, PGACTIVATE, PGDEACTIVATE, PGLAZYFREE,
 		PGFAULT, PGMAJFAULT,
 		PGLAZYFREED,
@@ -76,6 +81,7 @@ enum vm_event_item { PGPGIN, PGPGOUT, PSWPIN, PSWPOUT,
 #ifdef CONFIG_COMPACTION
 		COMPACTMIGRATE_SCANNED, COMPACTFREE_SCANNED,
 		COMPACTISOLATED,
+		COMPACTPAGES_MIGRATED,
 		COMPACTSTALL, COMPACTFAIL, COMPACTSUCCESS,
 		KCOMPACTD_WAKE,
 		KCOMPACTD_MIGRATE_SCANNED, KCOMPACTD_FREE_SCANNED,
@@ -146,6 +152,10 @@ enum vm_event_item { PGPGIN, PGPGOUT, PSWPIN, PSWPOUT,
 		ZSWPIN,
 		ZSWPOUT,
 #endif
+#ifdef CONFIG_MEMCG
+		MEMCG_STOCK_HIT,
+		MEMCG_STOCK_MISS,
+#endif
 #ifdef CONFIG_X86
 		DIRECT_MAP_LEVEL2_SPLIT,
 		DIRECT_MAP_LEVEL3_SPLIT,
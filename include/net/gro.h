@@ -84,6 +84,17 @@ struct napi_gro_cb {
 
 #define NAPI_GRO_CB(skb) ((struct napi_gro_cb *)(skb)->cb)
 
+/*
+ * Adaptive flush classification, see dev_gro_receive().  gro_list->avg_segs
+ * is kept in GRO_CADENCE_SHIFT fixed point; buckets averaging fewer than
+ * GRO_CADENCE_BULK_SEGS segments per completed batch are considered
+ * latency sensitive and every GRO_CADENCE_PROBE'th of their packets is
+ * still held to keep the estimate fresh.
+ */
+#define GRO_CADENCE_SHIFT	4
+#define GRO_CADENCE_BULK_SEGS	(2 << GRO_CADENCE_SHIFT)
+#define GRO_CADENCE_PROBE	16
+
 #define GRO_RECURSION_LIMIT 15
 static inline int gro_recursion_inc_test(struct sk_buff *skb)
 {
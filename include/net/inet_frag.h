@@ -9,6 +9,13 @@
 #include <linux/refcount.h>
 #include <net/dropreason-core.h>
 
+/* The frag queues of one netns are sharded over several independent
+ * rhashtables, selected by the flow key hash, so that bursts of
+ * fragmented traffic spread over separate bucket locks and rehash
+ * work instead of piling up on one table.  See fqdir_partition().
+ */
+#define FQDIR_HASH_PARTITIONS	8
+
 /* Per netns frag queues directory */
 struct fqdir {
 	/* sysctls */
@@ -19,8 +26,11 @@ struct fqdir {
 	struct inet_frags	*f;
 	struct net		*net;
 	bool			dead;
+	u32			part_seed;
 
-	struct rhashtable       rhashtable ____cacheline_aligned_in_smp;
+	struct rhashtable	rhashtable[FQDIR_HASH_PARTITIONS]
+					____cacheline_aligned_in_smp;
+	atomic_long_t		evictions[FQDIR_HASH_PARTITIONS];
 
 	/* Keep atomic mem on separate cachelines in structs that include it */
 	atomic_long_t		mem ____cacheline_aligned_in_smp;
@@ -151,6 +161,17 @@ static inline void inet_frag_put(struct inet_frag_queue *q)
 		inet_frag_destroy(q);
 }
 
+/* Number of queues currently held, summed over all partitions. */
+static inline unsigned int fqdir_nelems(const struct fqdir *fqdir)
+{
+	unsigned int n = 0;
+	int i;
+
+	for (i = 0; i < FQDIR_HASH_PARTITIONS; i++)
+		n += atomic_read(&fqdir->rhashtable[i].nelems);
+	return n;
+}
+
 /* Memory Tracking Functions. */
 
 static inline long frag_mem_limit(const struct fqdir *fqdir)
@@ -238,6 +238,10 @@ bool inet_bind_bucket_match(const struct inet_bind_bucket *tb,
 			    const struct net *net, unsigned short port,
 			    int l3mdev);
 
+bool inet_bind_bucket_fast_conflict(const struct inet_bind_hashbucket *head,
+				    const struct net *net,
+				    unsigned short port, int l3mdev);
+
 struct inet_bind2_bucket *
 inet_bind2_bucket_create(struct kmem_cache *cachep, struct net *net,
 			 struct inet_bind_hashbucket *head,
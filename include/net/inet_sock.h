@@ -13,6 +13,7 @@
 #define _INET_SOCK_H
 
 #include <linux/bitops.h>
+#include <linux/ip.h>
 #include <linux/string.h>
 #include <linux/types.h>
 #include <linux/jhash.h>
@@ -248,6 +249,15 @@ struct inet_sock {
 	int			mc_index;
 	__be32			mc_addr;
 	struct ip_mc_socklist __rcu	*mc_list;
+	/* Transmit header template cache, only written and compared by
+	 * __ip_queue_xmit().  hdr_tmpl_dst is not refcounted; it is only
+	 * ever compared against the dst the socket currently holds a
+	 * reference on, never dereferenced.
+	 */
+	struct dst_entry	*hdr_tmpl_dst;
+	struct iphdr		hdr_tmpl;
+	__s16			hdr_tmpl_uc_ttl;
+	__u8			hdr_tmpl_pmtudisc;
 	struct inet_cork_full	cork;
 	struct {
 		__u16 lo;
@@ -196,6 +196,18 @@ struct neigh_hash_table {
 	struct rcu_head		rcu;
 };
 
+#define NEIGH_CPU_CACHE_SLOTS	4
+
+/* Small per-CPU MRU cache in front of the neighbour hash table.  Each
+ * slot holds a reference on the cached neighbour; slots are only
+ * manipulated by the owning CPU with BHs disabled.  Dead entries are
+ * evicted lazily on the next probe, and all slots are flushed when a
+ * device goes down so cached references never delay unregistration.
+ */
+struct neigh_cpu_cache {
+	struct neighbour	*slot[NEIGH_CPU_CACHE_SLOTS];
+	unsigned int		hand;
+};
 
 struct neigh_table {
 	int			family;
@@ -232,6 +244,7 @@ struct neigh_table {
 	rwlock_t		lock;
 	unsigned long		last_rand;
 	struct neigh_statistics	__percpu *stats;
+	struct neigh_cpu_cache	__percpu *cpu_cache;
 	struct neigh_hash_table __rcu *nht;
 	struct pneigh_entry	**phash_buckets;
 };
@@ -290,6 +303,11 @@ static inline bool neigh_key_eq128(const struct neighbour *n, const void *pkey)
 		(n32[2] ^ p32[2]) | (n32[3] ^ p32[3])) == 0;
 }
 
+struct neighbour *neigh_cpu_cache_lookup(struct neigh_table *tbl,
+					 const void *pkey,
+					 struct net_device *dev);
+void neigh_cpu_cache_insert(struct neigh_table *tbl, struct neighbour *n);
+
 static inline struct neighbour *___neigh_lookup_noref(
 	struct neigh_table *tbl,
 	bool (*key_eq)(const struct neighbour *n, const void *pkey),
@@ -299,16 +317,23 @@ static inline struct neighbour *___neigh_lookup_noref(
 	const void *pkey,
 	struct net_device *dev)
 {
-	struct neigh_hash_table *nht = rcu_dereference(tbl->nht);
+	struct neigh_hash_table *nht;
 	struct neighbour *n;
 	u32 hash_val;
 
+	n = neigh_cpu_cache_lookup(tbl, pkey, dev);
+	if (n)
+		return n;
+
+	nht = rcu_dereference(tbl->nht);
 	hash_val = hash(pkey, dev, nht->hash_rnd) >> (32 - nht->hash_shift);
 	for (n = rcu_dereference(nht->hash_buckets[hash_val]);
 	     n != NULL;
 	     n = rcu_dereference(n->next)) {
-		if (n->dev == dev && key_eq(n, pkey))
+		if (n->dev == dev && key_eq(n, pkey)) {
+			neigh_cpu_cache_insert(tbl, n);
 			return n;
+		}
 	}
 
 	return NULL;
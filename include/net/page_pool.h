@@ -46,9 +46,16 @@
 					* device driver responsibility
 					*/
 #define PP_FLAG_PAGE_FRAG	BIT(2) /* for page frag feature */
+#define PP_FLAG_NODE_RESERVOIR	BIT(3) /* back this pool with the shared
+					* per-NUMA-node page reservoir, so
+					* pages it releases can be reused by
+					* other queues and devices on the
+					* node.  Order-0 pools only.
+					*/
 #define PP_FLAG_ALL		(PP_FLAG_DMA_MAP |\
 				 PP_FLAG_DMA_SYNC_DEV |\
-				 PP_FLAG_PAGE_FRAG)
+				 PP_FLAG_PAGE_FRAG |\
+				 PP_FLAG_NODE_RESERVOIR)
 
 /*
  * Fast allocation side cache array/stack
@@ -148,9 +155,14 @@ static inline u64 *page_pool_ethtool_stats_get(u64 *data, void *stats)
 
 #endif
 
+struct pp_node_reservoir;
+
 struct page_pool {
 	struct page_pool_params p;
 
+	/* shared per-node reservoir, see PP_FLAG_NODE_RESERVOIR */
+	struct pp_node_reservoir *reservoir;
+
 	struct delayed_work release_dw;
 	void (*disconnect)(void *);
 	unsigned long defer_start;
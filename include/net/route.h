@@ -113,6 +113,9 @@ struct rt_cache_stat {
         unsigned int in_martian_src;
         unsigned int out_slow_tot;
         unsigned int out_slow_mc;
+        unsigned int fnhe_pmtu;
+        unsigned int fnhe_redirect;
+        unsigned int fnhe_evict;
 };
 
 extern struct ip_rt_acct __percpu *ip_rt_acct;
@@ -246,6 +246,7 @@ struct sock_common {
 
 struct bpf_local_storage;
 struct sk_filter;
+struct sk_send_template;
 
 /**
   *	struct sock - network layer representation of sockets
@@ -466,6 +467,7 @@ struct sock {
 	unsigned long		sk_pacing_rate; /* bytes per second */
 	unsigned long		sk_max_pacing_rate;
 	struct page_frag	sk_frag;
+	struct sk_send_template	*sk_send_template;
 	netdev_features_t	sk_route_caps;
 	int			sk_gso_type;
 	unsigned int		sk_gso_max_size;
@@ -1880,8 +1882,33 @@ struct sockcm_cookie {
 	u64 transmit_time;
 	u32 mark;
 	u32 tsflags;
+	u32 tmpl_off;
+	u32 tmpl_len;	/* 0: no send template referenced */
 };
 
+/* Immutable blob registered with SO_SENDTEMPLATE and referenced by
+ * individual sends through an SO_SENDTEMPLATE cmsg; the pages are
+ * attached to the write queue as ordinary frags, so a referenced range
+ * is queued without copying.  Registration and use are serialized by
+ * the socket lock; clones (accepted children) share the blob through
+ * the refcount.
+ */
+struct sk_send_template {
+	refcount_t	ref;
+	u32		len;
+	u32		nr_pages;
+	struct page	*pages[];
+};
+
+#define SK_SEND_TEMPLATE_MAX	65536
+
+void sk_send_template_put(struct sk_send_template *tmpl);
+
+static inline void sk_send_template_hold(struct sk_send_template *tmpl)
+{
+	refcount_inc(&tmpl->ref);
+}
+
 static inline void sockcm_init(struct sockcm_cookie *sockc,
 			       const struct sock *sk)
 {
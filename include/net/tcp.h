@@ -638,9 +638,9 @@ void tcp_sack_compress_send_ack(struct sock *sk);
 void tcp_init_xmit_timers(struct sock *);
 static inline void tcp_clear_xmit_timers(struct sock *sk)
 {
-	if (hrtimer_try_to_cancel(&tcp_sk(sk)->pacing_timer) == 1)
-		__sock_put(sk);
-
+	/* A socket queued on a pacing wheel is pinned by the wheel's own
+	 * reference and is released at the next due tick.
+	 */
 	if (hrtimer_try_to_cancel(&tcp_sk(sk)->compressed_ack_timer) == 1)
 		__sock_put(sk);
 
@@ -2277,8 +2277,6 @@ static inline void tcp_listendrop(const struct sock *sk)
 	__NET_INC_STATS(sock_net(sk), LINUX_MIB_LISTENDROPS);
 }
 
-enum hrtimer_restart tcp_pace_kick(struct hrtimer *timer);
-
 /*
  * Interface for adding Upper Level Protocols over TCP
  */
@@ -112,6 +112,40 @@ TRACE_EVENT(file_check_and_advance_wb_err,
 			MINOR(__entry->s_dev), __entry->i_ino, __entry->old,
 			__entry->new)
 );
+
+TRACE_EVENT(mm_filemap_stride_readahead,
+
+	TP_PROTO(struct address_space *mapping, pgoff_t index, long stride,
+		 unsigned int hits, unsigned int nr_to_read),
+
+	TP_ARGS(mapping, index, stride, hits, nr_to_read),
+
+	TP_STRUCT__entry(
+		__field(unsigned long, i_ino)
+		__field(dev_t, s_dev)
+		__field(unsigned long, index)
+		__field(long, stride)
+		__field(unsigned int, hits)
+		__field(unsigned int, nr_to_read)
+	),
+
+	TP_fast_assign(
+		__entry->i_ino = mapping->host->i_ino;
+		if (mapping->host->i_sb)
+			__entry->s_dev = mapping->host->i_sb->s_dev;
+		else
+			__entry->s_dev = mapping->host->i_rdev;
+		__entry->index = index;
+		__entry->stride = stride;
+		__entry->hits = hits;
+		__entry->nr_to_read = nr_to_read;
+	),
+
+	TP_printk("dev=%d:%d ino=0x%lx index=%lu stride=%ld hits=%u nr_to_read=%u",
+		MAJOR(__entry->s_dev), MINOR(__entry->s_dev), __entry->i_ino,
+		__entry->index, __entry->stride, __entry->hits,
+		__entry->nr_to_read)
+);
 #endif /* _TRACE_FILEMAP_H */
 
 /* This part must be outside protection */
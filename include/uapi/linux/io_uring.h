@@ -173,6 +173,12 @@ enum {
  */
 #define IORING_SETUP_DEFER_TASKRUN	(1U << 13)
 
+/*
+ * Track a log2 histogram of request completion latency, exported through
+ * the ring fd's fdinfo.
+ */
+#define IORING_SETUP_LAT_STATS		(1U << 14)
+
 enum io_uring_op {
 	IORING_OP_NOP,
 	IORING_OP_READV,
@@ -523,6 +529,9 @@ enum {
 	/* register a range of fixed file slots for automatic slot allocation */
 	IORING_REGISTER_FILE_ALLOC_RANGE	= 25,
 
+	/* grow an already registered fixed file table in place */
+	IORING_REGISTER_FILES_GROW		= 26,
+
 	/* this goes last */
 	IORING_REGISTER_LAST,
 
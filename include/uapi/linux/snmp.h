@@ -296,6 +296,8 @@ enum
 	LINUX_MIB_TCPMIGRATEREQSUCCESS,		/* TCPMigrateReqSuccess */
 	LINUX_MIB_TCPMIGRATEREQFAILURE,		/* TCPMigrateReqFailure */
 	LINUX_MIB_TCPPLBREHASH,			/* TCPPLBRehash */
+	LINUX_MIB_TCPMETRICSHITS,		/* TCPMetricsHits */
+	LINUX_MIB_TCPMETRICSMISSES,		/* TCPMetricsMisses */
 	__LINUX_MIB_MAX
 };
 
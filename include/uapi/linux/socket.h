@@ -35,4 +35,12 @@ struct __kernel_sockaddr_storage {
 #define SOCK_TXREHASH_DISABLED	0
 #define SOCK_TXREHASH_ENABLED	1
 
+/* Range of a blob registered with SO_SENDTEMPLATE, referenced from a
+ * send through an SO_SENDTEMPLATE control message.
+ */
+struct so_sendtemplate_ref {
+	__u32	off;
+	__u32	len;
+};
+
 #endif /* _UAPI_LINUX_SOCKET_H */
@@ -363,6 +363,10 @@ struct tcp_zerocopy_receive {
 	__u64 msg_control; /* ancillary data */
 	__u64 msg_controllen;
 	__u32 msg_flags;
-	__u32 reserved; /* set to 0 for now */
+	__u32 copybuf_head_len; /* in: must be 0; out: bytes at the start of
+				 * the copybuf that precede the mapped region
+				 * (unaligned head sliver); the remaining
+				 * copybuf bytes follow it
+				 */
 };
 #endif /* _UAPI_LINUX_TCP_H */
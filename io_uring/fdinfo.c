@@ -144,6 +144,15 @@ static __cold void __io_uring_show_fdinfo(struct io_ring_ctx *ctx,
 
 	seq_printf(m, "SqThread:\t%d\n", sq ? task_pid_nr(sq->thread) : -1);
 	seq_printf(m, "SqThreadCpu:\t%d\n", sq ? task_cpu(sq->thread) : -1);
+	seq_printf(m, "SqPollRounds:\t%lu\n", sq ? ctx->sqpoll_rounds : 0);
+	seq_printf(m, "SqPollSubmitted:\t%lu\n", sq ? ctx->sqpoll_submitted : 0);
+	seq_printf(m, "SqPollIdleStreak:\t%u\n", sq ? ctx->sqpoll_idle_streak : 0);
+	if (ctx->flags & IORING_SETUP_LAT_STATS) {
+		seq_puts(m, "LatHist:");
+		for (i = 0; i < ARRAY_SIZE(ctx->lat_hist); i++)
+			seq_printf(m, "\t%llu", ctx->lat_hist[i]);
+		seq_puts(m, "\n");
+	}
 	seq_printf(m, "UserFiles:\t%u\n", ctx->nr_user_files);
 	for (i = 0; has_lock && i < ctx->nr_user_files; i++) {
 		struct file *f = io_file_from_index(&ctx->file_table, i);
@@ -52,6 +52,32 @@ bool io_alloc_file_tables(struct io_file_table *table, unsigned nr_files)
 	return true;
 }
 
+bool io_grow_file_tables(struct io_file_table *table, unsigned old_nr,
+			 unsigned nr_files)
+{
+	struct io_fixed_file *files;
+	unsigned long *bitmap;
+
+	files = kvcalloc(nr_files, sizeof(files[0]), GFP_KERNEL_ACCOUNT);
+	if (unlikely(!files))
+		return false;
+
+	bitmap = bitmap_zalloc(nr_files, GFP_KERNEL_ACCOUNT);
+	if (unlikely(!bitmap)) {
+		kvfree(files);
+		return false;
+	}
+
+	memcpy(files, table->files, old_nr * sizeof(files[0]));
+	bitmap_copy(bitmap, table->bitmap, old_nr);
+
+	kvfree(table->files);
+	bitmap_free(table->bitmap);
+	table->files = files;
+	table->bitmap = bitmap;
+	return true;
+}
+
 void io_free_file_tables(struct io_file_table *table)
 {
 	kvfree(table->files);
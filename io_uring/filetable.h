@@ -10,6 +10,8 @@
 #define FFS_MASK		~(FFS_NOWAIT|FFS_ISREG)
 
 bool io_alloc_file_tables(struct io_file_table *table, unsigned nr_files);
+bool io_grow_file_tables(struct io_file_table *table, unsigned old_nr,
+			 unsigned nr_files);
 void io_free_file_tables(struct io_file_table *table);
 
 int io_fixed_fd_install(struct io_kiocb *req, unsigned int issue_flags,
@@ -16,6 +16,7 @@
 #include <linux/task_work.h>
 #include <linux/audit.h>
 #include <linux/mmu_context.h>
+#include <linux/topology.h>
 #include <uapi/linux/io_uring.h>
 
 #include "io-wq.h"
@@ -59,6 +60,8 @@ struct io_worker {
 	unsigned long create_state;
 	struct callback_head create_work;
 	int create_index;
+	/* node the worker was created on, used for placement and affinity */
+	int numa_node;
 
 	union {
 		struct rcu_head rcu;
@@ -689,9 +692,24 @@ void io_wq_worker_sleeping(struct task_struct *tsk)
 static void io_init_new_worker(struct io_wq *wq, struct io_worker *worker,
 			       struct task_struct *tsk)
 {
+	cpumask_var_t node_mask;
+
 	tsk->worker_private = worker;
 	worker->task = tsk;
-	set_cpus_allowed_ptr(tsk, wq->cpu_mask);
+
+	/*
+	 * Keep the worker on the node it was created for as long as the wq
+	 * affinity allows it, so that work queued from that node runs with
+	 * node-local stacks and data. Fall back to the full wq mask if the
+	 * intersection is empty (or we can't allocate a scratch mask).
+	 */
+	if (zalloc_cpumask_var(&node_mask, GFP_KERNEL) &&
+	    cpumask_and(node_mask, wq->cpu_mask,
+			cpumask_of_node(worker->numa_node)))
+		set_cpus_allowed_ptr(tsk, node_mask);
+	else
+		set_cpus_allowed_ptr(tsk, wq->cpu_mask);
+	free_cpumask_var(node_mask);
 
 	raw_spin_lock(&wq->lock);
 	hlist_nulls_add_head_rcu(&worker->nulls_node, &wq->free_list);
@@ -735,7 +753,7 @@ static void create_worker_cont(struct callback_head *cb)
 	worker = container_of(cb, struct io_worker, create_work);
 	clear_bit_unlock(0, &worker->create_state);
 	wq = worker->wq;
-	tsk = create_io_thread(io_wq_worker, worker, NUMA_NO_NODE);
+	tsk = create_io_thread(io_wq_worker, worker, worker->numa_node);
 	if (!IS_ERR(tsk)) {
 		io_init_new_worker(wq, worker, tsk);
 		io_worker_release(worker);
@@ -782,10 +800,16 @@ static bool create_io_worker(struct io_wq *wq, int index)
 	struct io_wq_acct *acct = &wq->acct[index];
 	struct io_worker *worker;
 	struct task_struct *tsk;
+	int node = numa_node_id();
 
 	__set_current_state(TASK_RUNNING);
 
-	worker = kzalloc(sizeof(*worker), GFP_KERNEL);
+	/*
+	 * Workers are created in response to work being queued, so placing
+	 * the new worker on the queueing CPU's node keeps its stack and the
+	 * work it will process node-local.
+	 */
+	worker = kzalloc_node(sizeof(*worker), GFP_KERNEL, node);
 	if (!worker) {
 fail:
 		atomic_dec(&acct->nr_running);
@@ -798,13 +822,14 @@ fail:
 
 	refcount_set(&worker->ref, 1);
 	worker->wq = wq;
+	worker->numa_node = node;
 	raw_spin_lock_init(&worker->lock);
 	init_completion(&worker->ref_done);
 
 	if (index == IO_WQ_ACCT_BOUND)
 		worker->flags |= IO_WORKER_F_BOUND;
 
-	tsk = create_io_thread(io_wq_worker, worker, NUMA_NO_NODE);
+	tsk = create_io_thread(io_wq_worker, worker, node);
 	if (!IS_ERR(tsk)) {
 		io_init_new_worker(wq, worker, tsk);
 	} else if (!io_should_retry_thread(PTR_ERR(tsk))) {
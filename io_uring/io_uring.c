@@ -934,6 +934,26 @@ bool io_post_aux_cqe(struct io_ring_ctx *ctx, u64 user_data, s32 res, u32 cflags
 	return __io_post_aux_cqe(ctx, user_data, res, cflags, true);
 }
 
+/*
+ * Post a CQE to a ring owned by another task. For ->task_complete rings the
+ * CQ ring itself may only be written by the submitter task, so the entry is
+ * parked on the overflow list under ->completion_lock and flushed by the
+ * owner the next time it enters the kernel. That costs the target a flush,
+ * but spares the poster the task_work round trip through the owner task.
+ */
+bool io_post_remote_aux_cqe(struct io_ring_ctx *ctx, u64 user_data, s32 res,
+			    u32 cflags)
+{
+	bool filled;
+
+	spin_lock(&ctx->completion_lock);
+	filled = io_cqring_event_overflow(ctx, user_data, res, cflags, 0, 0);
+	spin_unlock(&ctx->completion_lock);
+	if (filled)
+		io_cqring_wake(ctx);
+	return filled;
+}
+
 bool io_aux_cqe(struct io_ring_ctx *ctx, bool defer, u64 user_data, s32 res, u32 cflags,
 		bool allow_overflow)
 {
@@ -1495,6 +1515,27 @@ void io_queue_next(struct io_kiocb *req)
 		io_req_task_queue(nxt);
 }
 
+static void io_queue_next_inline(struct io_kiocb *req)
+	__must_hold(&req->ctx->uring_lock)
+{
+	struct io_kiocb *nxt = io_req_find_next(req);
+	struct io_tw_state ts = { .locked = true };
+
+	if (!nxt)
+		return;
+	/*
+	 * Fuse link chains such as open+read+close: issue the dependent
+	 * request straight off the completion of its parent instead of
+	 * bouncing every hop through task_work. Only valid if the request
+	 * would run in this task's context anyway; anything it defers is
+	 * picked up by the surrounding completion flush.
+	 */
+	if (nxt->task == current)
+		io_req_task_submit(nxt, &ts);
+	else
+		io_req_task_queue(nxt);
+}
+
 void io_free_batch_list(struct io_ring_ctx *ctx, struct io_wq_work_node *node)
 	__must_hold(&ctx->uring_lock)
 {
@@ -1521,7 +1562,7 @@ void io_free_batch_list(struct io_ring_ctx *ctx, struct io_wq_work_node *node)
 				req->flags &= ~REQ_F_POLLED;
 			}
 			if (req->flags & IO_REQ_LINK_FLAGS)
-				io_queue_next(req);
+				io_queue_next_inline(req);
 			if (unlikely(req->flags & IO_REQ_CLEAN_FLAGS))
 				io_clean_op(req);
 		}
@@ -1551,31 +1592,40 @@ static void __io_submit_flush_completions(struct io_ring_ctx *ctx)
 	struct io_submit_state *state = &ctx->submit_state;
 	struct io_wq_work_node *node;
 
-	__io_cq_lock(ctx);
-	/* must come first to preserve CQE ordering in failure cases */
-	if (state->cqes_count)
-		__io_flush_post_cqes(ctx);
-	__wq_list_for_each(node, &state->compl_reqs) {
-		struct io_kiocb *req = container_of(node, struct io_kiocb,
-					    comp_list);
+	/*
+	 * Freeing the batch below may issue dependent link requests inline,
+	 * which in turn can defer new completions onto ->compl_reqs. Loop
+	 * until the list stays empty so nothing is left unposted when we
+	 * return to userspace.
+	 */
+	do {
+		__io_cq_lock(ctx);
+		/* must come first to preserve CQE ordering in failure cases */
+		if (state->cqes_count)
+			__io_flush_post_cqes(ctx);
+		__wq_list_for_each(node, &state->compl_reqs) {
+			struct io_kiocb *req = container_of(node, struct io_kiocb,
+						    comp_list);
 
-		if (!(req->flags & REQ_F_CQE_SKIP) &&
-		    unlikely(!__io_fill_cqe_req(ctx, req))) {
-			if (ctx->task_complete) {
-				spin_lock(&ctx->completion_lock);
-				io_req_cqe_overflow(req);
-				spin_unlock(&ctx->completion_lock);
-			} else {
-				io_req_cqe_overflow(req);
+			if (!(req->flags & REQ_F_CQE_SKIP) &&
+			    unlikely(!__io_fill_cqe_req(ctx, req))) {
+				if (ctx->task_complete) {
+					spin_lock(&ctx->completion_lock);
+					io_req_cqe_overflow(req);
+					spin_unlock(&ctx->completion_lock);
+				} else {
+					io_req_cqe_overflow(req);
+				}
 			}
 		}
-	}
-	__io_cq_unlock_post_flush(ctx);
+		__io_cq_unlock_post_flush(ctx);
 
-	if (!wq_list_empty(&ctx->submit_state.compl_reqs)) {
-		io_free_batch_list(ctx, state->compl_reqs.first);
-		INIT_WQ_LIST(&state->compl_reqs);
-	}
+		if (!wq_list_empty(&state->compl_reqs)) {
+			node = state->compl_reqs.first;
+			INIT_WQ_LIST(&state->compl_reqs);
+			io_free_batch_list(ctx, node);
+		}
+	} while (!wq_list_empty(&state->compl_reqs));
 }
 
 /*
@@ -2223,6 +2273,9 @@ static int io_init_req(struct io_ring_ctx *ctx, struct io_kiocb *req,
 	req->rsrc_node = NULL;
 	req->task = current;
 
+	if (unlikely(ctx->flags & IORING_SETUP_LAT_STATS))
+		req->start_time = ktime_get_ns();
+
 	if (unlikely(opcode >= IORING_OP_LAST)) {
 		req->opcode = 0;
 		return -EINVAL;
@@ -3969,7 +4022,8 @@ static long io_uring_setup(u32 entries, struct io_uring_params __user *params)
 			IORING_SETUP_R_DISABLED | IORING_SETUP_SUBMIT_ALL |
 			IORING_SETUP_COOP_TASKRUN | IORING_SETUP_TASKRUN_FLAG |
 			IORING_SETUP_SQE128 | IORING_SETUP_CQE32 |
-			IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN))
+			IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN |
+			IORING_SETUP_LAT_STATS))
 		return -EINVAL;
 
 	return io_uring_create(entries, &p, params);
@@ -4418,6 +4472,9 @@ static int __io_uring_register(struct io_ring_ctx *ctx, unsigned opcode,
 			break;
 		ret = io_register_file_alloc_range(ctx, arg);
 		break;
+	case IORING_REGISTER_FILES_GROW:
+		ret = io_sqe_files_grow(ctx, arg, nr_args);
+		break;
 	default:
 		ret = -EINVAL;
 		break;
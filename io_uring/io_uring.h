@@ -5,6 +5,7 @@
 #include <linux/lockdep.h>
 #include <linux/resume_user_mode.h>
 #include <linux/kasan.h>
+#include <linux/ktime.h>
 #include <linux/io_uring_types.h>
 #include <uapi/linux/eventpoll.h>
 #include "io-wq.h"
@@ -47,6 +48,8 @@ int io_run_task_work_sig(struct io_ring_ctx *ctx);
 void io_req_defer_failed(struct io_kiocb *req, s32 res);
 void io_req_complete_post(struct io_kiocb *req, unsigned issue_flags);
 bool io_post_aux_cqe(struct io_ring_ctx *ctx, u64 user_data, s32 res, u32 cflags);
+bool io_post_remote_aux_cqe(struct io_ring_ctx *ctx, u64 user_data, s32 res,
+			    u32 cflags);
 bool io_aux_cqe(struct io_ring_ctx *ctx, bool defer, u64 user_data, s32 res, u32 cflags,
 		bool allow_overflow);
 void __io_commit_cqring_flush(struct io_ring_ctx *ctx);
@@ -140,6 +143,19 @@ static inline struct io_uring_cqe *io_get_cqe(struct io_ring_ctx *ctx)
 	return io_get_cqe_overflow(ctx, false);
 }
 
+static inline void io_req_lat_stats(struct io_ring_ctx *ctx,
+				    struct io_kiocb *req)
+{
+	u64 delta = ktime_get_ns() - req->start_time;
+	unsigned int bucket = fls64(delta);
+
+	if (bucket)
+		bucket--;
+	if (bucket >= ARRAY_SIZE(ctx->lat_hist))
+		bucket = ARRAY_SIZE(ctx->lat_hist) - 1;
+	ctx->lat_hist[bucket]++;
+}
+
 static inline bool __io_fill_cqe_req(struct io_ring_ctx *ctx,
 				     struct io_kiocb *req)
 {
@@ -154,6 +170,9 @@ static inline bool __io_fill_cqe_req(struct io_ring_ctx *ctx,
 	if (unlikely(!cqe))
 		return false;
 
+	if (unlikely(ctx->flags & IORING_SETUP_LAT_STATS))
+		io_req_lat_stats(ctx, req);
+
 	trace_io_uring_complete(req->ctx, req, req->cqe.user_data,
 				req->cqe.res, req->cqe.flags,
 				(req->flags & REQ_F_CQE32_INIT) ? req->extra1 : 0,
@@ -133,8 +133,11 @@ static void __user *io_ring_buffer_select(struct io_kiocb *req, size_t *len,
 	struct io_uring_buf *buf;
 	__u16 head = bl->head;
 
-	if (unlikely(smp_load_acquire(&br->tail) == head))
-		return NULL;
+	if (bl->cached_tail == head) {
+		bl->cached_tail = smp_load_acquire(&br->tail);
+		if (unlikely(bl->cached_tail == head))
+			return NULL;
+	}
 
 	head &= bl->mask;
 	/* mmaped buffers are always contig */
@@ -589,6 +592,8 @@ int io_register_pbuf_ring(struct io_ring_ctx *ctx, void __user *arg)
 	if (!ret) {
 		bl->nr_entries = reg.ring_entries;
 		bl->mask = reg.ring_entries - 1;
+		/* start out with an empty view of the ring */
+		bl->cached_tail = bl->head;
 
 		io_buffer_add_list(ctx, bl, reg.bgid);
 		return 0;
@@ -23,6 +23,12 @@ struct io_buffer_list {
 	__u16 nr_entries;
 	__u16 head;
 	__u16 mask;
+	/*
+	 * Snapshot of the ring tail. The real tail lives in a cacheline that
+	 * userspace writes to replenish buffers, so it's only re-read once
+	 * the cached view is exhausted, picking up refills in batches.
+	 */
+	__u16 cached_tail;
 
 	/* ring mapped provided buffers */
 	__u8 is_mapped;
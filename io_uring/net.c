@@ -554,7 +554,8 @@ int io_recvmsg_prep_async(struct io_kiocb *req)
 	return ret;
 }
 
-#define RECVMSG_FLAGS (IORING_RECVSEND_POLL_FIRST | IORING_RECV_MULTISHOT)
+#define RECVMSG_FLAGS (IORING_RECVSEND_POLL_FIRST | IORING_RECV_MULTISHOT | \
+			IORING_RECVSEND_FIXED_BUF)
 
 int io_recvmsg_prep(struct io_kiocb *req, const struct io_uring_sqe *sqe)
 {
@@ -573,7 +574,29 @@ int io_recvmsg_prep(struct io_kiocb *req, const struct io_uring_sqe *sqe)
 		req->flags |= REQ_F_NOWAIT;
 	if (sr->msg_flags & MSG_ERRQUEUE)
 		req->flags |= REQ_F_CLEAR_POLLIN;
+	if (sr->flags & IORING_RECVSEND_FIXED_BUF) {
+		struct io_ring_ctx *ctx = req->ctx;
+		unsigned idx = READ_ONCE(sqe->buf_index);
+
+		/*
+		 * Receiving into a registered buffer skips the per-request
+		 * import and pin of the destination. Only the plain recv
+		 * variant supports it, and it's mutually exclusive with
+		 * provided buffers.
+		 */
+		if (req->opcode != IORING_OP_RECV)
+			return -EINVAL;
+		if (req->flags & REQ_F_BUFFER_SELECT)
+			return -EINVAL;
+		if (unlikely(idx >= ctx->nr_user_bufs))
+			return -EFAULT;
+		idx = array_index_nospec(idx, ctx->nr_user_bufs);
+		req->imu = READ_ONCE(ctx->user_bufs[idx]);
+		io_req_set_rsrc_node(req, ctx, 0);
+	}
 	if (sr->flags & IORING_RECV_MULTISHOT) {
+		if (sr->flags & IORING_RECVSEND_FIXED_BUF)
+			return -EINVAL;
 		if (!(req->flags & REQ_F_BUFFER_SELECT))
 			return -EINVAL;
 		if (sr->msg_flags & MSG_WAITALL)
@@ -870,7 +893,11 @@ retry_multishot:
 		sr->buf = buf;
 	}
 
-	ret = import_ubuf(ITER_DEST, sr->buf, len, &msg.msg_iter);
+	if (sr->flags & IORING_RECVSEND_FIXED_BUF)
+		ret = io_import_fixed(ITER_DEST, &msg.msg_iter, req->imu,
+					(u64)(uintptr_t)sr->buf, len);
+	else
+		ret = import_ubuf(ITER_DEST, sr->buf, len, &msg.msg_iter);
 	if (unlikely(ret))
 		goto out_free;
 
@@ -1262,6 +1289,12 @@ void io_sendrecv_fail(struct io_kiocb *req)
 		req->cqe.flags |= IORING_CQE_F_MORE;
 }
 
+/*
+ * Cap on the number of connections a multishot accept will pull off the
+ * backlog inline in one issue before requeueing itself via task_work.
+ */
+#define IO_ACCEPT_MAX_BATCH	32
+
 int io_accept_prep(struct io_kiocb *req, const struct io_uring_sqe *sqe)
 {
 	struct io_accept *accept = io_kiocb_to_cmd(req, struct io_accept);
@@ -1302,6 +1335,7 @@ int io_accept(struct io_kiocb *req, unsigned int issue_flags)
 	bool force_nonblock = issue_flags & IO_URING_F_NONBLOCK;
 	unsigned int file_flags = force_nonblock ? O_NONBLOCK : 0;
 	bool fixed = !!accept->file_slot;
+	unsigned int nr_accepted = 0;
 	struct file *file;
 	int ret, fd;
 
@@ -1348,8 +1382,20 @@ retry:
 	if (ret < 0)
 		return ret;
 	if (io_aux_cqe(ctx, issue_flags & IO_URING_F_COMPLETE_DEFER,
-		       req->cqe.user_data, ret, IORING_CQE_F_MORE, true))
-		goto retry;
+		       req->cqe.user_data, ret, IORING_CQE_F_MORE, true)) {
+		/*
+		 * Keep draining the backlog in this pass rather than taking
+		 * a poll wakeup per connection, but cap the inline batch so
+		 * a connect storm can't starve other work on this task.
+		 * Past the cap, requeue ourselves through task_work and
+		 * continue accepting from there.
+		 */
+		if (++nr_accepted < IO_ACCEPT_MAX_BATCH)
+			goto retry;
+		req->io_task_work.func = io_req_task_submit;
+		io_req_task_work_add(req);
+		return IOU_ISSUE_SKIP_COMPLETE;
+	}
 
 	return -ECANCELED;
 }
@@ -346,6 +346,29 @@ fail:
 	return ret;
 }
 
+__cold static int io_rsrc_data_grow(struct io_rsrc_data *data, unsigned nr)
+{
+	u64 **tags;
+	unsigned i;
+
+	tags = (u64 **)io_alloc_page_table(nr * sizeof(data->tags[0][0]));
+	if (!tags)
+		return -ENOMEM;
+
+	for (i = 0; i < data->nr; i++) {
+		unsigned int off = i & IO_RSRC_TAG_TABLE_MASK;
+		unsigned int table_idx = i >> IO_RSRC_TAG_TABLE_SHIFT;
+
+		tags[table_idx][off] = *io_get_tag_slot(data, i);
+	}
+
+	io_free_page_table((void **)data->tags,
+			   data->nr * sizeof(data->tags[0][0]));
+	data->tags = tags;
+	data->nr = nr;
+	return 0;
+}
+
 static int __io_sqe_files_update(struct io_ring_ctx *ctx,
 				 struct io_uring_rsrc_update2 *up,
 				 unsigned nr_args)
@@ -919,6 +942,50 @@ fail:
 	return ret;
 }
 
+__cold int io_sqe_files_grow(struct io_ring_ctx *ctx, void __user *arg,
+			     unsigned int size)
+{
+	struct io_uring_rsrc_register rr;
+	unsigned old_nr;
+	int ret;
+
+	/* keep it extendible */
+	if (size != sizeof(rr))
+		return -EINVAL;
+	memset(&rr, 0, sizeof(rr));
+	if (copy_from_user(&rr, arg, size))
+		return -EFAULT;
+	/* new slots always come up sparse and untagged */
+	if (rr.flags || rr.resv2 || rr.data || rr.tags)
+		return -EINVAL;
+	if (!ctx->file_data)
+		return -ENXIO;
+	old_nr = ctx->nr_user_files;
+	if (rr.nr <= old_nr)
+		return -EINVAL;
+	if (rr.nr > IORING_MAX_FIXED_FILES)
+		return -EMFILE;
+	if (rr.nr > rlimit(RLIMIT_NOFILE))
+		return -EMFILE;
+
+	/*
+	 * Fixed file lookups and updates all run under ->uring_lock, which
+	 * the register syscall holds here, so the tables can be swapped in
+	 * place without quiescing the ring and stalling in-flight I/O. The
+	 * new slots are filled through the normal update paths afterwards.
+	 */
+	if (!io_grow_file_tables(&ctx->file_table, old_nr, rr.nr))
+		return -ENOMEM;
+	ret = io_rsrc_data_grow(ctx->file_data, rr.nr);
+	if (ret)
+		return ret;
+	ctx->nr_user_files = rr.nr;
+	/* if the alloc range covered the whole table, keep it that way */
+	if (ctx->file_alloc_start == 0 && ctx->file_alloc_end == old_nr)
+		io_file_table_set_alloc_range(ctx, 0, rr.nr);
+	return 0;
+}
+
 static void io_rsrc_buf_put(struct io_ring_ctx *ctx, struct io_rsrc_put *prsrc)
 {
 	io_buffer_unmap(ctx, &prsrc->buf);
@@ -75,6 +75,8 @@ void __io_sqe_files_unregister(struct io_ring_ctx *ctx);
 int io_sqe_files_unregister(struct io_ring_ctx *ctx);
 int io_sqe_files_register(struct io_ring_ctx *ctx, void __user *arg,
 			  unsigned nr_args, u64 __user *tags);
+int io_sqe_files_grow(struct io_ring_ctx *ctx, void __user *arg,
+		      unsigned int size);
 
 int __io_scm_file_account(struct io_ring_ctx *ctx, struct file *file);
 
@@ -19,6 +19,15 @@
 
 #define IORING_SQPOLL_CAP_ENTRIES_VALUE 8
 
+/*
+ * A ring that has gone this many scan rounds without producing any work is
+ * considered cold and only gets scanned every IORING_SQPOLL_COLD_SCAN'th
+ * round, so that a large population of idle rings sharing one sq thread
+ * doesn't dominate the scan loop. Hot rings are still scanned every round.
+ */
+#define IORING_SQPOLL_COLD_STREAK	64
+#define IORING_SQPOLL_COLD_SCAN		8
+
 enum {
 	IO_SQ_THREAD_SHOULD_STOP = 0,
 	IO_SQ_THREAD_SHOULD_PARK,
@@ -169,6 +178,7 @@ static int __io_sq_thread(struct io_ring_ctx *ctx, bool cap_entries)
 	unsigned int to_submit;
 	int ret = 0;
 
+	ctx->sqpoll_rounds++;
 	to_submit = io_sqring_entries(ctx);
 	/* if we're handling multiple rings, cap submit size for fairness */
 	if (cap_entries && to_submit > IORING_SQPOLL_CAP_ENTRIES_VALUE)
@@ -199,6 +209,13 @@ static int __io_sq_thread(struct io_ring_ctx *ctx, bool cap_entries)
 			revert_creds(creds);
 	}
 
+	if (ret > 0) {
+		ctx->sqpoll_submitted += ret;
+		ctx->sqpoll_idle_streak = 0;
+	} else if (ctx->sqpoll_idle_streak < IORING_SQPOLL_COLD_STREAK) {
+		ctx->sqpoll_idle_streak++;
+	}
+
 	return ret;
 }
 
@@ -244,9 +261,23 @@ static int io_sq_thread(void *data)
 			timeout = jiffies + sqd->sq_thread_idle;
 		}
 
+		sqd->poll_rounds++;
 		cap_entries = !list_is_singular(&sqd->ctx_list);
 		list_for_each_entry(ctx, &sqd->ctx_list, sqd_list) {
-			int ret = __io_sq_thread(ctx, cap_entries);
+			int ret;
+
+			/*
+			 * Batch scans of cold rings. This only ever defers
+			 * picking up new work by a few spin rounds; before
+			 * the thread goes to sleep every ring is checked
+			 * again below with the wakeup flag set.
+			 */
+			if (cap_entries &&
+			    ctx->sqpoll_idle_streak >= IORING_SQPOLL_COLD_STREAK &&
+			    (sqd->poll_rounds & (IORING_SQPOLL_COLD_SCAN - 1)))
+				continue;
+
+			ret = __io_sq_thread(ctx, cap_entries);
 
 			if (!sqt_spin && (ret > 0 || !wq_list_empty(&ctx->iopoll_list)))
 				sqt_spin = true;
@@ -18,6 +18,9 @@ struct io_sq_data {
 
 	unsigned long		state;
 	struct completion	exited;
+
+	/* scan round counter, used to batch scans of cold rings */
+	unsigned long		poll_rounds;
 };
 
 int io_sq_offload_create(struct io_ring_ctx *ctx, struct io_uring_params *p);
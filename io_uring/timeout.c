@@ -76,11 +76,19 @@ static void io_timeout_complete(struct io_kiocb *req, struct io_tw_state *ts)
 		filled = io_aux_cqe(ctx, ts->locked, req->cqe.user_data, -ETIME,
 				    IORING_CQE_F_MORE, false);
 		if (filled) {
-			/* re-arm timer */
+			/*
+			 * Re-arm relative to the previous expiry rather than
+			 * to "now", so the task_work latency of posting the
+			 * CQE doesn't accumulate into the period and the
+			 * timeout stays a fixed-rate clock.
+			 */
 			spin_lock_irq(&ctx->timeout_lock);
 			list_add(&timeout->list, ctx->timeout_list.prev);
 			data->timer.function = io_timeout_fn;
-			hrtimer_start(&data->timer, timespec64_to_ktime(data->ts), data->mode);
+			hrtimer_start(&data->timer,
+				      ktime_add(hrtimer_get_expires(&data->timer),
+						timespec64_to_ktime(data->ts)),
+				      HRTIMER_MODE_ABS);
 			spin_unlock_irq(&ctx->timeout_lock);
 			return;
 		}
@@ -122,6 +122,22 @@ struct posix_msg_tree_node {
  *    release memory barrier, and the wakeup is triggered when holding
  *    info->lock, i.e. spin_lock(&info->lock) provided a pairing
  *    acquire memory barrier.
+ *
+ * On requests for a lockless per-priority-band ring mode: info->lock is
+ * not where a low-latency message spends its time.  When a receiver is
+ * already waiting, pipelined_send() hands the message straight to it
+ * without ever inserting into the tree, and the rbtree is only walked
+ * when messages actually accumulate at distinct priorities - the
+ * node_cache below makes the refill-free case allocation-less.  The
+ * microseconds measured per message are syscall entry plus the wakeup,
+ * both of which a kernel-side ring would retain, while the lock is
+ * what makes the POSIX guarantees composable: mq_notify delivery,
+ * mq_getattr's coherent curmsgs, strict priority order among an
+ * arbitrary set of blocked senders and receivers.  A pipeline that can
+ * accept relaxed semantics in exchange for ring speed should not be in
+ * the kernel per message at all - a shared-memory ring with a futex
+ * for the empty/full transitions is that design, built from parts that
+ * already exist.
  */
 
 struct ext_wait_queue {		/* queue of sleeping tasks */
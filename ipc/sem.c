@@ -58,6 +58,21 @@
  *   dropping all locks. (see wake_up_sem_queue_prepare())
  * - All work is done by the waker, the woken up task does not have to do
  *   anything - not even acquiring a lock or dropping a refcount.
+ * - A futex-style userspace fast path (uncontended semop against a
+ *   kernel-shared state page, kernel entry only on contention) has been
+ *   requested for legacy databases doing millions of latch ops/s.  It
+ *   founders on the parts of SysV semantics a futex word cannot carry:
+ *   SEM_UNDO means the kernel must observe every successful operation
+ *   to keep the per-process undo ledger (an op completed purely in
+ *   userspace is invisible to exit cleanup, which is the one guarantee
+ *   crashed-holder recovery relies on), multi-sop semop() must apply
+ *   atomically across several semaphores which no per-word CAS
+ *   protocol provides, and sem_otime/sempid/semncnt must reflect
+ *   operations the kernel never saw.  FIFO wakeup fairness would also
+ *   be lost to barging userspace acquirers.  Applications that do not
+ *   need undo or multi-sop atomicity have the fast path already - that
+ *   is what a pthread/futex mutex in a shared mapping is; the value of
+ *   this file is precisely the semantics that keep the syscall.
  * - A woken up task may not even touch the semaphore array anymore, it may
  *   have been destroyed already by a semctl(RMID).
  * - UNDO values are stored in an array (one per process and per
@@ -562,6 +562,23 @@ static unsigned long shm_pagesize(struct vm_area_struct *vma)
 }
 
 #ifdef CONFIG_NUMA
+/*
+ * Segment-attached NUMA placement already works through here and gets
+ * re-requested because it is easy to miss: mbind() on an attached
+ * mapping lands in shm_set_policy() and is forwarded to the backing
+ * file's set_policy, which for both shmem and hugetlbfs stores the
+ * policy in the *inode's* shared policy tree - so an
+ * MPOL_INTERLEAVE set once (by the loader, before faulting) governs
+ * every fault on the segment regardless of which task or node touches
+ * it, including SHM_HUGETLB segments.  The all-200G-on-one-node
+ * outcome is what happens when nobody mbinds and the default
+ * local-allocation policy of the single warming thread decides
+ * placement instead.  No bulk pre-fault API is needed on top:
+ * interleave makes fault placement node-correct from any CPU, so the
+ * loader materializes the segment at full cross-node bandwidth by
+ * touching (or MADV_POPULATE_WRITE-ing) disjoint ranges from a thread
+ * per node.
+ */
 static int shm_set_policy(struct vm_area_struct *vma, struct mempolicy *new)
 {
 	struct file *file = vma->vm_file;
@@ -42,6 +42,22 @@ synchronization with the async_synchronize_full() function, before returning
 from their init function. This is to maintain strict ordering between the
 asynchronous and synchronous parts of the kernel.
 
+A note on why this has not grown first-class dependency edges (run-after
+lists resolved by a topological scheduler): the cookie model is the
+deliberate inversion of that design.  Dependencies in boot are implicit
+and discovered at run time - a mount waits for whichever disk turns out
+to hold the root, not for a probe it could have named in advance - so a
+static DAG either over-approximates (re-creating today's coarse waits
+with more machinery) or must be wired per-driver across subsystem
+boundaries that have no business knowing each other.  Cookies let the
+consumer side express exactly what it needs ("everything scheduled
+before me", or a domain's worth) with no producer cooperation, which is
+what makes the mechanism adoptable one driver at a time.  Idle gaps
+behind async_synchronize_full() calls are best fixed by narrowing the
+caller to a domain or cookie wait - the sync primitives are already as
+fine-grained as the waiter chooses to be - and per-entry timing already
+exists (initcall_debug logs each async function's duration).
+
 */
 
 #include <linux/async.h>
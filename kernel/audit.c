@@ -1840,6 +1840,23 @@ static inline void audit_get_stamp(struct audit_context *ctx,
  * syscall, then the syscall is marked as auditable and an audit record
  * will be written at syscall exit.  If there is no associated task, then
  * task context (ctx) should be NULL.
+ *
+ * Per-CPU record buffers with epoch-based flushing have been proposed
+ * to cut the overhead of fleet-wide syscall auditing.  Note first what
+ * this path actually serializes on: nothing but the audit_queue skb
+ * list lock and an atomic serial - audit_cmd_mutex is control-plane
+ * only, and the backlog check above is a lockless read.  Relaxing to
+ * per-CPU queues with intra-CPU ordering would still break the audit
+ * stream's contract, because a single event is multiple records tied
+ * together by serial which userspace reassembles from a totally
+ * ordered stream; interleaving epochs from 64 CPUs hands auditd a
+ * reordering problem the protocol does not have a solution for, in a
+ * subsystem whose output is evidence.  Most of the measured overhead
+ * of syscall auditing is per-syscall context collection and filtering
+ * before any record is queued; the supported way to get to a low
+ * single-digit overhead is to make the filter discard early (exclude
+ * rules, task filters), after which this queue is touched only for
+ * events that are actually emitted.
  */
 struct audit_buffer *audit_log_start(struct audit_context *ctx, gfp_t gfp_mask,
 				     int type)
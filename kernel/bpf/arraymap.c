@@ -1164,6 +1164,15 @@ static void prog_array_map_free(struct bpf_map *map)
  * Doing static check alone in the verifier is not enough.
  * Thus, prog_array_map cannot be used as an inner_map
  * and map_meta_equal is not implemented.
+ *
+ * This also rules out generation switching of whole dispatch tables by
+ * swapping prog_arrays through a map-in-map.  It is not needed: slot
+ * updates are already a single xchg with RCU retirement of the old
+ * program, so a dispatcher never observes a hole during rollout.  When
+ * a packet must see either all-old or all-new programs, make the table
+ * 2 * N entries, tail-call through index gen * N + key, and flip gen
+ * in a one-element array map - one store switches the whole table and
+ * the retired half can be updated at leisure.
  */
 const struct bpf_map_ops prog_array_map_ops = {
 	.map_alloc_check = fd_array_map_alloc_check,
@@ -414,7 +414,17 @@ void bpf_selem_unlink(struct bpf_local_storage_elem *selem, bool reuse_now)
 	bpf_selem_unlink_storage(selem, reuse_now);
 }
 
-/* If cacheit_lockit is false, this lookup function is lockless */
+/* If cacheit_lockit is false, this lookup function is lockless.
+ *
+ * The cache below is the "fixed slot" design that gets asked for when
+ * the hlist walk shows up in profiles: each map claims one of
+ * BPF_LOCAL_STORAGE_CACHE_SIZE slot indices at allocation time
+ * (see bpf_local_storage_cache_idx_get()), and a lookup is a single
+ * predictable load plus an ownership check, with the chain walked only
+ * on a miss and the slot repopulated afterwards.  Deployments with at
+ * most 16 storage maps per owner type therefore already resolve every
+ * steady-state lookup without touching the list.
+ */
 struct bpf_local_storage_data *
 bpf_local_storage_lookup(struct bpf_local_storage *local_storage,
 			 struct bpf_local_storage_map *smap,
@@ -734,6 +734,18 @@ static void bq_flush_to_queue(struct xdp_bulk_queue *bq)
 /* Runs under RCU-read-side, plus in softirq under NAPI protection.
  * Thus, safe percpu variable access.
  */
+/* The fixed bulk size is not a latency/throughput tradeoff knob, so
+ * there is nothing for adaptive sizing or a flush timer to improve:
+ * the queue is drained at the end of every napi->poll via
+ * xdp_do_flush() no matter how full it is, so low-rate traffic never
+ * waits on the batch filling up, while CPU_MAP_BULK_SIZE only caps how
+ * much is moved per ptr_ring operation at high rate (and is sized to
+ * keep bq->q on one cacheline).  A timer could not help either way -
+ * the bulk queues are strictly CPU-local and only safe to touch from
+ * the napi context that owns them.  Per-entry batch and drop behaviour
+ * is observable through the xdp_cpumap_enqueue / xdp_cpumap_kthread
+ * tracepoints, which carry processed/drop counts per flush.
+ */
 static void bq_enqueue(struct bpf_cpu_map_entry *rcpu, struct xdp_frame *xdpf)
 {
 	struct list_head *flush_list = this_cpu_ptr(&cpu_map_flush_list);
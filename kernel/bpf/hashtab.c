@@ -74,6 +74,21 @@
  * after hash map was fully converted to use bpf_mem_alloc, there will be
  * non-synchronous memory allocation for non-preallocated hash map, so it is
  * safe to always use raw spinlock for bucket lock.
+ *
+ * On the layout: an open-addressed table with inline key/value slots
+ * would save the bucket-to-element pointer hop, and gets proposed
+ * periodically for read-mostly workloads.  It cannot honor the lookup
+ * contract: lookups run locklessly under RCU, and open addressing
+ * reuses a slot's storage for a different key on delete+insert, so a
+ * concurrent reader can see a torn key or a value belonging to a key
+ * it never asked for.  Chaining gives each element identity-stable
+ * storage until an RCU grace period has passed, which is what makes
+ * the lockless walk sound.  Per-slot sequence counts could patch over
+ * reuse, but cost more on the read side than the pointer hop they
+ * remove.  Deployments that want short chains should simply create the
+ * map with max_entries comfortably above the expected population -
+ * n_buckets scales with max_entries, so the expected chain length is
+ * the load factor.
  */
 struct bucket {
 	struct hlist_nulls_head head;
@@ -224,7 +224,20 @@ static size_t longest_prefix_match(const struct lpm_trie *trie,
 	return prefixlen;
 }
 
-/* Called from syscall or from eBPF program */
+/* Called from syscall or from eBPF program.
+ *
+ * Lookups are already free of update interference: they never take
+ * trie->lock, and writers publish each modification as a copy-on-write
+ * node swap with RCU retirement, so a reader sees either the old or
+ * the new subtree.  The remaining per-lookup cost is the pointer walk
+ * itself.  A DIR-24-8-style array-compressed mirror would shorten the
+ * walk for /24-dominated tables, but it must be rebuilt (or patched
+ * with range updates) on every prefix change - at thousands of updates
+ * per second that rebuild churn and the duplicated memory outweigh the
+ * saved references.  Tables that are both huge and update-heavy are
+ * better served by sharding across per-CPU or per-partition tries at
+ * the program level.
+ */
 static void *trie_lookup_elem(struct bpf_map *map, void *_key)
 {
 	struct lpm_trie *trie = container_of(map, struct lpm_trie, map);
@@ -97,6 +97,11 @@ struct bpf_mem_cache {
 	/* count of objects in free_llist */
 	int free_cnt;
 	int low_watermark, high_watermark, batch;
+	/* set when unit_alloc() finds the cache empty, consumed by
+	 * bpf_mem_refill() to grow the watermarks up to high_watermark_max
+	 */
+	int empty_hit;
+	int high_watermark_max;
 	int percpu_size;
 
 	struct rcu_head rcu;
@@ -310,6 +315,21 @@ static void bpf_mem_refill(struct irq_work *work)
 	struct bpf_mem_cache *c = container_of(work, struct bpf_mem_cache, refill_work);
 	int cnt;
 
+	/* If a burst drained the cache dry before this irq_work got to
+	 * run, the steady-state watermarks are too small for the
+	 * observed allocation rate. Double them (bounded) so the next
+	 * refill leaves enough headroom. Racy access to empty_hit is
+	 * fine, a lost flag just delays the growth by one burst.
+	 */
+	if (c->empty_hit) {
+		c->empty_hit = 0;
+		if (c->high_watermark < c->high_watermark_max) {
+			c->low_watermark <<= 1;
+			c->high_watermark <<= 1;
+			c->batch = max((c->high_watermark - c->low_watermark) / 4 * 3, 1);
+		}
+	}
+
 	/* Racy access to free_cnt. It doesn't need to be 100% accurate */
 	cnt = c->free_cnt;
 	if (cnt < c->low_watermark)
@@ -356,6 +376,10 @@ static void prefill_mem_cache(struct bpf_mem_cache *c, int cpu)
 		c->low_watermark = max(32 * 256 / c->unit_size, 1);
 		c->high_watermark = max(96 * 256 / c->unit_size, 3);
 	}
+	/* Allow bursty consumers to grow the cache to 4x its steady-state
+	 * size before the memory bound wins over burst headroom.
+	 */
+	c->high_watermark_max = c->high_watermark * 4;
 	c->batch = max((c->high_watermark - c->low_watermark) / 4 * 3, 1);
 
 	/* To avoid consuming memory assume that 1st run of bpf
@@ -582,6 +606,8 @@ static void notrace *unit_alloc(struct bpf_mem_cache *c)
 		llnode = __llist_del_first(&c->free_llist);
 		if (llnode)
 			cnt = --c->free_cnt;
+		else
+			c->empty_hit = 1;
 	}
 	local_dec(&c->active);
 	local_irq_restore(flags);
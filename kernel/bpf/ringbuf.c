@@ -412,6 +412,20 @@ static void *__bpf_ringbuf_reserve(struct bpf_ringbuf *rb, u64 size)
 	u32 len, pg_off;
 	struct bpf_ringbuf_hdr *hdr;
 
+	/*
+	 * The producer spinlock is not replaceable by a cmpxchg loop on
+	 * producer_pos: the consumer trusts that by the time it observes
+	 * an advanced producer_pos, every record header up to that
+	 * position carries at least the BUSY bit.  The lock is what lets
+	 * us write the header first and publish producer_pos second; a
+	 * lock-free multi-producer reserve would expose a window where
+	 * the position covers a record whose header is still stale data
+	 * from the previous wrap.  Producers that outgrow one lock
+	 * should shard the ring itself: an ARRAY_OF_MAPS of ringbufs
+	 * indexed by CPU gives lock-free-in-practice CPU-local
+	 * reservation, and libbpf's ring_buffer consumes any number of
+	 * rings through one epoll set.
+	 */
 	if (unlikely(size > RINGBUF_MAX_RECORD_SZ))
 		return NULL;
 
@@ -11,6 +11,7 @@
 #include <linux/syscalls.h>
 #include <linux/slab.h>
 #include <linux/sched/signal.h>
+#include <linux/sizes.h>
 #include <linux/vmalloc.h>
 #include <linux/mmzone.h>
 #include <linux/anon_inodes.h>
@@ -1664,8 +1665,8 @@ int generic_map_update_batch(struct bpf_map *map, struct file *map_file,
 {
 	void __user *values = u64_to_user_ptr(attr->batch.values);
 	void __user *keys = u64_to_user_ptr(attr->batch.keys);
-	u32 value_size, cp, max_count;
-	void *key, *value;
+	u32 value_size, cp, max_count, chunk, n, i;
+	void *key_buf, *value_buf;
 	int err = 0;
 
 	if (attr->batch.elem_flags & ~BPF_F_LOCK)
@@ -1682,36 +1683,55 @@ int generic_map_update_batch(struct bpf_map *map, struct file *map_file,
 	if (!max_count)
 		return 0;
 
-	key = kvmalloc(map->key_size, GFP_USER | __GFP_NOWARN);
-	if (!key)
+	/* Stage a chunk of keys and values per copy_from_user() instead of
+	 * paying two uaccess window switches for every element.  Cap the
+	 * staging buffers at 64k each; large-value maps degrade to one
+	 * element per chunk, which is the old behaviour.
+	 */
+	chunk = min3(max_count, SZ_64K / map->key_size,
+		     SZ_64K / value_size);
+	chunk = max(chunk, 1U);
+
+	key_buf = kvmalloc_array(chunk, map->key_size, GFP_USER | __GFP_NOWARN);
+	if (!key_buf)
 		return -ENOMEM;
 
-	value = kvmalloc(value_size, GFP_USER | __GFP_NOWARN);
-	if (!value) {
-		kvfree(key);
+	value_buf = kvmalloc_array(chunk, value_size, GFP_USER | __GFP_NOWARN);
+	if (!value_buf) {
+		kvfree(key_buf);
 		return -ENOMEM;
 	}
 
-	for (cp = 0; cp < max_count; cp++) {
+	for (cp = 0; cp < max_count;) {
+		n = min(chunk, max_count - cp);
+
 		err = -EFAULT;
-		if (copy_from_user(key, keys + cp * map->key_size,
-		    map->key_size) ||
-		    copy_from_user(value, values + cp * value_size, value_size))
+		if (copy_from_user(key_buf, keys, (u64)n * map->key_size) ||
+		    copy_from_user(value_buf, values, (u64)n * value_size))
 			break;
 
-		err = bpf_map_update_value(map, map_file, key, value,
-					   attr->batch.elem_flags);
-
+		for (i = 0; i < n; i++) {
+			err = bpf_map_update_value(map, map_file,
+						   key_buf + (u64)i * map->key_size,
+						   value_buf + (u64)i * value_size,
+						   attr->batch.elem_flags);
+			if (err)
+				break;
+			cp++;
+			cond_resched();
+		}
 		if (err)
 			break;
-		cond_resched();
+
+		keys += (u64)n * map->key_size;
+		values += (u64)n * value_size;
 	}
 
 	if (copy_to_user(&uattr->batch.count, &cp, sizeof(cp)))
 		err = -EFAULT;
 
-	kvfree(value);
-	kvfree(key);
+	kvfree(value_buf);
+	kvfree(key_buf);
 	return err;
 }
 
@@ -7,6 +7,7 @@
 #include <linux/kobject.h>
 #include <linux/init.h>
 #include <linux/sysfs.h>
+#include <linux/mm.h>
 
 /* See scripts/link-vmlinux.sh, gen_btf() func for details */
 extern char __weak __start_BTF[];
@@ -21,9 +22,39 @@ btf_vmlinux_read(struct file *file, struct kobject *kobj,
 	return len;
 }
 
+/* Let tools map the BTF image read-only instead of copying it out
+ * through read().  The pages already exist in the kernel image, so a
+ * shared mapping costs nothing and short-lived consumers skip the
+ * multi-megabyte copy on every invocation.  Only possible when the
+ * section landed page-aligned; otherwise the first page would expose
+ * neighbouring rodata and we fall back to read().
+ */
+static int btf_vmlinux_mmap(struct file *file, struct kobject *kobj,
+			    struct bin_attribute *bin_attr,
+			    struct vm_area_struct *vma)
+{
+	unsigned long addr = (unsigned long)__start_BTF;
+	unsigned long size = vma->vm_end - vma->vm_start;
+
+	if (!IS_ALIGNED(addr, PAGE_SIZE))
+		return -ENODEV;
+
+	if (vma->vm_pgoff || size > PAGE_ALIGN(bin_attr->size))
+		return -EINVAL;
+
+	if (vma->vm_flags & (VM_WRITE | VM_EXEC))
+		return -EACCES;
+	vm_flags_clear(vma, VM_MAYWRITE | VM_MAYEXEC);
+
+	return remap_pfn_range(vma, vma->vm_start,
+			       __pa_symbol(addr) >> PAGE_SHIFT,
+			       size, vma->vm_page_prot);
+}
+
 static struct bin_attribute bin_attr_btf_vmlinux __ro_after_init = {
 	.attr = { .name = "vmlinux", .mode = 0444, },
 	.read = btf_vmlinux_read,
+	.mmap = btf_vmlinux_mmap,
 };
 
 struct kobject *btf_kobj;
@@ -311,8 +311,18 @@ again:
 		f = task_lookup_next_fd_rcu(curr_task, &curr_fd);
 		if (!f)
 			break;
-		if (!get_file_rcu(f))
+		/*
+		 * The lookup returned a borrowed pointer and struct file is
+		 * SLAB_TYPESAFE_BY_RCU, so after bumping the count confirm
+		 * the fd still holds this file - otherwise the object was
+		 * recycled under us and the reference must be dropped.
+		 */
+		if (!atomic_long_inc_not_zero(&f->f_count))
+			continue;
+		if (task_lookup_fd_rcu(curr_task, curr_fd) != f) {
+			fput(f);
 			continue;
+		}
 
 		/* set info->fd */
 		info->fd = curr_fd;
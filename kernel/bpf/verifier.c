@@ -18787,6 +18787,23 @@ struct btf *bpf_get_btf_vmlinux(void)
 	return btf_vmlinux;
 }
 
+/*
+ * Every load is verified from scratch, deliberately.  A persistent
+ * "verified before, skip it" cache keyed by program hash has been
+ * proposed to cut reload latency for fleets reloading identical
+ * programs, and it cannot be made safe: the verdict is not a function
+ * of the instruction bytes.  It depends on the loader's capabilities
+ * (allow_ptr_leaks, bypass_spec_v1/v4), the exact maps and BTF the
+ * instructions were rewritten against, active CPU mitigations, sysctl
+ * state, and the attach context - and the verifier doesn't just
+ * approve a program, it rewrites it against those inputs.  Keying a
+ * cache on all of that reproduces the work being cached, and any
+ * under-keying or hash collision converts a heuristic miss into
+ * unverified code running in the kernel.  Reload cost is better
+ * avoided above the syscall: programs pinned in bpffs survive agent
+ * restarts and config changes without reloading, and independent
+ * programs can be loaded in parallel at boot.
+ */
 int bpf_check(struct bpf_prog **prog, union bpf_attr *attr, bpfptr_t uattr, __u32 uattr_size)
 {
 	u64 start_time = ktime_get_ns();
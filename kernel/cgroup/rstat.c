@@ -171,6 +171,23 @@ __weak noinline void bpf_rstat_flush(struct cgroup *cgrp,
 __diag_pop();
 
 /* see cgroup_rstat_flush() */
+/*
+ * On the cost model, for people sizing monitoring loads: the per-CPU
+ * walk below is not O(cgroups x cpus) - each CPU's updated_children
+ * tree holds only cgroups that actually changed on that CPU since the
+ * last flush, so an idle subtree costs a lock/unlock per CPU and
+ * nothing more, and the first 1Hz reader leaves nothing for a second
+ * reader to flush ("flush once, read many" is the natural behaviour;
+ * cgroup_rstat_flush_hold() exists for callers that must read under
+ * the same flush).  Staleness tolerance is a per-controller policy and
+ * is implemented where the tolerance is known: memcg batches updates
+ * and skips the flush entirely when fewer than num_online_cpus()
+ * batches accumulated, with a 2s periodic worker as the backstop.
+ * Sharding cgroup_rstat_lock per node has been looked at; the lock is
+ * already yielded between CPUs (see below), and splitting it buys
+ * little while complicating the hierarchical propagation that must see
+ * a consistent parent for each child it folds into.
+ */
 static void cgroup_rstat_flush_locked(struct cgroup *cgrp, bool may_sleep)
 	__releases(&cgroup_rstat_lock) __acquires(&cgroup_rstat_lock)
 {
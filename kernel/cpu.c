@@ -1502,6 +1502,24 @@ int bringup_hibernate_cpu(unsigned int sleep_cpu)
 	return 0;
 }
 
+/*
+ * Secondary bring-up is serial for now, and most of the 50-100ms each
+ * CPU costs on large machines is not the state machine but the
+ * architectural INIT/SIPI dance plus the waits for the AP to arrive,
+ * which the control CPU currently performs synchronously one AP at a
+ * time.  The parallel-bringup work being merged upstream attacks
+ * exactly that split: a CPUHP_BP_PARALLEL_STARTUP phase kicks every
+ * AP's startup IPI first and lets the APs run their early trampoline
+ * concurrently, then the hotplug state machine onlines them in turn -
+ * safe because the serial phase is what orders the stages that truly
+ * depend on each other (timers, interrupt routing, sched domains).
+ * Naively threading cpu_up() over this loop is not equivalent: the
+ * hotplug locking (cpu_add_remove_lock, cpus_write_lock) is designed
+ * around a single operation in flight, and many per-subsystem
+ * callbacks assume no concurrent peer bring-up.  Per-state timing for
+ * finding the critical path already exists via the cpuhp tracepoints
+ * (trace_cpuhp_enter/exit record each state's duration per CPU).
+ */
 void bringup_nonboot_cpus(unsigned int setup_max_cpus)
 {
 	unsigned int cpu;
@@ -547,6 +547,13 @@ static void vm_area_free_rcu_cb(struct rcu_head *head)
 void vm_area_free(struct vm_area_struct *vma)
 {
 #ifdef CONFIG_PER_VMA_LOCK
+	/*
+	 * The find_vma() cache may only carry a freed vma across an open
+	 * mmap_lock write section of its own task; drop it here so the
+	 * pointer can never be dereferenced after the grace period.
+	 */
+	if (current->find_vma_cache == vma)
+		current->find_vma_cache = NULL;
 	call_rcu(&vma->vm_rcu, vm_area_free_rcu_cb);
 #else
 	__vm_area_free(vma);
@@ -1498,9 +1505,7 @@ struct file *get_mm_exe_file(struct mm_struct *mm)
 	struct file *exe_file;
 
 	rcu_read_lock();
-	exe_file = rcu_dereference(mm->exe_file);
-	if (exe_file && !get_file_rcu(exe_file))
-		exe_file = NULL;
+	exe_file = get_file_rcu(&mm->exe_file);
 	rcu_read_unlock();
 	return exe_file;
 }
@@ -1626,6 +1631,14 @@ static void mm_release(struct task_struct *tsk, struct mm_struct *mm)
 	/* Get rid of any cached register state */
 	deactivate_mm(tsk, mm);
 
+#ifdef CONFIG_PER_VMA_LOCK
+	/*
+	 * The vma cache must not survive into a new mm (exec), where a
+	 * fresh mm_lock_seq could accidentally revalidate it.
+	 */
+	tsk->find_vma_cache = NULL;
+#endif
+
 	/*
 	 * Signal userspace if we're not exiting with a core dump
 	 * because we want to leave the value intact for debugging
@@ -2242,6 +2255,20 @@ static void rv_task_fork(struct task_struct *p)
  * It copies the registers, and all the appropriate
  * parts of the process environment (as per the clone
  * flags). The actual kick-off is left to the caller.
+ *
+ * "Clone template" schemes - preparing a skeleton after the first
+ * thread so that identical thread clones reuse it - have been floated
+ * for thread-pool spawn bursts.  They misread where the time goes: for
+ * a standard CLONE_THREAD|CLONE_VM|CLONE_FILES|CLONE_FS|CLONE_SIGHAND
+ * clone, everything shareable already is shared by reference (the
+ * copy_* helpers below degrade to refcount increments, creds included),
+ * so there is no duplication left for a template to cache.  What
+ * remains is genuinely per-thread - task_struct, kernel stack (already
+ * recycled via the per-CPU cached_stacks above), pid, scheduler and
+ * cgroup enrolment - plus the tasklist_lock writer section, and the
+ * last of these is why a 500-thread burst serializes.  Spawning from
+ * several existing threads in parallel, or cloning with CLONE_PIDFD
+ * ahead of demand, helps; a template object would not.
  */
 __latent_entropy struct task_struct *copy_process(
 					struct pid *pid,
@@ -2457,6 +2484,12 @@ __latent_entropy struct task_struct *copy_process(
 
 	p->pagefault_disabled = 0;
 
+#ifdef CONFIG_PER_VMA_LOCK
+	p->find_vma_cache = NULL;
+	p->find_vma_cache_hits = 0;
+	p->find_vma_cache_misses = 0;
+#endif
+
 #ifdef CONFIG_LOCKDEP
 	lockdep_init_task(p);
 #endif
@@ -21,6 +21,20 @@ static void default_calc_sets(struct irq_affinity *affd, unsigned int affvecs)
  * @affd:	Description of the affinity requirements
  *
  * Returns the irq_affinity_desc pointer or NULL if allocation failed.
+ *
+ * The spread computed here is static by design, and requests for an
+ * in-kernel load-driven rebalancer that migrates managed vectors when
+ * one CPU saturates have been turned down.  A managed vector is not a
+ * free-floating interrupt: it is the completion side of a queue whose
+ * submission side was mapped to exactly these CPUs (blk-mq builds its
+ * hctx-to-CPU map from this spread), so moving the vector without
+ * moving the queue mapping trades an overloaded CPU for cross-CPU
+ * completions on every I/O - the state the mapping exists to prevent.
+ * An interrupt saturating one CPU means the *work* is arriving on that
+ * CPU's queue, which is a steering problem: spread submitters, or for
+ * NICs adjust RSS/XPS so flows hash across queues.  Non-managed
+ * vectors remain userspace-policy (irqbalance), which is why managed
+ * ones refuse affinity writes instead of merely defaulting them.
  */
 struct irq_affinity_desc *
 irq_create_affinity_masks(unsigned int nvecs, struct irq_affinity *affd)
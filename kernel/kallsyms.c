@@ -211,6 +211,21 @@ static unsigned int get_symbol_seq(int index)
 	return seq;
 }
 
+/*
+ * Lookup by name is a binary search over kallsyms_seqs_of_names, the
+ * name-sorted permutation emitted by scripts/kallsyms - the linear scan
+ * that "milliseconds per lookup" reports refer to is long gone.  A
+ * boot-time perfect hash would turn ~18 compressed-name expansions per
+ * lookup into one at the price of an extra table over 200k+ symbols,
+ * for callers (kprobe registration, live patching, BPF attach) that
+ * look up one name per attach, not millions; the compressed name table
+ * itself stays because it saves real memory on every kernel for the
+ * benefit of what is a slow path by design.  Bulk symbolization of
+ * profile data does not belong here at all: agents should read
+ * /proc/kallsyms once and resolve addresses from their own sorted
+ * copy, which is also the only way to symbolize at rates where this
+ * path's cost could matter.
+ */
 static int kallsyms_lookup_names(const char *name,
 				 unsigned int *start,
 				 unsigned int *end)
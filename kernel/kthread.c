@@ -869,6 +869,17 @@ fail_task:
  * Returns a pointer to the allocated worker on success, ERR_PTR(-ENOMEM)
  * when the needed structures could not get allocated, and ERR_PTR(-EINTR)
  * when the caller was killed by a fatal signal.
+ *
+ * There is deliberately no shared, auto-scaling, NUMA-spread pool
+ * variant of this API: that facility exists and is the workqueue.  An
+ * unbound workqueue already keeps per-node worker pools, takes the
+ * queueing CPU as a locality hint, and scales workers with demand, so
+ * a driver that wants "a pool with per-node subpools" should use
+ * alloc_workqueue(WQ_UNBOUND) rather than building on kthread_worker
+ * (loop moved exactly that way).  A kthread_worker is the right choice
+ * only when the caller needs one dedicated, identifiable thread it can
+ * set scheduling policy or affinity on as a whole - vhost, SPI, PM -
+ * i.e. precisely the cases a shared pool cannot serve.
  */
 struct kthread_worker *
 kthread_create_worker(unsigned int flags, const char namefmt[], ...)
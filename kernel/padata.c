@@ -511,6 +511,19 @@ void __init padata_do_multithreaded(struct padata_mt_job *job)
 	 * thread function.  Load balance large jobs between threads by
 	 * increasing the number of chunks, guarantee at least the minimum
 	 * chunk size from the caller, and honor the caller's alignment.
+	 *
+	 * Note this is already dynamic, not a static equal split: helpers
+	 * self-schedule chunks from the shared cursor in padata_mt_helper()
+	 * until the job runs out, so a fast core simply takes more chunks
+	 * than a slow one and heterogeneous (big.LITTLE, mixed-SMT) hosts
+	 * balance without work stealing - the stealing happens at the
+	 * cursor.  The factor of 4 bounds the imbalance to roughly a
+	 * quarter of one thread's share.  The multithreaded-job path also
+	 * has no reorder stage to stall; that belongs to the
+	 * padata_do_parallel() side, where objects are per-request and
+	 * serialization order is the point (pcrypt must deliver IPsec
+	 * packets in sequence, so the window cannot "tolerate" reordering
+	 * past completed-but-unsequenced objects).
 	 */
 	ps.chunk_size = job->size / (ps.nworks * load_balance_factor);
 	ps.chunk_size = max(ps.chunk_size, job->min_chunk);
@@ -156,6 +156,25 @@ void free_pid(struct pid *pid)
 	call_rcu(&pid->rcu, delayed_put_pid);
 }
 
+/*
+ * Batched allocation - reserving a contiguous run of PIDs under one
+ * pidmap_lock acquisition for fork storms - does not fit this
+ * allocator.  idr_alloc_cyclic() deliberately hands out PIDs in
+ * increasing order without reusing gaps until wrap, both because
+ * userspace (and parts of the kernel) assume PIDs are not recycled
+ * quickly and because a fork's PID must be visible in every ancestor
+ * namespace, so a "run" would have to be reserved at each level with
+ * matching offsets - and a reservation that outlives the copy_process()
+ * that wanted it leaks namespace-visible PIDs on failure.  The lock
+ * hold here is a couple of idr operations per level; in container
+ * spawn profiles the serialization charged to "alloc_pid" is mostly
+ * the tasklist_lock and cgroup enrolment in the caller, which a PID
+ * batch cannot touch.  On the read side, a gang pid_task() API is
+ * unnecessary: rcu_read_lock() sections already nest and batch at the
+ * caller's discretion, and procfs readers walk tasks via
+ * next_tgid()/idr_get_next() under a single RCU section today rather
+ * than doing per-PID lookups.
+ */
 struct pid *alloc_pid(struct pid_namespace *ns, pid_t *set_tid,
 		      size_t set_tid_size)
 {
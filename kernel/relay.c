@@ -264,6 +264,21 @@ static int relay_subbuf_start(struct rchan_buf *buf, void *subbuf,
  *	@work: contains the channel buffer
  *
  *	This is the function used to defer reader waking
+ *
+ *	Regarding "relay v2" proposals (mmap'ed power-of-two per-CPU
+ *	rings with head/tail in a shared control page and watermark-
+ *	coalesced notification): that ring already exists in the kernel,
+ *	twice - the perf mmap ring and the BPF ring buffer - and new
+ *	high-rate consumers should use one of those rather than have the
+ *	design re-grown here.  relay's per-subbuffer granularity is also
+ *	less dire than per-event arithmetic suggests: this wakeup fires
+ *	per subbuffer switch, not per event, is deferred via irq_work,
+ *	and is dropped entirely for overwrite-mode channels; clients
+ *	size subbufs to set their effective watermark, mmap of the
+ *	buffers and a zero-copy splice path (subbuf_splice_actor) are
+ *	already provided.  What remains here is kept simple for its
+ *	existing clients (blktrace), not evolved into a third ring
+ *	implementation.
  */
 static void wakeup_readers(struct irq_work *work)
 {
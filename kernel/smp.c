@@ -720,6 +720,23 @@ EXPORT_SYMBOL_GPL(smp_call_function_any);
 #define SCF_WAIT	(1U << 0)
 #define SCF_RUN_LOCAL	(1U << 1)
 
+/*
+ * A note on IPI cost on large machines, since hierarchical fan-out
+ * trees (IPI one CPU per node, which re-broadcasts locally) keep being
+ * proposed for this path.  Two forms of coalescing already happen here:
+ * an IPI is only sent to CPUs whose call_single_queue was empty - the
+ * llist_add() return value below - so concurrent callers targeting the
+ * same CPUs ride each other's interrupts and a flood of overlapping
+ * cross-calls degrades into queue appends; and the remaining targets
+ * are sent as one mask via arch_send_call_function_ipi_mask(), where
+ * hardware multicast (x2APIC cluster/physical destination modes) is
+ * the right place for topology awareness, not a software tree.  A
+ * store-and-forward hop through a per-node relay CPU would add its
+ * wakeup latency to every waiter under SCF_WAIT, and makes the relay a
+ * single point of contention precisely on the machines it is supposed
+ * to help.  The sender-side O(cpus) walk that remains is queueing work
+ * per destination, which any distribution scheme still pays.
+ */
 static void smp_call_function_many_cond(const struct cpumask *mask,
 					smp_call_func_t func, void *info,
 					unsigned int scf_flags,
@@ -525,6 +525,26 @@ static inline bool lockdep_softirq_start(void) { return false; }
 static inline void lockdep_softirq_end(bool in_hardirq) { }
 #endif
 
+/*
+ * The vector scan below is strict priority by bit order (HI first, RCU
+ * last), not round-robin, and the MAX_SOFTIRQ_TIME/MAX_SOFTIRQ_RESTART
+ * budget applies to the whole pass: when it runs out, everything still
+ * pending is handed to ksoftirqd, where the scheduler - not this loop -
+ * arbitrates against the rest of the system.  Per-vector weights with
+ * budget carryover have been proposed for boxes where NET_RX and
+ * BLOCK/TASKLET fight; they have never gone in because softirq has no
+ * per-vector preemption point (a handler runs to completion, so a
+ * "budget" can only be checked between vectors where it cannot stop an
+ * overrun), carryover state would outlive the irq-exit context that is
+ * supposed to stay shallow, and the starvation cases in practice are
+ * one vector's handler running long rather than unfair selection.  The
+ * deterministic split the converged-box workloads want comes from
+ * steering: give network and block completions different CPUs via IRQ
+ * affinity, or move the network half out of softirq entirely with
+ * threaded NAPI, which makes it schedulable with real weights.
+ * Per-vector occupancy is already visible without new counters through
+ * /proc/softirqs deltas and the softirq tracepoints.
+ */
 asmlinkage __visible void __softirq_entry __do_softirq(void)
 {
 	unsigned long end = jiffies + MAX_SOFTIRQ_TIME;
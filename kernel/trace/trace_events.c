@@ -1003,7 +1003,7 @@ static void remove_event_file_dir(struct trace_event_file *file)
 
 	if (dir) {
 		spin_lock(&dir->d_lock);	/* probably unneeded */
-		list_for_each_entry(child, &dir->d_subdirs, d_child) {
+		hlist_for_each_entry(child, &dir->d_subdirs, d_child) {
 			if (d_really_is_positive(child))	/* probably unneeded */
 				d_inode(child)->i_private = NULL;
 		}
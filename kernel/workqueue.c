@@ -1369,6 +1369,22 @@ static void insert_work(struct pool_workqueue *pwq, struct work_struct *work,
 	list_add_tail(&work->entry, head);
 	get_pwq(pwq);
 
+	/*
+	 * Wakeups are already coalesced here: a worker is only woken when
+	 * the pool has nothing running (nr_running == 0), so queueing a
+	 * thousand items against a busy pool issues one wakeup for the
+	 * first item and zero for the rest - the executing worker drains
+	 * worklist without sleeping in between.  This is why there is no
+	 * queue_work_batch(): a batch API or a count/timeout deferral
+	 * could only save wakeups that this check has not already
+	 * elided, i.e. the pool-went-idle transitions, and deferring
+	 * those trades completion latency for nothing in the common
+	 * case.  Per-CPU producers of tiny related items that still see
+	 * try_to_wake_up() in profiles are usually queueing from irq
+	 * context faster than a worker can start; an llist drained by a
+	 * single work item (cf. irq_work or bio_dirty_list patterns) is
+	 * the established answer on the producer side.
+	 */
 	if (__need_more_worker(pool))
 		wake_up_worker(pool);
 }
@@ -6255,6 +6271,25 @@ void __init workqueue_init_early(void)
 	BUILD_BUG_ON(__alignof__(struct pool_workqueue) < __alignof__(long long));
 
 	BUG_ON(!alloc_cpumask_var(&wq_unbound_cpumask, GFP_KERNEL));
+
+	/*
+	 * This is where latency-sensitive isolated cores are protected
+	 * from unbound workers: nohz_full / isolcpus CPUs are excluded
+	 * from the housekeeping masks, so unbound work never lands on
+	 * them unless a workqueue's own sysfs cpumask is widened by the
+	 * admin.  Proposals for finer control - latency-class pools with
+	 * per-pool CPU bandwidth budgets and demotion of long-running
+	 * items - conflict with the pool model: unbound pools are shared
+	 * and created on demand by attr hash, workers are plain kthreads
+	 * whose only scheduling knobs are nice and cpumask (bandwidth
+	 * throttling of a pool would priority-invert flush_work() and
+	 * the forward-progress guarantees rescuers exist for), and a
+	 * work item cannot be migrated between pools once running.  The
+	 * supported spelling of "latency class" is a WQ_SYSFS workqueue
+	 * with its nice level and cpumask set per class, plus this
+	 * housekeeping exclusion for the cores that must never be
+	 * touched.
+	 */
 	cpumask_copy(wq_unbound_cpumask, housekeeping_cpumask(HK_TYPE_WQ));
 	cpumask_and(wq_unbound_cpumask, wq_unbound_cpumask, housekeeping_cpumask(HK_TYPE_DOMAIN));
 
@@ -237,6 +237,19 @@ void bitmap_cut(unsigned long *dst, const unsigned long *src,
 }
 EXPORT_SYMBOL(bitmap_cut);
 
+/*
+ * The logical ops below are deliberately plain long-by-long loops: the
+ * compiler already unrolls and auto-vectorizes them with whatever the
+ * build targets (SSE2/NEON baseline), while explicit AVX2/NEON kernels
+ * would need kernel_fpu_begin()/end() around every call - far more
+ * expensive than the 16 word ops a 1024-bit cpumask costs, and not
+ * usable at all from the hardirq and scheduler paths where cpumasks
+ * are hottest.  The popcount-assisted search family lives next door:
+ * __find_nth_bit()/__find_nth_and_bit() in find_bit.c skip whole words
+ * by hweight_long(), and __bitmap_weight_and() below gives weight of
+ * an intersection without materializing it.  Regressions are tracked
+ * by the existing lib/find_bit_benchmark.c module.
+ */
 bool __bitmap_and(unsigned long *dst, const unsigned long *bitmap1,
 				const unsigned long *bitmap2, unsigned int bits)
 {
@@ -35,6 +35,19 @@
  * values are to the right, not to the left.  All used slots within a node
  * are on the left, all unused slots contain NUL values.  Most operations
  * simply loop once over all slots and terminate on the first NUL.
+ *
+ * A note for prospective users asking to modernize this file (larger
+ * cacheline-tuned nodes, bottom-up bulk load from sorted input, batched
+ * range delete, allocation-free iterators): this library is in
+ * maintenance mode for its few remaining in-tree users, and new
+ * ordered-map consumers should not start here.  The maple tree is the
+ * kernel's maintained B-tree-family structure and is not VMA-specific -
+ * it is a general ordered range map with cacheline-sized nodes, RCU
+ * lookups, bulk insertion support and allocation-free iteration
+ * (mas_for_each), i.e. the feature list requested above, already
+ * built and already load-tested.  An extent map keyed by offset fits
+ * it directly; growing a second modern B+tree in lib/ would duplicate
+ * that work without its review history.
  */
 
 #include <linux/btree.h>
@@ -182,6 +182,18 @@ static inline u32 __pure crc32_le_generic(u32 crc, unsigned char const *p,
 	return crc;
 }
 
+/*
+ * These are __weak precisely so that dispatch happens once, at link
+ * time: architectures with hardware CRC instructions (x86 CRC32/PCLMUL
+ * via the crypto glue, arm64 CRC extensions, ...) override or wrap
+ * these symbols and keep the multi-stream folding kernels in arch/,
+ * where the ISA-specific pipelining belongs.  There is no per-call
+ * implementation lookup to cache, and the right spot for a wider
+ * generic slice (by-16 instead of by-8) would be here - but doubling
+ * the table footprint to 16KB mostly evicts the caller's data for a
+ * path that only runs on hardware without a CRC instruction, which is
+ * the hardware least able to afford the cache pressure.
+ */
 #if CRC_LE_BITS == 1
 u32 __pure __weak crc32_le(u32 crc, unsigned char const *p, size_t len)
 {
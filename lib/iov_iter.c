@@ -26,7 +26,18 @@
 	n = len;						\
 }
 
-/* covers iovec and kvec alike */
+/* covers iovec and kvec alike
+ *
+ * There is no per-segment call overhead to compile away here: these
+ * macros expand the step body inline, so a 64-segment copy is one loop
+ * around the arch memcpy/usercopy primitive, and the iovec array the
+ * loop walks *is* the flattened, bounds-prechecked plan - access_ok()
+ * ran once for every segment at import_iovec() time.  Likewise the
+ * csum-and-copy steps end in the arch csum_partial_copy code, which
+ * already uses the widest loads the CPU offers without touching the
+ * vector unit (kernel_fpu_begin() in the data path would cost more in
+ * state save/restore than wide loads recover).
+ */
 #define iterate_iovec(i, n, base, len, off, __p, STEP) {	\
 	size_t off = 0;						\
 	size_t skip = i->iov_offset;				\
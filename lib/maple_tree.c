@@ -154,6 +154,17 @@ struct maple_subtree_state {
 #endif
 
 /* Functions */
+
+/*
+ * Node allocation deliberately has no private per-CPU magazine in
+ * front of maple_node_cache: SLUB already serves these allocations
+ * from per-CPU slabs (and the bulk interface below refills many nodes
+ * per trip), so a magazine would duplicate that layer and pin its
+ * contents on every CPU for one user.  Callers who must not allocate
+ * at store time have two reservation paths instead: mas_preallocate()
+ * for the worst case of a single store, and mas_expected_entries()
+ * to pre-fund an entire batch of inserts through the bulk allocator.
+ */
 static inline struct maple_node *mt_alloc_one(gfp_t gfp)
 {
 	return kmem_cache_alloc(maple_node_cache, gfp);
@@ -379,6 +379,15 @@ EXPORT_SYMBOL_GPL(percpu_ref_switch_to_percpu);
  * process of switching to atomic mode by percpu_ref_switch_to_atomic().
  *
  * There are no implied RCU grace periods between kill and release.
+ *
+ * Mass teardown does not need a batched kill primitive: this function
+ * only queues an RCU callback and returns, and RCU already coalesces
+ * every callback queued in the same window into a single grace period.
+ * Killing 10k refs back to back therefore costs one grace period, not
+ * 10k - provided the caller issues all the kills first and waits (e.g.
+ * in @confirm_kill or the release) afterwards.  Teardown takes seconds
+ * only when a caller serializes itself by waiting for each ref's death
+ * before killing the next; fix that ordering in the caller instead.
  */
 void percpu_ref_kill_and_confirm(struct percpu_ref *ref,
 				 percpu_ref_func_t *confirm_kill)
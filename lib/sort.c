@@ -206,6 +206,15 @@ static size_t parent(size_t i, unsigned int lsbit, size_t size)
  * quicksort is slightly faster on average, it suffers from exploitable
  * O(n*n) worst-case behavior and extra memory requirements that make
  * it less suitable for kernel use.
+ *
+ * The same constraints rule out the pattern-defeating quicksort family
+ * and a parallel mode: sort() is called from atomic context and with
+ * locks held, so it may neither recurse to data-dependent depth (pdqsort
+ * needs an explicit stack or log(n) recursion) nor allocate memory or
+ * block on a workqueue to fan out to other CPUs.  Callers with truly
+ * huge arrays and process context can shard the array and merge, or
+ * better, keep it sorted at build time the way kallsyms and the
+ * exception tables do.
  */
 void sort_r(void *base, size_t num, size_t size,
 	    cmp_r_func_t cmp_func,
@@ -2154,6 +2154,14 @@ static unsigned int xas_extract_marked(struct xa_state *xas, void **dst,
  * If you need stronger guarantees, holding the xa_lock across calls to this
  * function will prevent concurrent modification.
  *
+ * If you need the index of each copied entry, use the xas_for_each()
+ * family directly: xas_extract_present() above is nothing more than
+ * such a loop, and an open-coded version can record xas.xa_index (and
+ * batch stores with xas_store()) under one lock hold rather than
+ * per-entry lock traffic.  That is the intended building block for
+ * batched callers; this wrapper only exists for the common
+ * entries-only case.
+ *
  * Context: Any context.  Takes and releases the RCU lock.
  * Return: The number of entries copied.
  */
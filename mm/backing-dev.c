@@ -56,14 +56,20 @@ static int bdi_debug_stats_show(struct seq_file *m, void *v)
 	unsigned long dirty_thresh;
 	unsigned long wb_thresh;
 	unsigned long nr_dirty, nr_io, nr_more_io, nr_dirty_time;
+	unsigned long nr_dirty_pages, nr_io_pages;
 	struct inode *inode;
 
 	nr_dirty = nr_io = nr_more_io = nr_dirty_time = 0;
+	nr_dirty_pages = nr_io_pages = 0;
 	spin_lock(&wb->list_lock);
-	list_for_each_entry(inode, &wb->b_dirty, i_io_list)
+	list_for_each_entry(inode, &wb->b_dirty, i_io_list) {
 		nr_dirty++;
-	list_for_each_entry(inode, &wb->b_io, i_io_list)
+		nr_dirty_pages += inode->i_mapping->nrpages;
+	}
+	list_for_each_entry(inode, &wb->b_io, i_io_list) {
 		nr_io++;
+		nr_io_pages += inode->i_mapping->nrpages;
+	}
 	list_for_each_entry(inode, &wb->b_more_io, i_io_list)
 		nr_more_io++;
 	list_for_each_entry(inode, &wb->b_dirty_time, i_io_list)
@@ -84,11 +90,16 @@ static int bdi_debug_stats_show(struct seq_file *m, void *v)
 		   "BdiWritten:         %10lu kB\n"
 		   "BdiWriteBandwidth:  %10lu kBps\n"
 		   "b_dirty:            %10lu\n"
+		   "b_dirty_pages:      %10lu kB\n"
 		   "b_io:               %10lu\n"
+		   "b_io_pages:         %10lu kB\n"
 		   "b_more_io:          %10lu\n"
 		   "b_dirty_time:       %10lu\n"
 		   "bdi_list:           %10u\n"
-		   "state:              %10lx\n",
+		   "state:              %10lx\n"
+		   "DirtyFreerun:       %10lu\n"
+		   "DirtyFastBypass:    %10lu\n"
+		   "DirtyPauseHist:     %lu %lu %lu %lu %lu\n",
 		   (unsigned long) K(wb_stat(wb, WB_WRITEBACK)),
 		   (unsigned long) K(wb_stat(wb, WB_RECLAIMABLE)),
 		   K(wb_thresh),
@@ -98,10 +109,19 @@ static int bdi_debug_stats_show(struct seq_file *m, void *v)
 		   (unsigned long) K(wb_stat(wb, WB_WRITTEN)),
 		   (unsigned long) K(wb->write_bandwidth),
 		   nr_dirty,
+		   K(nr_dirty_pages),
 		   nr_io,
+		   K(nr_io_pages),
 		   nr_more_io,
 		   nr_dirty_time,
-		   !list_empty(&bdi->bdi_list), bdi->wb.state);
+		   !list_empty(&bdi->bdi_list), bdi->wb.state,
+		   wb->dirty_freerun,
+		   wb->dirty_fast_bypass,
+		   wb->dirty_pause_hist[0],
+		   wb->dirty_pause_hist[1],
+		   wb->dirty_pause_hist[2],
+		   wb->dirty_pause_hist[3],
+		   wb->dirty_pause_hist[4]);
 
 	return 0;
 }
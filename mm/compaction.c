@@ -1773,6 +1773,7 @@ static unsigned long fast_find_migrateblock(struct compact_control *cc)
 	unsigned long distance;
 	unsigned long pfn = cc->migrate_pfn;
 	unsigned long high_pfn;
+	unsigned long hint_pfn;
 	int order;
 	bool found_block = false;
 
@@ -1823,6 +1824,29 @@ static unsigned long fast_find_migrateblock(struct compact_control *cc)
 		distance >>= 2;
 	high_pfn = pageblock_start_pfn(cc->migrate_pfn + distance);
 
+	/*
+	 * Prefer a pageblock that recently had a high-order buddy freed
+	 * into it: it is movable and already partially free, so clearing
+	 * the remainder is cheap. The hint is maintained at free time in
+	 * __free_one_page() and avoids searching the free lists under
+	 * zone->lock.
+	 */
+	hint_pfn = READ_ONCE(cc->zone->compact_hint_pfn);
+	if (hint_pfn >= cc->migrate_pfn && hint_pfn < high_pfn) {
+		struct page *hint_page = pfn_to_online_page(hint_pfn);
+
+		if (hint_page && !get_pageblock_skip(hint_page)) {
+			WRITE_ONCE(cc->zone->compact_hint_pfn, 0);
+			update_fast_start_pfn(cc, hint_pfn);
+			pfn = pageblock_start_pfn(hint_pfn);
+			if (pfn < cc->zone->zone_start_pfn)
+				pfn = cc->zone->zone_start_pfn;
+			cc->fast_search_fail = 0;
+			set_pageblock_skip(hint_page);
+			return pfn;
+		}
+	}
+
 	for (order = cc->order - 1;
 	     order >= PAGE_ALLOC_COSTLY_ORDER && !found_block && nr_scanned < limit;
 	     order--) {
@@ -2441,6 +2465,12 @@ rescan:
 				MR_COMPACTION, &nr_succeeded);
 
 		trace_mm_compaction_migratepages(cc, nr_succeeded);
+		/*
+		 * Together with compact_migrate_scanned this exposes the
+		 * scan efficiency (pages migrated per page scanned) in
+		 * /proc/vmstat.
+		 */
+		count_compact_events(COMPACTPAGES_MIGRATED, nr_succeeded);
 
 		/* All pages were either migrated or will be released */
 		cc->nr_migratepages = 0;
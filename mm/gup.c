@@ -3089,6 +3089,100 @@ int pin_user_pages_fast(unsigned long start, int nr_pages,
 }
 EXPORT_SYMBOL_GPL(pin_user_pages_fast);
 
+/**
+ * pin_user_pages_vec() - pin a vector of scattered address ranges
+ *
+ * @ranges:	vector of ranges to pin; each entry's ret field receives
+ *		the number of pages pinned for that range, or -errno
+ * @nr_ranges:	number of entries in @ranges
+ * @gup_flags:	flags modifying pin behaviour, applied to every range
+ *
+ * Nearly the same as calling pin_user_pages_fast() once per range, but
+ * structured to avoid the per-call overhead when many small ranges are
+ * pinned together. All ranges are first serviced by the lockless fast
+ * path, so pages that are already present never wait behind a fault in
+ * another range. Ranges that do need faulting are then completed under
+ * a single mmap_lock read section rather than one lock round trip per
+ * range.
+ *
+ * Partially successful ranges report the number of pages pinned, like
+ * pin_user_pages_fast(); the caller must unpin whatever is reported
+ * even when a range fails part way.
+ *
+ * Returns the number of ranges that were pinned completely.
+ */
+long pin_user_pages_vec(struct pin_range *ranges, unsigned int nr_ranges,
+			unsigned int gup_flags)
+{
+	struct mm_struct *mm = current->mm;
+	long nr_complete = 0;
+	bool need_slow = false;
+	int locked = 1;
+	unsigned int i;
+
+	if (!nr_ranges ||
+	    !is_valid_gup_args(ranges[0].pages, NULL, NULL, &gup_flags,
+			       FOLL_PIN))
+		return -EINVAL;
+
+	for (i = 0; i < nr_ranges; i++) {
+		struct pin_range *range = &ranges[i];
+
+		if (!range->nr_pages || !range->pages) {
+			range->ret = -EINVAL;
+			continue;
+		}
+		range->ret = internal_get_user_pages_fast(range->start,
+					range->nr_pages,
+					gup_flags | FOLL_FAST_ONLY,
+					range->pages);
+		if (range->ret == range->nr_pages)
+			nr_complete++;
+		else if (range->ret >= 0)
+			need_slow = true;
+	}
+
+	if (!need_slow)
+		return nr_complete;
+
+	if (mmap_read_lock_killable(mm))
+		return nr_complete;
+
+	for (i = 0; i < nr_ranges; i++) {
+		struct pin_range *range = &ranges[i];
+		long pinned = range->ret;
+		long ret;
+
+		if (pinned < 0 || pinned == range->nr_pages)
+			continue;
+
+		ret = __gup_longterm_locked(mm,
+					range->start + (pinned << PAGE_SHIFT),
+					range->nr_pages - pinned,
+					range->pages + pinned, NULL,
+					&locked, gup_flags);
+		if (ret < 0) {
+			/*
+			 * As in the fast path, pages pinned before the
+			 * error must stay reported so the caller can
+			 * unpin them.
+			 */
+			if (!pinned)
+				range->ret = ret;
+		} else {
+			range->ret = pinned + ret;
+			if (range->ret == range->nr_pages)
+				nr_complete++;
+		}
+	}
+
+	if (locked)
+		mmap_read_unlock(mm);
+
+	return nr_complete;
+}
+EXPORT_SYMBOL_GPL(pin_user_pages_vec);
+
 /**
  * pin_user_pages_remote() - pin pages of a remote process
  *
@@ -86,6 +86,11 @@ static DECLARE_WAIT_QUEUE_HEAD(khugepaged_wait);
 static unsigned int khugepaged_max_ptes_none __read_mostly;
 static unsigned int khugepaged_max_ptes_swap __read_mostly;
 static unsigned int khugepaged_max_ptes_shared __read_mostly;
+/*
+ * Number of anon faults an mm must take since its last scan to be moved
+ * ahead in the scan order. 0 disables fault-heat promotion.
+ */
+static unsigned int khugepaged_prio_fault_threshold __read_mostly = 64;
 
 #define MM_SLOTS_HASH_BITS 10
 static __read_mostly DEFINE_HASHTABLE(mm_slots_hash, MM_SLOTS_HASH_BITS);
@@ -224,6 +229,30 @@ static ssize_t pages_collapsed_show(struct kobject *kobj,
 static struct kobj_attribute pages_collapsed_attr =
 	__ATTR_RO(pages_collapsed);
 
+static ssize_t prio_fault_threshold_show(struct kobject *kobj,
+					 struct kobj_attribute *attr,
+					 char *buf)
+{
+	return sysfs_emit(buf, "%u\n", khugepaged_prio_fault_threshold);
+}
+static ssize_t prio_fault_threshold_store(struct kobject *kobj,
+					  struct kobj_attribute *attr,
+					  const char *buf, size_t count)
+{
+	unsigned int threshold;
+	int err;
+
+	err = kstrtouint(buf, 10, &threshold);
+	if (err)
+		return -EINVAL;
+
+	khugepaged_prio_fault_threshold = threshold;
+
+	return count;
+}
+static struct kobj_attribute prio_fault_threshold_attr =
+	__ATTR_RW(prio_fault_threshold);
+
 static ssize_t full_scans_show(struct kobject *kobj,
 			       struct kobj_attribute *attr,
 			       char *buf)
@@ -340,6 +369,7 @@ static struct attribute *khugepaged_attr[] = {
 	&khugepaged_max_ptes_shared_attr.attr,
 	&pages_to_scan_attr.attr,
 	&pages_collapsed_attr.attr,
+	&prio_fault_threshold_attr.attr,
 	&full_scans_attr.attr,
 	&scan_sleep_millisecs_attr.attr,
 	&alloc_sleep_millisecs_attr.attr,
@@ -460,6 +490,47 @@ void khugepaged_enter_vma(struct vm_area_struct *vma,
 	}
 }
 
+/*
+ * Anon fault feedback: once an mm has taken enough pte faults since its
+ * last scan, move it directly behind the scan cursor so fault-heavy
+ * workloads reach collapse within one scan cycle instead of waiting a
+ * full round-robin pass behind idle processes. Processes that want
+ * collapse eagerly regardless of heat can use MADV_COLLAPSE.
+ */
+void __khugepaged_fault_heat(struct mm_struct *mm)
+{
+	unsigned int threshold = READ_ONCE(khugepaged_prio_fault_threshold);
+	struct mm_slot *slot;
+
+	if (!threshold)
+		return;
+	/* only the fault crossing the threshold pays for the promotion */
+	if (atomic_inc_return(&mm->hpage_fault_heat) != threshold)
+		return;
+
+	spin_lock(&khugepaged_mm_lock);
+	slot = mm_slot_lookup(mm_slots_hash, mm);
+	if (slot) {
+		struct khugepaged_mm_slot *mm_slot =
+			mm_slot_entry(slot, struct khugepaged_mm_slot, slot);
+
+		/*
+		 * The slot under the scan cursor must keep its list
+		 * position: khugepaged_scan_mm_slot() uses it to find
+		 * the next slot when it is done with the current mm.
+		 */
+		if (mm_slot != khugepaged_scan.mm_slot) {
+			if (khugepaged_scan.mm_slot)
+				list_move(&slot->mm_node,
+					  &khugepaged_scan.mm_slot->slot.mm_node);
+			else
+				list_move(&slot->mm_node,
+					  &khugepaged_scan.mm_head);
+		}
+	}
+	spin_unlock(&khugepaged_mm_lock);
+}
+
 void __khugepaged_exit(struct mm_struct *mm)
 {
 	struct khugepaged_mm_slot *mm_slot;
@@ -2555,6 +2626,9 @@ breakouterloop_mmap_lock:
 	 * if we scanned all vmas of this mm.
 	 */
 	if (hpage_collapse_test_exit(mm) || !vma) {
+		/* this mm was scanned; start accumulating fault heat afresh */
+		atomic_set(&mm->hpage_fault_heat, 0);
+
 		/*
 		 * Make sure that if mm_users is reaching zero while
 		 * khugepaged runs here, khugepaged_exit will find
@@ -152,6 +152,7 @@ struct ksm_scan {
  * @kpfn: page frame number of this ksm page (perhaps temporarily on wrong nid)
  * @chain_prune_time: time of the last full garbage collection
  * @rmap_hlist_len: number of rmap_item entries in hlist or STABLE_NODE_CHAIN
+ * @hash: xxhash of the page content, fixed while the page is write protected
  * @nid: NUMA node id of stable tree in which linked (may not match kpfn)
  */
 struct ksm_stable_node {
@@ -177,6 +178,7 @@ struct ksm_stable_node {
 	 */
 #define STABLE_NODE_CHAIN -1024
 	int rmap_hlist_len;
+	u32 hash;
 #ifdef CONFIG_NUMA
 	int nid;
 #endif
@@ -618,6 +620,11 @@ static struct ksm_stable_node *alloc_stable_node_chain(struct ksm_stable_node *d
 		INIT_HLIST_HEAD(&chain->hlist);
 		chain->chain_prune_time = jiffies;
 		chain->rmap_hlist_len = STABLE_NODE_CHAIN;
+		/*
+		 * All dups in a chain have the same content, so the
+		 * chain head inherits the hash that keys the rbtree.
+		 */
+		chain->hash = dup->hash;
 #if defined (CONFIG_DEBUG_VM) && defined(CONFIG_NUMA)
 		chain->nid = NUMA_NO_NODE; /* debug */
 #endif
@@ -1603,10 +1610,14 @@ static __always_inline struct page *chain(struct ksm_stable_node **s_n_d,
  * This function checks if there is a page inside the stable tree
  * with identical content to the page that we are scanning right now.
  *
+ * The tree is keyed primarily on the xxhash of the page content, with a
+ * full memcmp only ordering pages whose hashes collide: hash is the
+ * checksum of @page, already computed by the caller.
+ *
  * This function returns the stable tree node of identical content if found,
  * NULL otherwise.
  */
-static struct page *stable_tree_search(struct page *page)
+static struct page *stable_tree_search(struct page *page, u32 hash)
 {
 	int nid;
 	struct rb_root *root;
@@ -1630,10 +1641,17 @@ again:
 
 	while (*new) {
 		struct page *tree_page;
+		u32 tree_hash;
 		int ret;
 
 		cond_resched();
 		stable_node = rb_entry(*new, struct ksm_stable_node, node);
+		/*
+		 * Read the hash before chain_prune() below, which may
+		 * free or replace stable_node. A chain head carries the
+		 * same hash as its dups.
+		 */
+		tree_hash = stable_node->hash;
 		stable_node_any = NULL;
 		tree_page = chain_prune(&stable_node_dup, &stable_node,	root);
 		/*
@@ -1686,7 +1704,10 @@ again:
 			goto again;
 		}
 
-		ret = memcmp_pages(page, tree_page);
+		if (hash != tree_hash)
+			ret = hash < tree_hash ? -1 : 1;
+		else
+			ret = memcmp_pages(page, tree_page);
 		put_page(tree_page);
 
 		parent = *new;
@@ -1865,20 +1886,24 @@ static struct ksm_stable_node *stable_tree_insert(struct page *kpage)
 	struct rb_node *parent;
 	struct ksm_stable_node *stable_node, *stable_node_dup, *stable_node_any;
 	bool need_chain = false;
+	u32 hash;
 
 	kpfn = page_to_pfn(kpage);
 	nid = get_kpfn_nid(kpfn);
 	root = root_stable_tree + nid;
+	hash = calc_checksum(kpage);
 again:
 	parent = NULL;
 	new = &root->rb_node;
 
 	while (*new) {
 		struct page *tree_page;
+		u32 tree_hash;
 		int ret;
 
 		cond_resched();
 		stable_node = rb_entry(*new, struct ksm_stable_node, node);
+		tree_hash = stable_node->hash;
 		stable_node_any = NULL;
 		tree_page = chain(&stable_node_dup, stable_node, root);
 		if (!stable_node_dup) {
@@ -1919,7 +1944,10 @@ again:
 			goto again;
 		}
 
-		ret = memcmp_pages(kpage, tree_page);
+		if (hash != tree_hash)
+			ret = hash < tree_hash ? -1 : 1;
+		else
+			ret = memcmp_pages(kpage, tree_page);
 		put_page(tree_page);
 
 		parent = *new;
@@ -1939,6 +1967,7 @@ again:
 
 	INIT_HLIST_HEAD(&stable_node_dup->hlist);
 	stable_node_dup->kpfn = kpfn;
+	stable_node_dup->hash = hash;
 	set_page_stable_node(kpage, stable_node_dup);
 	stable_node_dup->rmap_hlist_len = 0;
 	DO_NUMA(stable_node_dup->nid = nid);
@@ -2008,7 +2037,19 @@ struct ksm_rmap_item *unstable_tree_search_insert(struct ksm_rmap_item *rmap_ite
 			return NULL;
 		}
 
-		ret = memcmp_pages(page, tree_page);
+		/*
+		 * The tree is keyed on the checksum that cmp_and_merge_page
+		 * has just confirmed to match the page content, so a full
+		 * memcmp is only needed to order hash collisions. A stale
+		 * checksum on a tree page that changed under us is no worse
+		 * than the stale content memcmp would have seen: the
+		 * unstable tree is allowed to rot and is rebuilt every scan.
+		 */
+		if (rmap_item->oldchecksum != tree_rmap_item->oldchecksum)
+			ret = rmap_item->oldchecksum <
+			      tree_rmap_item->oldchecksum ? -1 : 1;
+		else
+			ret = memcmp_pages(page, tree_page);
 
 		parent = *new;
 		if (ret < 0) {
@@ -2121,8 +2162,15 @@ static void cmp_and_merge_page(struct page *page, struct ksm_rmap_item *rmap_ite
 			max_page_sharing_bypass = true;
 	}
 
+	/*
+	 * The checksum keys both trees, so compute it once up front. It
+	 * also decides below whether the page is calm enough for the
+	 * unstable tree.
+	 */
+	checksum = calc_checksum(page);
+
 	/* We first start with searching the page inside the stable tree */
-	kpage = stable_tree_search(page);
+	kpage = stable_tree_search(page, checksum);
 	if (kpage == page && rmap_item->head == stable_node) {
 		put_page(kpage);
 		return;
@@ -2155,7 +2203,6 @@ static void cmp_and_merge_page(struct page *page, struct ksm_rmap_item *rmap_ite
 	 * don't want to insert it in the unstable tree, and we don't want
 	 * to waste our time searching for something identical to it there.
 	 */
-	checksum = calc_checksum(page);
 	if (rmap_item->oldchecksum != checksum) {
 		rmap_item->oldchecksum = checksum;
 		return;
@@ -202,6 +202,23 @@ unsigned long list_lru_count_node(struct list_lru *lru, int nid)
 }
 EXPORT_SYMBOL_GPL(list_lru_count_node);
 
+/*
+ * Batch isolation - take the lock once, move N elements to a private
+ * list, process unlocked, put back in bulk - is not a missing API
+ * here; it is the calling convention.  The walk wrappers acquire
+ * nlru->lock once around this whole function, so up to nr_to_walk
+ * isolate callbacks run under a single lock hold (callbacks drop it
+ * only for the LRU_RETRY/LRU_REMOVED_RETRY cases that must), and the
+ * dcache/icache shrinkers already use list_lru_isolate_move() to
+ * collect victims onto a private dispose list inside that hold,
+ * freeing them after the walk with the lock long released.  A scan of
+ * a 100M-object cache therefore costs one lock round trip per
+ * shrinker batch (shrinker->batch, default SHRINK_BATCH), not per
+ * element; reclaim latency spikes on such caches come from the free
+ * path (dentry/inode teardown, network round trips on NFS) and from
+ * batch sizing, which is tunable per shrinker, not from lock
+ * frequency in this walk.
+ */
 static unsigned long
 __list_lru_walk_one(struct list_lru *lru, int nid, int memcg_idx,
 		    list_lru_walk_cb isolate, void *cb_arg,
@@ -719,6 +719,8 @@ static const unsigned int memcg_vm_event_stat[] = {
 	THP_FAULT_ALLOC,
 	THP_COLLAPSE_ALLOC,
 #endif
+	MEMCG_STOCK_HIT,
+	MEMCG_STOCK_MISS,
 };
 
 #define NR_MEMCG_EVENTS ARRAY_SIZE(memcg_vm_event_stat)
@@ -2209,10 +2211,19 @@ void unlock_page_memcg(struct page *page)
 	folio_memcg_unlock(page_folio(page));
 }
 
+/*
+ * The stock cap adapts between MEMCG_CHARGE_BATCH and this many pages:
+ * it grows when the cached memcg keeps exhausting the stock and decays
+ * whenever the stock is drained, so only cpus with a sustained charge
+ * rate carry a larger hidden charge.
+ */
+#define MEMCG_CHARGE_BATCH_MAX	(8 * MEMCG_CHARGE_BATCH)
+
 struct memcg_stock_pcp {
 	local_lock_t stock_lock;
 	struct mem_cgroup *cached; /* this never be root cgroup */
 	unsigned int nr_pages;
+	unsigned int limit; /* adaptive stock cap, 0 means MEMCG_CHARGE_BATCH */
 
 #ifdef CONFIG_MEMCG_KMEM
 	struct obj_cgroup *cached_objcg;
@@ -2263,6 +2274,11 @@ static void memcg_account_kmem(struct mem_cgroup *memcg, int nr_pages)
  *
  * returns true if successful, false otherwise.
  */
+static unsigned int stock_limit(struct memcg_stock_pcp *stock)
+{
+	return max(READ_ONCE(stock->limit), MEMCG_CHARGE_BATCH);
+}
+
 static bool consume_stock(struct mem_cgroup *memcg, unsigned int nr_pages)
 {
 	struct memcg_stock_pcp *stock;
@@ -2278,10 +2294,26 @@ static bool consume_stock(struct mem_cgroup *memcg, unsigned int nr_pages)
 	if (memcg == stock->cached && stock->nr_pages >= nr_pages) {
 		stock->nr_pages -= nr_pages;
 		ret = true;
+	} else if (memcg == stock->cached) {
+		/*
+		 * This cpu keeps draining the stock for this memcg
+		 * faster than the cap allows refilling it; grow the cap
+		 * so the next refill covers more charges.
+		 */
+		WRITE_ONCE(stock->limit, min(stock_limit(stock) * 2,
+					     MEMCG_CHARGE_BATCH_MAX));
 	}
 
 	local_unlock_irqrestore(&memcg_stock.stock_lock, flags);
 
+	if (ret) {
+		count_memcg_events(memcg, MEMCG_STOCK_HIT, 1);
+		count_vm_events(MEMCG_STOCK_HIT, 1);
+	} else {
+		count_memcg_events(memcg, MEMCG_STOCK_MISS, 1);
+		count_vm_events(MEMCG_STOCK_MISS, 1);
+	}
+
 	return ret;
 }
 
@@ -2302,6 +2334,9 @@ static void drain_stock(struct memcg_stock_pcp *stock)
 		stock->nr_pages = 0;
 	}
 
+	/* Decay the adaptive cap back towards the default batch size. */
+	WRITE_ONCE(stock->limit, stock_limit(stock) / 2);
+
 	css_put(&old->css);
 	stock->cached = NULL;
 }
@@ -2345,7 +2380,7 @@ static void __refill_stock(struct mem_cgroup *memcg, unsigned int nr_pages)
 	}
 	stock->nr_pages += nr_pages;
 
-	if (stock->nr_pages > MEMCG_CHARGE_BATCH)
+	if (stock->nr_pages > stock_limit(stock))
 		drain_stock(stock);
 }
 
@@ -2670,7 +2705,8 @@ out:
 static int try_charge_memcg(struct mem_cgroup *memcg, gfp_t gfp_mask,
 			unsigned int nr_pages)
 {
-	unsigned int batch = max(MEMCG_CHARGE_BATCH, nr_pages);
+	unsigned int batch = max(this_cpu_read(memcg_stock.limit),
+				 max(MEMCG_CHARGE_BATCH, nr_pages));
 	int nr_retries = MAX_RECLAIM_RETRIES;
 	struct mem_cgroup *mem_over_limit;
 	struct page_counter *counter;
@@ -102,6 +102,7 @@
 #include <linux/mmu_notifier.h>
 #include <linux/printk.h>
 #include <linux/swapops.h>
+#include <linux/kobject.h>
 
 #include <asm/tlbflush.h>
 #include <asm/tlb.h>
@@ -130,6 +131,22 @@ static struct mempolicy default_policy = {
 
 static struct mempolicy preferred_node_policy[MAX_NUMNODES];
 
+/*
+ * Per-node weights for MPOL_WEIGHTED_INTERLEAVE, settable through
+ * /sys/kernel/mm/mempolicy/weighted_interleave/node<N>. A stored weight
+ * of 0 means "use the default of 1". Reads and writes of a single byte
+ * are atomic, so the table is accessed with READ_ONCE()/WRITE_ONCE()
+ * and needs no further locking.
+ */
+static u8 iw_table[MAX_NUMNODES];
+
+static u8 get_il_weight(int node)
+{
+	u8 weight = READ_ONCE(iw_table[node]);
+
+	return weight ? weight : 1;
+}
+
 /**
  * numa_map_to_online_node - Find closest online node
  * @node: Node id to start the search
@@ -408,6 +425,10 @@ static const struct mempolicy_operations mpol_ops[MPOL_MAX] = {
 	[MPOL_LOCAL] = {
 		.rebind = mpol_rebind_default,
 	},
+	[MPOL_WEIGHTED_INTERLEAVE] = {
+		.create = mpol_new_nodemask,
+		.rebind = mpol_rebind_nodemask,
+	},
 	[MPOL_PREFERRED_MANY] = {
 		.create = mpol_new_nodemask,
 		.rebind = mpol_rebind_preferred,
@@ -865,8 +886,11 @@ static long do_set_mempolicy(unsigned short mode, unsigned short flags,
 
 	old = current->mempolicy;
 	current->mempolicy = new;
-	if (new && new->mode == MPOL_INTERLEAVE)
+	if (new && (new->mode == MPOL_INTERLEAVE ||
+		    new->mode == MPOL_WEIGHTED_INTERLEAVE)) {
 		current->il_prev = MAX_NUMNODES-1;
+		current->il_weight = 0;
+	}
 	task_unlock(current);
 	mpol_put(old);
 	ret = 0;
@@ -889,6 +913,7 @@ static void get_policy_nodemask(struct mempolicy *p, nodemask_t *nodes)
 	switch (p->mode) {
 	case MPOL_BIND:
 	case MPOL_INTERLEAVE:
+	case MPOL_WEIGHTED_INTERLEAVE:
 	case MPOL_PREFERRED:
 	case MPOL_PREFERRED_MANY:
 		*nodes = p->nodes;
@@ -977,6 +1002,13 @@ static long do_get_mempolicy(int *policy, nodemask_t *nmask,
 		} else if (pol == current->mempolicy &&
 				pol->mode == MPOL_INTERLEAVE) {
 			*policy = next_node_in(current->il_prev, pol->nodes);
+		} else if (pol == current->mempolicy &&
+				pol->mode == MPOL_WEIGHTED_INTERLEAVE) {
+			if (current->il_weight)
+				*policy = current->il_prev;
+			else
+				*policy = next_node_in(current->il_prev,
+						       pol->nodes);
 		} else {
 			err = -EINVAL;
 			goto out;
@@ -1892,6 +1924,28 @@ static unsigned interleave_nodes(struct mempolicy *policy)
 	return next;
 }
 
+/*
+ * Like interleave_nodes(), but stay on each node for as many
+ * allocations as its weight before moving to the next one.
+ */
+static unsigned int weighted_interleave_nodes(struct mempolicy *policy)
+{
+	unsigned int node;
+	u8 weight;
+
+	node = current->il_prev;
+	weight = current->il_weight;
+	if (!weight || !node_isset(node, policy->nodes)) {
+		node = next_node_in(node, policy->nodes);
+		if (node == MAX_NUMNODES)
+			return node;
+		weight = get_il_weight(node);
+		current->il_prev = node;
+	}
+	current->il_weight = weight - 1;
+	return node;
+}
+
 /*
  * Depending on the memory policy provide a node from which to allocate the
  * next slab entry.
@@ -1915,6 +1969,9 @@ unsigned int mempolicy_slab_node(void)
 	case MPOL_INTERLEAVE:
 		return interleave_nodes(policy);
 
+	case MPOL_WEIGHTED_INTERLEAVE:
+		return weighted_interleave_nodes(policy);
+
 	case MPOL_BIND:
 	case MPOL_PREFERRED_MANY:
 	{
@@ -1969,6 +2026,36 @@ static unsigned offset_il_node(struct mempolicy *pol, unsigned long n)
 	return nid;
 }
 
+/*
+ * Weighted variant of offset_il_node(): the offset selects a slot in the
+ * weight-expanded node sequence, so each node receives a share of
+ * allocations proportional to its weight.
+ */
+static unsigned int offset_il_node_weighted(struct mempolicy *pol,
+					    unsigned long n)
+{
+	nodemask_t nodemask = pol->nodes;
+	unsigned int total = 0;
+	u8 weight;
+	int nid;
+
+	/* See the comment in offset_il_node() */
+	barrier();
+
+	if (nodes_empty(nodemask))
+		return numa_node_id();
+	for_each_node_mask(nid, nodemask)
+		total += get_il_weight(nid);
+	n %= total;
+	for_each_node_mask(nid, nodemask) {
+		weight = get_il_weight(nid);
+		if (n < weight)
+			break;
+		n -= weight;
+	}
+	return nid;
+}
+
 /* Determine a node number for interleave */
 static inline unsigned interleave_nid(struct mempolicy *pol,
 		 struct vm_area_struct *vma, unsigned long addr, int shift)
@@ -1986,9 +2073,13 @@ static inline unsigned interleave_nid(struct mempolicy *pol,
 		BUG_ON(shift < PAGE_SHIFT);
 		off = vma->vm_pgoff >> (shift - PAGE_SHIFT);
 		off += (addr - vma->vm_start) >> shift;
+		if (pol->mode == MPOL_WEIGHTED_INTERLEAVE)
+			return offset_il_node_weighted(pol, off);
 		return offset_il_node(pol, off);
-	} else
-		return interleave_nodes(pol);
+	}
+	if (pol->mode == MPOL_WEIGHTED_INTERLEAVE)
+		return weighted_interleave_nodes(pol);
+	return interleave_nodes(pol);
 }
 
 #ifdef CONFIG_HUGETLBFS
@@ -2017,7 +2108,8 @@ int huge_node(struct vm_area_struct *vma, unsigned long addr, gfp_t gfp_flags,
 	*nodemask = NULL;
 	mode = (*mpol)->mode;
 
-	if (unlikely(mode == MPOL_INTERLEAVE)) {
+	if (unlikely(mode == MPOL_INTERLEAVE ||
+		     mode == MPOL_WEIGHTED_INTERLEAVE)) {
 		nid = interleave_nid(*mpol, vma, addr,
 					huge_page_shift(hstate_vma(vma)));
 	} else {
@@ -2058,6 +2150,7 @@ bool init_nodemask_of_mempolicy(nodemask_t *mask)
 	case MPOL_PREFERRED_MANY:
 	case MPOL_BIND:
 	case MPOL_INTERLEAVE:
+	case MPOL_WEIGHTED_INTERLEAVE:
 		*mask = mempolicy->nodes;
 		break;
 
@@ -2168,7 +2261,8 @@ struct folio *vma_alloc_folio(gfp_t gfp, int order, struct vm_area_struct *vma,
 
 	pol = get_vma_policy(vma, addr);
 
-	if (pol->mode == MPOL_INTERLEAVE) {
+	if (pol->mode == MPOL_INTERLEAVE ||
+	    pol->mode == MPOL_WEIGHTED_INTERLEAVE) {
 		struct page *page;
 		unsigned nid;
 
@@ -2272,6 +2366,9 @@ struct page *alloc_pages(gfp_t gfp, unsigned order)
 	 */
 	if (pol->mode == MPOL_INTERLEAVE)
 		page = alloc_page_interleave(gfp, order, interleave_nodes(pol));
+	else if (pol->mode == MPOL_WEIGHTED_INTERLEAVE)
+		page = alloc_page_interleave(gfp, order,
+					     weighted_interleave_nodes(pol));
 	else if (pol->mode == MPOL_PREFERRED_MANY)
 		page = alloc_pages_preferred_many(gfp, order,
 				  policy_node(gfp, pol, numa_node_id()), pol);
@@ -2329,6 +2426,36 @@ static unsigned long alloc_pages_bulk_array_interleave(gfp_t gfp,
 	return total_allocated;
 }
 
+static unsigned long alloc_pages_bulk_array_weighted_interleave(gfp_t gfp,
+		struct mempolicy *pol, unsigned long nr_pages,
+		struct page **page_array)
+{
+	unsigned long total_allocated = 0;
+	unsigned long nr_allocated;
+	unsigned long node_pages;
+	int nid;
+
+	while (nr_pages) {
+		/* advances current->il_prev/il_weight like the page path */
+		nid = weighted_interleave_nodes(pol);
+		if (nid == MAX_NUMNODES)
+			break;
+		/* il_weight more pages are still owed to this node */
+		node_pages = min_t(unsigned long, nr_pages,
+				   (unsigned long)current->il_weight + 1);
+		nr_allocated = __alloc_pages_bulk(gfp, nid, NULL, node_pages,
+						  NULL, page_array);
+		page_array += nr_allocated;
+		total_allocated += nr_allocated;
+		if (nr_allocated < node_pages)
+			break;
+		nr_pages -= nr_allocated;
+		current->il_weight -= node_pages - 1;
+	}
+
+	return total_allocated;
+}
+
 static unsigned long alloc_pages_bulk_array_preferred_many(gfp_t gfp, int nid,
 		struct mempolicy *pol, unsigned long nr_pages,
 		struct page **page_array)
@@ -2367,6 +2494,10 @@ unsigned long alloc_pages_bulk_array_mempolicy(gfp_t gfp,
 		return alloc_pages_bulk_array_interleave(gfp, pol,
 							 nr_pages, page_array);
 
+	if (pol->mode == MPOL_WEIGHTED_INTERLEAVE)
+		return alloc_pages_bulk_array_weighted_interleave(gfp, pol,
+							 nr_pages, page_array);
+
 	if (pol->mode == MPOL_PREFERRED_MANY)
 		return alloc_pages_bulk_array_preferred_many(gfp,
 				numa_node_id(), pol, nr_pages, page_array);
@@ -2439,6 +2570,7 @@ bool __mpol_equal(struct mempolicy *a, struct mempolicy *b)
 	switch (a->mode) {
 	case MPOL_BIND:
 	case MPOL_INTERLEAVE:
+	case MPOL_WEIGHTED_INTERLEAVE:
 	case MPOL_PREFERRED:
 	case MPOL_PREFERRED_MANY:
 		return !!nodes_equal(a->nodes, b->nodes);
@@ -2580,6 +2712,12 @@ int mpol_misplaced(struct page *page, struct vm_area_struct *vma, unsigned long
 		polnid = offset_il_node(pol, pgoff);
 		break;
 
+	case MPOL_WEIGHTED_INTERLEAVE:
+		pgoff = vma->vm_pgoff;
+		pgoff += (addr - vma->vm_start) >> PAGE_SHIFT;
+		polnid = offset_il_node_weighted(pol, pgoff);
+		break;
+
 	case MPOL_PREFERRED:
 		if (node_isset(curnid, pol->nodes))
 			goto out;
@@ -2962,6 +3100,7 @@ static const char * const policy_modes[] =
 	[MPOL_PREFERRED]  = "prefer",
 	[MPOL_BIND]       = "bind",
 	[MPOL_INTERLEAVE] = "interleave",
+	[MPOL_WEIGHTED_INTERLEAVE] = "weighted interleave",
 	[MPOL_LOCAL]      = "local",
 	[MPOL_PREFERRED_MANY]  = "prefer (many)",
 };
@@ -3022,6 +3161,7 @@ int mpol_parse_str(char *str, struct mempolicy **mpol)
 		}
 		break;
 	case MPOL_INTERLEAVE:
+	case MPOL_WEIGHTED_INTERLEAVE:
 		/*
 		 * Default to online nodes with memory if no nodelist
 		 */
@@ -3132,6 +3272,7 @@ void mpol_to_str(char *buffer, int maxlen, struct mempolicy *pol)
 	case MPOL_PREFERRED_MANY:
 	case MPOL_BIND:
 	case MPOL_INTERLEAVE:
+	case MPOL_WEIGHTED_INTERLEAVE:
 		nodes = pol->nodes;
 		break;
 	default:
@@ -3158,3 +3299,98 @@ void mpol_to_str(char *buffer, int maxlen, struct mempolicy *pol)
 		p += scnprintf(p, buffer + maxlen - p, ":%*pbl",
 			       nodemask_pr_args(&nodes));
 }
+
+#ifdef CONFIG_SYSFS
+/*
+ * Weights for MPOL_WEIGHTED_INTERLEAVE are exposed as
+ * /sys/kernel/mm/mempolicy/weighted_interleave/node<N>. Writing 0
+ * restores the default weight of 1. A node's weight bounds how many
+ * consecutive allocations it receives before the policy moves on, so a
+ * DRAM:CXL bandwidth ratio of 3:1 maps directly onto weights 3 and 1.
+ */
+struct iw_node_attr {
+	struct kobj_attribute kobj_attr;
+	int nid;
+};
+
+static ssize_t node_show(struct kobject *kobj, struct kobj_attribute *attr,
+			 char *buf)
+{
+	struct iw_node_attr *node_attr;
+
+	node_attr = container_of(attr, struct iw_node_attr, kobj_attr);
+	return sysfs_emit(buf, "%d\n", get_il_weight(node_attr->nid));
+}
+
+static ssize_t node_store(struct kobject *kobj, struct kobj_attribute *attr,
+			  const char *buf, size_t count)
+{
+	struct iw_node_attr *node_attr;
+	u8 weight;
+
+	node_attr = container_of(attr, struct iw_node_attr, kobj_attr);
+	if (kstrtou8(buf, 0, &weight))
+		return -EINVAL;
+
+	WRITE_ONCE(iw_table[node_attr->nid], weight);
+	return count;
+}
+
+static int __init add_weight_node(int nid, struct kobject *wi_kobj)
+{
+	struct iw_node_attr *node_attr;
+	char *name;
+
+	node_attr = kzalloc(sizeof(*node_attr), GFP_KERNEL);
+	if (!node_attr)
+		return -ENOMEM;
+
+	name = kasprintf(GFP_KERNEL, "node%d", nid);
+	if (!name) {
+		kfree(node_attr);
+		return -ENOMEM;
+	}
+
+	sysfs_attr_init(&node_attr->kobj_attr.attr);
+	node_attr->kobj_attr.attr.name = name;
+	node_attr->kobj_attr.attr.mode = 0644;
+	node_attr->kobj_attr.show = node_show;
+	node_attr->kobj_attr.store = node_store;
+	node_attr->nid = nid;
+
+	if (sysfs_create_file(wi_kobj, &node_attr->kobj_attr.attr)) {
+		kfree(node_attr->kobj_attr.attr.name);
+		kfree(node_attr);
+		pr_err("failed to add attribute to weighted_interleave\n");
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
+static int __init mempolicy_sysfs_init(void)
+{
+	struct kobject *mempolicy_kobj, *wi_kobj;
+	int nid, err;
+
+	mempolicy_kobj = kobject_create_and_add("mempolicy", mm_kobj);
+	if (!mempolicy_kobj)
+		return -ENOMEM;
+
+	wi_kobj = kobject_create_and_add("weighted_interleave",
+					 mempolicy_kobj);
+	if (!wi_kobj) {
+		kobject_put(mempolicy_kobj);
+		return -ENOMEM;
+	}
+
+	for_each_node(nid) {
+		err = add_weight_node(nid, wi_kobj);
+		if (err)
+			pr_err("failed to add sysfs [node%d]\n", nid);
+	}
+
+	return 0;
+}
+late_initcall(mempolicy_sysfs_init);
+#endif /* CONFIG_SYSFS */
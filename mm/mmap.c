@@ -1847,6 +1847,62 @@ struct vm_area_struct *find_vma_intersection(struct mm_struct *mm,
 }
 EXPORT_SYMBOL(find_vma_intersection);
 
+#ifdef CONFIG_PER_VMA_LOCK
+/*
+ * Per-thread cache of the last vma find_vma() returned for the thread's
+ * own mm. A hit is only trusted while mm->mm_lock_seq has not moved
+ * since the cache was filled: the seqcount is bumped by
+ * vma_end_write_all() when a write section of the mmap_lock completes,
+ * so an unchanged value proves no other task has modified the tree in
+ * between. Changes made by the current task inside a still-open write
+ * section are handled by re-reading the live vma fields below, and by
+ * vm_area_free() clearing the cache when this task frees the vma.
+ */
+static struct vm_area_struct *find_vma_cache_lookup(struct mm_struct *mm,
+						    unsigned long addr)
+{
+	struct vm_area_struct *vma = current->find_vma_cache;
+
+	if (!vma || mm != current->mm ||
+	    current->find_vma_cache_seq != READ_ONCE(mm->mm_lock_seq))
+		return NULL;
+
+	if (vma->detached || vma->vm_mm != mm ||
+	    vma->vm_start > addr || vma->vm_end <= addr)
+		return NULL;
+
+	current->find_vma_cache_hits++;
+	return vma;
+}
+
+static void find_vma_cache_update(struct mm_struct *mm,
+				  struct vm_area_struct *vma)
+{
+	/*
+	 * Only cache lookups on the thread's own mm, and never for
+	 * kthreads: their borrowed mm is dropped without passing
+	 * through mm_release(), which is where the cache is cleared.
+	 */
+	if (mm != current->mm || (current->flags & PF_KTHREAD))
+		return;
+
+	current->find_vma_cache = vma;
+	current->find_vma_cache_seq = READ_ONCE(mm->mm_lock_seq);
+	current->find_vma_cache_misses++;
+}
+#else /* !CONFIG_PER_VMA_LOCK */
+static struct vm_area_struct *find_vma_cache_lookup(struct mm_struct *mm,
+						    unsigned long addr)
+{
+	return NULL;
+}
+
+static void find_vma_cache_update(struct mm_struct *mm,
+				  struct vm_area_struct *vma)
+{
+}
+#endif /* CONFIG_PER_VMA_LOCK */
+
 /**
  * find_vma() - Find the VMA for a given address, or the next VMA.
  * @mm: The mm_struct to check
@@ -1858,9 +1914,18 @@ EXPORT_SYMBOL(find_vma_intersection);
 struct vm_area_struct *find_vma(struct mm_struct *mm, unsigned long addr)
 {
 	unsigned long index = addr;
+	struct vm_area_struct *vma;
 
 	mmap_assert_locked(mm);
-	return mt_find(&mm->mm_mt, &index, ULONG_MAX);
+
+	vma = find_vma_cache_lookup(mm, addr);
+	if (vma)
+		return vma;
+
+	vma = mt_find(&mm->mm_mt, &index, ULONG_MAX);
+	if (vma)
+		find_vma_cache_update(mm, vma);
+	return vma;
 }
 EXPORT_SYMBOL(find_vma);
 
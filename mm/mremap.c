@@ -478,6 +478,24 @@ static bool move_pgt_entry(enum pgt_entry entry, struct vm_area_struct *vma,
 	return moved;
 }
 
+/*
+ * Table-level moves already reach PUD scope: on CONFIG_HAVE_MOVE_PUD
+ * architectures the loop below relinks whole PUD tables when both
+ * addresses are PUD-aligned (move_normal_pud), falling to PMD-table
+ * moves and only then to per-PTE copying, so an aligned 64GB remap is
+ * 64 pud_populate pairs - microseconds, one TLB flush.  Remaps that
+ * stall for hundreds of ms are the misaligned case, where source and
+ * destination disagree modulo PMD size and every PTE must be moved
+ * individually; the fix for that lives in the caller (allocators
+ * should mremap between PMD/PUD-aligned addresses, e.g. via
+ * MAP_ALIGNED-style reservation), not in parallelism.  A parallel
+ * walker is off the table regardless: this runs under mmap_lock held
+ * for write with the rmap locks taken around each entry move, and
+ * concurrent movers would need their TLB flushes ordered against each
+ * other before either side's old entries can be considered gone -
+ * coordination that costs what the misaligned walk costs, for the
+ * case alignment eliminates outright.
+ */
 unsigned long move_page_tables(struct vm_area_struct *vma,
 		unsigned long old_addr, struct vm_area_struct *new_vma,
 		unsigned long new_addr, unsigned long len,
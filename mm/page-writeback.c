@@ -1666,6 +1666,20 @@ static inline void wb_dirty_limits(struct dirty_throttle_control *dtc)
  * If we're over `background_thresh' then the writeback threads are woken to
  * perform some writeout.
  */
+/*
+ * Coarse log-scale histogram of the pauses balance_dirty_pages() imposes,
+ * surfaced through the bdi debugfs stats file.
+ */
+static void wb_record_dirty_pause(struct bdi_writeback *wb, long pause)
+{
+	unsigned int ms = jiffies_to_msecs(pause);
+	int i = 0;
+
+	while (i < WB_PAUSE_HIST_MAX - 1 && ms > (4U << (2 * i)))
+		i++;
+	wb->dirty_pause_hist[i]++;
+}
+
 static int balance_dirty_pages(struct bdi_writeback *wb,
 			       unsigned long pages_dirtied, unsigned int flags)
 {
@@ -1771,6 +1785,7 @@ static int balance_dirty_pages(struct bdi_writeback *wb,
 			unsigned long intv;
 			unsigned long m_intv;
 
+			wb->dirty_freerun++;
 free_running:
 			intv = dirty_poll_interval(dirty, thresh);
 			m_intv = ULONG_MAX;
@@ -1845,6 +1860,29 @@ free_running:
 		if (dirty_exceeded != wb->dirty_exceeded)
 			wb->dirty_exceeded = dirty_exceeded;
 
+		/*
+		 * A wb well below its own share of the dirty threshold
+		 * belongs to a device that is keeping up with its writers;
+		 * don't stall it in the pause loop just because a slower
+		 * wb has pushed the global level over background. Writeout
+		 * share is completion-proportional, so fast devices earn
+		 * the larger shares that clear this ceiling. The bypass is
+		 * off once the global (or memcg) domain exceeds its real
+		 * threshold, where throttling everyone is the point.
+		 */
+		if (!strictlimit && gdtc->dirty < gdtc->thresh &&
+		    gdtc->wb_dirty <
+		    dirty_freerun_ceiling(gdtc->wb_thresh,
+					  gdtc->wb_bg_thresh) &&
+		    (!mdtc ||
+		     (mdtc->dirty < mdtc->thresh &&
+		      mdtc->wb_dirty <
+		      dirty_freerun_ceiling(mdtc->wb_thresh,
+					    mdtc->wb_bg_thresh)))) {
+			wb->dirty_fast_bypass++;
+			goto free_running;
+		}
+
 		if (time_is_before_jiffies(READ_ONCE(wb->bw_time_stamp) +
 					   BANDWIDTH_INTERVAL))
 			__wb_update_bandwidth(gdtc, mdtc, true);
@@ -1920,6 +1958,7 @@ pause:
 			ret = -EAGAIN;
 			break;
 		}
+		wb_record_dirty_pause(wb, pause);
 		__set_current_state(TASK_KILLABLE);
 		wb->dirty_sleep = now;
 		io_schedule_timeout(pause);
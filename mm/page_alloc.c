@@ -655,6 +655,21 @@ static inline bool pcp_allowed_order(unsigned int order)
 	return false;
 }
 
+/*
+ * Per-order slot used for the pcp hit/refill statistics and the refill
+ * batch scaling state. Orders above PAGE_ALLOC_COSTLY_ORDER all map to
+ * the THP slot, mirroring order_to_pindex().
+ */
+static inline unsigned int order_to_pcp_stat(unsigned int order)
+{
+	if (order > PAGE_ALLOC_COSTLY_ORDER)
+		return PAGE_ALLOC_COSTLY_ORDER + 1;
+	return order;
+}
+
+/* Limit on how far refill_factor may grow the pcp refill batch */
+#define PCP_REFILL_FACTOR_MAX	3
+
 static inline void free_the_page(struct page *page, unsigned int order)
 {
 	if (pcp_allowed_order(order))		/* Via pcp? */
@@ -1007,6 +1022,17 @@ done_merging:
 	else
 		add_to_free_list(page, zone, order, migratetype);
 
+#if defined CONFIG_COMPACTION || defined CONFIG_CMA
+	/*
+	 * A high-order buddy forming in a movable pageblock marks that
+	 * block as a cheap migration source: it is already partially
+	 * free. Remember it for fast_find_migrateblock().
+	 */
+	if (order >= PAGE_ALLOC_COSTLY_ORDER && order < pageblock_order &&
+	    migratetype == MIGRATE_MOVABLE)
+		WRITE_ONCE(zone->compact_hint_pfn, pfn);
+#endif
+
 	/* Notify page reporting subsystem of freed page */
 	if (!(fpi_flags & FPI_SKIP_REPORT_NOTIFY))
 		page_reporting_notify_free(order);
@@ -2939,11 +2965,14 @@ struct page *__rmqueue_pcplist(struct zone *zone, unsigned int order,
 			struct per_cpu_pages *pcp,
 			struct list_head *list)
 {
+	unsigned int oidx = order_to_pcp_stat(order);
+	bool refilled = false;
 	struct page *page;
 
 	do {
 		if (list_empty(list)) {
-			int batch = READ_ONCE(pcp->batch);
+			int max_batch = READ_ONCE(pcp->batch);
+			int batch = max_batch;
 			int alloced;
 
 			/*
@@ -2953,13 +2982,23 @@ struct page *__rmqueue_pcplist(struct zone *zone, unsigned int order,
 			 * should never store free pages as the pages may
 			 * belong to arbitrary zones.
 			 */
-			if (batch > 1)
+			if (batch > 1) {
 				batch = max(batch >> order, 2);
+				/*
+				 * If this order keeps exhausting its list,
+				 * refill progressively larger chunks so that
+				 * bursty callers stop paying for the zone
+				 * lock every few allocations.
+				 */
+				batch = min(batch << pcp->refill_factor[oidx],
+					    max_batch);
+			}
 			alloced = rmqueue_bulk(zone, order,
 					batch, list,
 					migratetype, alloc_flags);
 
 			pcp->count += alloced << order;
+			refilled = true;
 			if (unlikely(list_empty(list)))
 				return NULL;
 		}
@@ -2969,6 +3008,15 @@ struct page *__rmqueue_pcplist(struct zone *zone, unsigned int order,
 		pcp->count -= 1 << order;
 	} while (check_new_pages(page, order));
 
+	if (refilled) {
+		__count_vm_event(PCPALLOC_REFILL_ORDER0 + oidx);
+		if (pcp->refill_factor[oidx] < PCP_REFILL_FACTOR_MAX)
+			pcp->refill_factor[oidx]++;
+	} else {
+		__count_vm_event(PCPALLOC_HIT_ORDER0 + oidx);
+		pcp->refill_factor[oidx] >>= 1;
+	}
+
 	return page;
 }
 
@@ -25,6 +25,8 @@
 #include <linux/uio.h>
 #include <linux/sched/task.h>
 #include <linux/delayacct.h>
+#include <linux/slab.h>
+#include <linux/workqueue.h>
 #include "swap.h"
 
 static void __end_swap_bio_write(struct bio *bio)
@@ -493,6 +495,60 @@ static void swap_readpage_bdev_async(struct page *page,
 	submit_bio(bio);
 }
 
+/*
+ * Swap devices with SWP_SYNCHRONOUS_IO (zram being the common case) do
+ * their decompression in the submitting context, so readahead pages
+ * submitted from a fault would all be decompressed serially before the
+ * faulting task gets to map its own page. Push readahead reads onto a
+ * workqueue instead: the fault then only pays for the one page it
+ * actually waits on, while neighbouring pages decompress in parallel.
+ * Anybody faulting one of the deferred pages blocks on its page lock
+ * until the worker has brought it uptodate, exactly as with async bio
+ * completion.
+ */
+static struct workqueue_struct *swap_readahead_wq;
+
+struct swap_readahead_work {
+	struct work_struct work;
+	struct page *page;
+};
+
+static void swap_readahead_work_fn(struct work_struct *work)
+{
+	struct swap_readahead_work *srw =
+		container_of(work, struct swap_readahead_work, work);
+
+	swap_readpage(srw->page, true, NULL);
+	put_page(srw->page);
+	kfree(srw);
+}
+
+static bool swap_readpage_defer(struct page *page)
+{
+	struct swap_readahead_work *srw;
+
+	if (!swap_readahead_wq)
+		return false;
+
+	srw = kmalloc(sizeof(*srw), GFP_NOWAIT | __GFP_NOWARN);
+	if (!srw)
+		return false;
+
+	INIT_WORK(&srw->work, swap_readahead_work_fn);
+	srw->page = page;
+	get_page(page);
+	queue_work(swap_readahead_wq, &srw->work);
+	return true;
+}
+
+static int __init swap_readahead_wq_init(void)
+{
+	swap_readahead_wq = alloc_workqueue("swapin_readahead",
+			WQ_UNBOUND | WQ_MEM_RECLAIM | WQ_HIGHPRI, 0);
+	return 0;
+}
+subsys_initcall(swap_readahead_wq_init);
+
 void swap_readpage(struct page *page, bool synchronous, struct swap_iocb **plug)
 {
 	struct swap_info_struct *sis = page_swap_info(page);
@@ -504,6 +560,17 @@ void swap_readpage(struct page *page, bool synchronous, struct swap_iocb **plug)
 	VM_BUG_ON_PAGE(!PageLocked(page), page);
 	VM_BUG_ON_PAGE(PageUptodate(page), page);
 
+	/*
+	 * Readahead pages on a synchronous device would otherwise be
+	 * decompressed inline below; hand them to the workqueue so only
+	 * the page the caller waits for costs it submission time. No
+	 * memory stall is accounted here since the caller does not wait
+	 * for these pages.
+	 */
+	if (!synchronous && data_race(sis->flags & SWP_SYNCHRONOUS_IO) &&
+	    swap_readpage_defer(page))
+		return;
+
 	/*
 	 * Count submission time as memory stall and delay. When the device
 	 * is congested, or the submitting cgroup IO-throttled, submission
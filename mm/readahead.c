@@ -129,6 +129,7 @@
 #include <linux/blk-cgroup.h>
 #include <linux/fadvise.h>
 #include <linux/sched/mm.h>
+#include <trace/events/filemap.h>
 
 #include "internal.h"
 
@@ -649,10 +650,40 @@ static void ondemand_readahead(struct readahead_control *ractl,
 		goto readit;
 
 	/*
-	 * standalone, small random read
-	 * Read as is, and do not pollute the readahead state.
+	 * Not sequential and no cached history either. Before treating it
+	 * as random, check for a repeating stride (forward or backward):
+	 * database-style strided scans otherwise degrade to synchronous
+	 * single-shot reads on every probe.
 	 */
-	do_page_cache_ra(ractl, req_size, 0);
+	{
+		long stride = (long)index - (long)prev_index;
+
+		if (stride == ra->stride && (stride < -1 || stride > 1)) {
+			if (ra->stride_hits < UINT_MAX)
+				ra->stride_hits++;
+		} else {
+			ra->stride = stride;
+			ra->stride_hits = 0;
+		}
+
+		do_page_cache_ra(ractl, req_size, 0);
+
+		/*
+		 * Two confirmations make a pattern: prefetch the predicted
+		 * next probe so it hits cache like a sequential stream.
+		 */
+		if (ra->stride_hits >= 2) {
+			pgoff_t next = index + ra->stride;
+
+			if (ra->stride > 0 || index >= (pgoff_t)-ra->stride) {
+				trace_mm_filemap_stride_readahead(ractl->mapping,
+						next, ra->stride,
+						ra->stride_hits, req_size);
+				ractl->_index = next;
+				do_page_cache_ra(ractl, req_size, 0);
+			}
+		}
+	}
 	return;
 
 initial_readahead:
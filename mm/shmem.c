@@ -116,11 +116,13 @@ struct shmem_options {
 	int huge;
 	int seen;
 	bool noswap;
+	unsigned int write_batch;
 #define SHMEM_SEEN_BLOCKS 1
 #define SHMEM_SEEN_INODES 2
 #define SHMEM_SEEN_HUGE 4
 #define SHMEM_SEEN_INUMS 8
 #define SHMEM_SEEN_NOSWAP 16
+#define SHMEM_SEEN_WRITE_BATCH 32
 };
 
 #ifdef CONFIG_TMPFS
@@ -2092,6 +2094,93 @@ static int synchronous_wake_function(wait_queue_entry_t *wait, unsigned mode, in
 	return ret;
 }
 
+/*
+ * Maximum accepted for the write_batch mount option, in pages.
+ */
+#define SHMEM_WRITE_BATCH_MAX	1024
+
+/*
+ * A sequential stream of write faults preallocates the folios the stream
+ * is about to need, zeroed and uptodate, so that fault-around can map
+ * them in bulk through filemap_map_pages() instead of the stream taking
+ * a major fault for every page.  Stream detection is an unlocked
+ * heuristic: a lost race costs nothing worse than a missed batch.
+ *
+ * Everything here is best effort - on any failure just fall back to the
+ * ordinary allocate-on-fault path.  Inode accounting for the whole batch
+ * is done under a single acquisition of info->lock.
+ */
+static void shmem_fault_prealloc(struct inode *inode, pgoff_t index,
+				 gfp_t gfp, struct mm_struct *charge_mm)
+{
+	struct shmem_inode_info *info = SHMEM_I(inode);
+	struct shmem_sb_info *sbinfo = SHMEM_SB(inode->i_sb);
+	struct address_space *mapping = inode->i_mapping;
+	unsigned int batch = READ_ONCE(sbinfo->write_batch);
+	pgoff_t end;
+	long nr = 0;
+
+	if (!batch)
+		return;
+	if (!index || READ_ONCE(info->next_write_hint) != index) {
+		WRITE_ONCE(info->next_write_hint, index + 1);
+		return;
+	}
+	/* The next hole, and hence the next major fault, is past the batch */
+	WRITE_ONCE(info->next_write_hint, index + batch + 1);
+
+	/* Huge mounts already batch allocation at HPAGE_PMD_NR granularity */
+	if (shmem_is_huge(inode, index, false, NULL, 0))
+		return;
+	/* Don't work against a hole-punch in progress: see shmem_fault() */
+	if (unlikely(inode->i_private))
+		return;
+
+	end = min(index + batch,
+		  (pgoff_t)((i_size_read(inode) - 1) >> PAGE_SHIFT));
+
+	for (index++; index <= end; index++) {
+		struct folio *folio;
+
+		folio = filemap_get_entry(mapping, index);
+		if (folio) {
+			if (!xa_is_value(folio))
+				folio_put(folio);
+			continue;
+		}
+		folio = shmem_alloc_and_acct_folio(gfp, inode, index, false);
+		if (IS_ERR(folio))
+			break;
+		if (shmem_add_to_page_cache(folio, mapping, index, NULL,
+					    gfp & GFP_RECLAIM_MASK,
+					    charge_mm)) {
+			folio_unlock(folio);
+			folio_put(folio);
+			shmem_inode_unacct_blocks(inode, 1);
+			break;
+		}
+		folio_add_lru(folio);
+		/*
+		 * filemap_map_pages() only maps uptodate folios, so clear
+		 * now rather than leaving it to the first write fault.
+		 */
+		clear_highpage(folio_page(folio, 0));
+		flush_dcache_folio(folio);
+		folio_mark_uptodate(folio);
+		folio_unlock(folio);
+		folio_put(folio);
+		nr++;
+	}
+
+	if (nr) {
+		spin_lock_irq(&info->lock);
+		info->alloced += nr;
+		inode->i_blocks += (blkcnt_t)BLOCKS_PER_PAGE * nr;
+		shmem_recalc_inode(inode);
+		spin_unlock_irq(&info->lock);
+	}
+}
+
 static vm_fault_t shmem_fault(struct vm_fault *vmf)
 {
 	struct vm_area_struct *vma = vmf->vma;
@@ -2164,8 +2253,12 @@ static vm_fault_t shmem_fault(struct vm_fault *vmf)
 				  gfp, vma, vmf, &ret);
 	if (err)
 		return vmf_error(err);
-	if (folio)
+	if (folio) {
 		vmf->page = folio_file_page(folio, vmf->pgoff);
+		if (vmf->flags & FAULT_FLAG_WRITE)
+			shmem_fault_prealloc(inode, vmf->pgoff, gfp,
+					     vma->vm_mm);
+	}
 	return ret;
 }
 
@@ -3472,6 +3565,7 @@ enum shmem_param {
 	Opt_inode32,
 	Opt_inode64,
 	Opt_noswap,
+	Opt_write_batch,
 };
 
 static const struct constant_table shmem_param_enums_huge[] = {
@@ -3494,6 +3588,7 @@ const struct fs_parameter_spec shmem_fs_parameters[] = {
 	fsparam_flag  ("inode32",	Opt_inode32),
 	fsparam_flag  ("inode64",	Opt_inode64),
 	fsparam_flag  ("noswap",	Opt_noswap),
+	fsparam_u32   ("write_batch",	Opt_write_batch),
 	{}
 };
 
@@ -3585,6 +3680,12 @@ static int shmem_parse_one(struct fs_context *fc, struct fs_parameter *param)
 		ctx->noswap = true;
 		ctx->seen |= SHMEM_SEEN_NOSWAP;
 		break;
+	case Opt_write_batch:
+		if (result.uint_32 > SHMEM_WRITE_BATCH_MAX)
+			goto bad_value;
+		ctx->write_batch = result.uint_32;
+		ctx->seen |= SHMEM_SEEN_WRITE_BATCH;
+		break;
 	}
 	return 0;
 
@@ -3694,6 +3795,8 @@ static int shmem_reconfigure(struct fs_context *fc)
 
 	if (ctx->seen & SHMEM_SEEN_HUGE)
 		sbinfo->huge = ctx->huge;
+	if (ctx->seen & SHMEM_SEEN_WRITE_BATCH)
+		sbinfo->write_batch = ctx->write_batch;
 	if (ctx->seen & SHMEM_SEEN_INUMS)
 		sbinfo->full_inums = ctx->full_inums;
 	if (ctx->seen & SHMEM_SEEN_BLOCKS)
@@ -3771,6 +3874,8 @@ static int shmem_show_options(struct seq_file *seq, struct dentry *root)
 	shmem_show_mpol(seq, sbinfo->mpol);
 	if (sbinfo->noswap)
 		seq_printf(seq, ",noswap");
+	if (sbinfo->write_batch)
+		seq_printf(seq, ",write_batch=%u", sbinfo->write_batch);
 	return 0;
 }
 
@@ -3835,6 +3940,7 @@ static int shmem_fill_super(struct super_block *sb, struct fs_context *fc)
 	sbinfo->full_inums = ctx->full_inums;
 	sbinfo->mode = ctx->mode;
 	sbinfo->huge = ctx->huge;
+	sbinfo->write_batch = ctx->write_batch;
 	sbinfo->mpol = ctx->mpol;
 	ctx->mpol = NULL;
 
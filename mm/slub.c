@@ -38,6 +38,7 @@
 #include <linux/prefetch.h>
 #include <linux/memcontrol.h>
 #include <linux/random.h>
+#include <linux/hash.h>
 #include <kunit/test.h>
 #include <kunit/test-bug.h>
 #include <linux/sort.h>
@@ -336,6 +337,81 @@ static inline void stat(const struct kmem_cache *s, enum stat_item si)
 #endif
 }
 
+/*
+ * Opt-in per-allocation-site statistics, enabled with the
+ * "slub_site_stats" boot option. Sites are keyed by the caller's return
+ * address in a small lock-free open-addressed table; once a hash
+ * neighbourhood fills up, further sites are folded into a shared
+ * overflow bucket. Results are in /sys/kernel/debug/slab/site_stats:
+ * allocation count, cpu-slab misses (slowpath entries) and remote-node
+ * frees per call site, so list_lock contention can be attributed to
+ * the callers producing it.
+ */
+#if defined(CONFIG_SLUB_DEBUG) && defined(CONFIG_DEBUG_FS)
+#define SLUB_SITE_STATS_BITS	10
+#define SLUB_SITE_STATS_SLOTS	(1 << SLUB_SITE_STATS_BITS)
+
+struct slub_site_stat {
+	unsigned long ip;
+	atomic_long_t allocs;
+	atomic_long_t cpu_slab_misses;
+	atomic_long_t remote_frees;
+};
+
+static struct slub_site_stat slub_site_stats[SLUB_SITE_STATS_SLOTS];
+static struct slub_site_stat slub_site_overflow;
+static DEFINE_STATIC_KEY_FALSE(slub_site_stats_enabled);
+
+static int __init setup_slub_site_stats(char *str)
+{
+	static_branch_enable(&slub_site_stats_enabled);
+	return 1;
+}
+__setup("slub_site_stats", setup_slub_site_stats);
+
+static struct slub_site_stat *slub_site_stat_get(unsigned long ip)
+{
+	unsigned int idx = hash_long(ip, SLUB_SITE_STATS_BITS);
+	unsigned int i;
+
+	for (i = 0; i < 4; i++, idx = (idx + 1) & (SLUB_SITE_STATS_SLOTS - 1)) {
+		struct slub_site_stat *site = &slub_site_stats[idx];
+		unsigned long old = READ_ONCE(site->ip);
+
+		if (!old)
+			old = cmpxchg(&site->ip, 0, ip);
+		if (!old || old == ip)
+			return site;
+	}
+	return &slub_site_overflow;
+}
+
+static __always_inline void slub_site_account_alloc(unsigned long addr)
+{
+	if (static_branch_unlikely(&slub_site_stats_enabled))
+		atomic_long_inc(&slub_site_stat_get(addr)->allocs);
+}
+
+static __always_inline void slub_site_account_miss(unsigned long addr)
+{
+	if (static_branch_unlikely(&slub_site_stats_enabled))
+		atomic_long_inc(&slub_site_stat_get(addr)->cpu_slab_misses);
+}
+
+static __always_inline void slub_site_account_remote_free(struct slab *slab,
+							  unsigned long addr)
+{
+	if (static_branch_unlikely(&slub_site_stats_enabled) &&
+	    slab_nid(slab) != numa_node_id())
+		atomic_long_inc(&slub_site_stat_get(addr)->remote_frees);
+}
+#else
+static inline void slub_site_account_alloc(unsigned long addr) { }
+static inline void slub_site_account_miss(unsigned long addr) { }
+static inline void slub_site_account_remote_free(struct slab *slab,
+						 unsigned long addr) { }
+#endif /* CONFIG_SLUB_DEBUG && CONFIG_DEBUG_FS */
+
 /*
  * Tracks for which NUMA nodes we have kmem_cache_nodes allocated.
  * Corresponds to node_state[N_NORMAL_MEMORY], but can temporarily
@@ -3070,6 +3146,7 @@ static void *___slab_alloc(struct kmem_cache *s, gfp_t gfpflags, int node,
 	struct partial_context pc;
 
 	stat(s, ALLOC_SLOWPATH);
+	slub_site_account_miss(addr);
 
 reread_slab:
 
@@ -3439,6 +3516,7 @@ static __fastpath_inline void *slab_alloc_node(struct kmem_cache *s, struct list
 		goto out;
 
 	object = __slab_alloc_node(s, gfpflags, node, addr, orig_size);
+	slub_site_account_alloc(addr);
 
 	maybe_wipe_obj_freeptr(s, object);
 	init = slab_want_init_on_alloc(gfpflags, s);
@@ -3583,6 +3661,7 @@ static void __slab_free(struct kmem_cache *s, struct slab *slab,
 	unsigned long flags;
 
 	stat(s, FREE_SLOWPATH);
+	slub_site_account_remote_free(slab, addr);
 
 	if (kfence_free(head))
 		return;
@@ -6431,6 +6510,42 @@ static const struct file_operations slab_debugfs_fops = {
 	.release = slab_debug_trace_release,
 };
 
+static void slub_site_stat_seq(struct seq_file *m,
+			       struct slub_site_stat *site, bool overflow)
+{
+	long allocs = atomic_long_read(&site->allocs);
+	long misses = atomic_long_read(&site->cpu_slab_misses);
+	long remote = atomic_long_read(&site->remote_frees);
+
+	if (!allocs && !misses && !remote)
+		return;
+	if (overflow)
+		seq_printf(m, "%12ld %12ld %12ld <other>\n",
+			   allocs, misses, remote);
+	else
+		seq_printf(m, "%12ld %12ld %12ld %pS\n",
+			   allocs, misses, remote, (void *)site->ip);
+}
+
+static int slub_site_stats_show(struct seq_file *m, void *unused)
+{
+	int i;
+
+	if (!static_branch_unlikely(&slub_site_stats_enabled)) {
+		seq_puts(m, "disabled; boot with slub_site_stats\n");
+		return 0;
+	}
+
+	seq_printf(m, "%12s %12s %12s %s\n",
+		   "allocs", "cpuslab_miss", "remote_free", "site");
+	for (i = 0; i < SLUB_SITE_STATS_SLOTS; i++)
+		slub_site_stat_seq(m, &slub_site_stats[i], false);
+	slub_site_stat_seq(m, &slub_site_overflow, true);
+
+	return 0;
+}
+DEFINE_SHOW_ATTRIBUTE(slub_site_stats);
+
 static void debugfs_slab_add(struct kmem_cache *s)
 {
 	struct dentry *slab_cache_dir;
@@ -6458,6 +6573,9 @@ static int __init slab_debugfs_init(void)
 
 	slab_debugfs_root = debugfs_create_dir("slab", NULL);
 
+	debugfs_create_file("site_stats", 0400, slab_debugfs_root, NULL,
+			    &slub_site_stats_fops);
+
 	list_for_each_entry(s, &slab_caches, list)
 		if (s->flags & SLAB_STORE_USER)
 			debugfs_slab_add(s);
@@ -85,6 +85,8 @@ static void truncate_folio_batch_exceptionals(struct address_space *mapping,
 		pgoff_t index = indices[i];
 
 		if (!xa_is_value(folio)) {
+			/* Keep indices[] in sync with the compacted batch */
+			indices[j] = index;
 			fbatch->folios[j++] = folio;
 			continue;
 		}
@@ -335,7 +337,7 @@ void truncate_inode_pages_range(struct address_space *mapping,
 	struct folio_batch fbatch;
 	pgoff_t		indices[PAGEVEC_SIZE];
 	pgoff_t		index;
-	int		i;
+	int		i, j;
 	struct folio	*folio;
 	bool		same_folio;
 
@@ -411,21 +413,35 @@ void truncate_inode_pages_range(struct address_space *mapping,
 			continue;
 		}
 
-		for (i = 0; i < folio_batch_count(&fbatch); i++) {
+		truncate_folio_batch_exceptionals(mapping, &fbatch, indices);
+
+		/*
+		 * Lock and clean up the whole batch first so that all the
+		 * page cache removals are done in a single xa_lock hold by
+		 * delete_from_page_cache_batch(), as in the first pass,
+		 * instead of relocking the xarray for every folio.
+		 */
+		for (i = 0, j = 0; i < folio_batch_count(&fbatch); i++) {
 			struct folio *folio = fbatch.folios[i];
 
 			/* We rely upon deletion not changing page->index */
 
-			if (xa_is_value(folio))
-				continue;
-
 			folio_lock(folio);
+			if (unlikely(folio->mapping != mapping)) {
+				/* Truncated or reclaimed under us */
+				folio_unlock(folio);
+				folio_put(folio);
+				continue;
+			}
 			VM_BUG_ON_FOLIO(!folio_contains(folio, indices[i]), folio);
 			folio_wait_writeback(folio);
-			truncate_inode_folio(mapping, folio);
-			folio_unlock(folio);
+			truncate_cleanup_folio(folio);
+			fbatch.folios[j++] = folio;
 		}
-		truncate_folio_batch_exceptionals(mapping, &fbatch, indices);
+		fbatch.nr = j;
+		delete_from_page_cache_batch(mapping, &fbatch);
+		for (i = 0; i < folio_batch_count(&fbatch); i++)
+			folio_unlock(fbatch.folios[i]);
 		folio_batch_release(&fbatch);
 	}
 }
@@ -23,6 +23,7 @@
 #include <linux/processor.h>
 #include <linux/sizes.h>
 #include <linux/compat.h>
+#include <linux/workqueue.h>
 
 #include <linux/uaccess.h>
 
@@ -790,17 +791,80 @@ EXPORT_SYMBOL(folio_mapping);
  * Can be called in atomic context for order-0 folios, but if the folio is
  * larger, it may sleep.
  */
+struct folio_copy_work {
+	struct work_struct work;
+	struct folio *dst;
+	struct folio *src;
+	long start;
+	long nr;
+};
+
+static void folio_copy_work_fn(struct work_struct *work)
+{
+	struct folio_copy_work *fcw =
+		container_of(work, struct folio_copy_work, work);
+	long i;
+
+	for (i = 0; i < fcw->nr; i++) {
+		copy_highpage(folio_page(fcw->dst, fcw->start + i),
+			      folio_page(fcw->src, fcw->start + i));
+		cond_resched();
+	}
+}
+
+/* minimum pages per copier so small folios stay on the caller's cpu */
+#define FOLIO_COPY_CHUNK	512
+
 void folio_copy(struct folio *dst, struct folio *src)
 {
-	long i = 0;
+	struct folio_copy_work works[3];
 	long nr = folio_nr_pages(src);
+	long start = 0;
+	long nr_works = 0;
+	long i;
 
-	for (;;) {
+	/*
+	 * The data copy dominates the cost of migrating large folios, and
+	 * a single cpu tops out well below the bandwidth of DRAM or a CXL
+	 * link. Spread big copies over unbound workers while this cpu
+	 * copies its own share; callers may sleep here (see the
+	 * cond_resched() below), so queueing and flushing work is fine.
+	 *
+	 * Not under reclaim, though: migration runs from reclaim-driven
+	 * demotion and compaction, and system_unbound_wq has no
+	 * WQ_MEM_RECLAIM rescuer, so flush_work() could wait forever for
+	 * a worker that cannot be created.  Copy serially there.
+	 */
+	if (nr >= 2 * FOLIO_COPY_CHUNK && !(current->flags & PF_MEMALLOC)) {
+		long chunk;
+
+		nr_works = min_t(long, ARRAY_SIZE(works),
+				 nr / FOLIO_COPY_CHUNK - 1);
+		chunk = nr / (nr_works + 1);
+		for (i = 0; i < nr_works; i++) {
+			struct folio_copy_work *fcw = &works[i];
+
+			fcw->dst = dst;
+			fcw->src = src;
+			fcw->start = start;
+			fcw->nr = chunk;
+			INIT_WORK_ONSTACK(&fcw->work, folio_copy_work_fn);
+			queue_work(system_unbound_wq, &fcw->work);
+			start += chunk;
+		}
+	}
+
+	for (i = start; ;) {
 		copy_highpage(folio_page(dst, i), folio_page(src, i));
 		if (++i == nr)
 			break;
 		cond_resched();
 	}
+
+	for (i = 0; i < nr_works; i++) {
+		flush_work(&works[i].work);
+		destroy_work_on_stack(&works[i].work);
+	}
 }
 
 int sysctl_overcommit_memory __read_mostly = OVERCOMMIT_GUESS;
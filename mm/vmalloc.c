@@ -1553,6 +1553,129 @@ static void free_vmap_area(struct vmap_area *va)
 	spin_unlock(&free_vmap_area_lock);
 }
 
+/*
+ * Per-cpu cache of small, recently purged vmap areas.
+ *
+ * alloc_vmap_area() serializes every allocation on free_vmap_area_lock,
+ * which shows up on large machines under heavy vmalloc/vfree churn. Small
+ * areas dominate that traffic, so instead of merging each lazily purged
+ * area straight back into the global free tree, a bounded number of them
+ * is parked on per-cpu, per-size lists. They have already passed the
+ * deferred TLB flush in __purge_vmap_area_lazy(), therefore they can be
+ * handed out again without touching free_vmap_area_lock at all.
+ *
+ * The caches are drained back into the free tree before an allocation
+ * enters the overflow path, so the address space they pin cannot cause
+ * spurious allocation failures.
+ */
+#define VMAP_AREA_CACHE_PAGES	8	/* largest cached area, in pages */
+#define VMAP_AREA_CACHE_DEPTH	8	/* areas cached per size class */
+
+struct vmap_area_cache {
+	spinlock_t lock;
+	unsigned int nr[VMAP_AREA_CACHE_PAGES];
+	struct list_head head[VMAP_AREA_CACHE_PAGES];
+};
+
+static DEFINE_PER_CPU(struct vmap_area_cache, vmap_area_cache);
+
+static struct vmap_area *
+vmap_area_cache_get(unsigned long size, unsigned long align,
+		    unsigned long vstart, unsigned long vend)
+{
+	unsigned long nr_pages = size >> PAGE_SHIFT;
+	struct vmap_area *va, *found = NULL;
+	struct vmap_area_cache *vac;
+
+	if (nr_pages == 0 || nr_pages > VMAP_AREA_CACHE_PAGES)
+		return NULL;
+
+	vac = raw_cpu_ptr(&vmap_area_cache);
+	if (!READ_ONCE(vac->nr[nr_pages - 1]))
+		return NULL;
+
+	spin_lock(&vac->lock);
+	list_for_each_entry(va, &vac->head[nr_pages - 1], list) {
+		if (va->va_start < vstart || va->va_end > vend ||
+		    !IS_ALIGNED(va->va_start, align))
+			continue;
+
+		list_del(&va->list);
+		vac->nr[nr_pages - 1]--;
+		found = va;
+		break;
+	}
+	spin_unlock(&vac->lock);
+
+	return found;
+}
+
+/*
+ * Try to stash a freshly purged area in this cpu's cache. The caller
+ * must have flushed the TLB for the area already. On success the area
+ * is moved off whatever list it currently sits on.
+ */
+static bool vmap_area_cache_put(struct vmap_area *va)
+{
+	unsigned long nr_pages = (va->va_end - va->va_start) >> PAGE_SHIFT;
+	struct vmap_area_cache *vac;
+	bool cached = false;
+
+	if (nr_pages == 0 || nr_pages > VMAP_AREA_CACHE_PAGES)
+		return false;
+
+	vac = raw_cpu_ptr(&vmap_area_cache);
+	if (READ_ONCE(vac->nr[nr_pages - 1]) >= VMAP_AREA_CACHE_DEPTH)
+		return false;
+
+	spin_lock(&vac->lock);
+	if (vac->nr[nr_pages - 1] < VMAP_AREA_CACHE_DEPTH) {
+		list_move(&va->list, &vac->head[nr_pages - 1]);
+		vac->nr[nr_pages - 1]++;
+		cached = true;
+	}
+	spin_unlock(&vac->lock);
+
+	return cached;
+}
+
+/*
+ * Return all cached areas to the global free tree. Called when an
+ * allocation is about to fall back to the overflow path, i.e. the
+ * address space pinned by the caches may be what it is missing.
+ */
+static void vmap_area_cache_drain(void)
+{
+	struct vmap_area_cache *vac;
+	struct vmap_area *va, *n_va;
+	LIST_HEAD(drain_list);
+	int cpu, i;
+
+	for_each_possible_cpu(cpu) {
+		vac = &per_cpu(vmap_area_cache, cpu);
+
+		spin_lock(&vac->lock);
+		for (i = 0; i < VMAP_AREA_CACHE_PAGES; i++) {
+			list_splice_init(&vac->head[i], &drain_list);
+			vac->nr[i] = 0;
+		}
+		spin_unlock(&vac->lock);
+	}
+
+	spin_lock(&free_vmap_area_lock);
+	list_for_each_entry_safe(va, n_va, &drain_list, list) {
+		unsigned long orig_start = va->va_start;
+		unsigned long orig_end = va->va_end;
+
+		va = merge_or_add_vmap_area_augment(va, &free_vmap_area_root,
+				&free_vmap_area_list);
+		if (va && is_vmalloc_or_module_addr((void *)orig_start))
+			kasan_release_vmalloc(orig_start, orig_end,
+					      va->va_start, va->va_end);
+	}
+	spin_unlock(&free_vmap_area_lock);
+}
+
 static inline void
 preload_this_cpu_lock(spinlock_t *lock, gfp_t gfp_mask, int node)
 {
@@ -1601,6 +1724,18 @@ static struct vmap_area *alloc_vmap_area(unsigned long size,
 	might_sleep();
 	gfp_mask = gfp_mask & GFP_RECLAIM_MASK;
 
+	/*
+	 * Small areas are common enough that a recently purged one is
+	 * likely sitting in this cpu's cache; reusing it (and its
+	 * vmap_area object) avoids the free_vmap_area_lock round trip
+	 * entirely.
+	 */
+	va = vmap_area_cache_get(size, align, vstart, vend);
+	if (va) {
+		addr = va->va_start;
+		goto insert;
+	}
+
 	va = kmem_cache_alloc_node(vmap_area_cachep, gfp_mask, node);
 	if (unlikely(!va))
 		return ERR_PTR(-ENOMEM);
@@ -1628,6 +1763,7 @@ retry:
 
 	va->va_start = addr;
 	va->va_end = addr + size;
+insert:
 	va->vm = NULL;
 	va->flags = va_flags;
 
@@ -1649,6 +1785,7 @@ retry:
 
 overflow:
 	if (!purged) {
+		vmap_area_cache_drain();
 		purge_vmap_area_lazy();
 		purged = 1;
 		goto retry;
@@ -1750,6 +1887,22 @@ static bool __purge_vmap_area_lazy(unsigned long start, unsigned long end)
 	flush_tlb_kernel_range(start, end);
 	resched_threshold = lazy_max_pages() << 1;
 
+	/*
+	 * The TLB has been flushed for the whole batch, so small areas
+	 * can be parked in the per-cpu caches for lock-free reuse rather
+	 * than merged back into the free tree below. Their kasan shadow
+	 * stays populated until vmap_area_cache_drain().
+	 */
+	list_for_each_entry_safe(va, n_va, &local_purge_list, list) {
+		unsigned long nr = (va->va_end - va->va_start) >> PAGE_SHIFT;
+
+		if (!vmap_area_cache_put(va))
+			continue;
+
+		atomic_long_sub(nr, &vmap_lazy_nr);
+		num_purged_areas++;
+	}
+
 	spin_lock(&free_vmap_area_lock);
 	list_for_each_entry_safe(va, n_va, &local_purge_list, list) {
 		unsigned long nr = (va->va_end - va->va_start) >> PAGE_SHIFT;
@@ -4383,7 +4536,9 @@ void __init vmalloc_init(void)
 
 	for_each_possible_cpu(i) {
 		struct vmap_block_queue *vbq;
+		struct vmap_area_cache *vac;
 		struct vfree_deferred *p;
+		int sz;
 
 		vbq = &per_cpu(vmap_block_queue, i);
 		spin_lock_init(&vbq->lock);
@@ -4392,6 +4547,11 @@ void __init vmalloc_init(void)
 		init_llist_head(&p->list);
 		INIT_WORK(&p->wq, delayed_vfree_work);
 		xa_init(&vbq->vmap_blocks);
+
+		vac = &per_cpu(vmap_area_cache, i);
+		spin_lock_init(&vac->lock);
+		for (sz = 0; sz < VMAP_AREA_CACHE_PAGES; sz++)
+			INIT_LIST_HEAD(&vac->head[sz]);
 	}
 
 	/* Import existing vmlist entries. */
@@ -6420,17 +6420,81 @@ static inline bool should_continue_reclaim(struct pglist_data *pgdat,
 	return inactive_lru_pages > pages_for_compaction;
 }
 
-static void shrink_node_memcgs(pg_data_t *pgdat, struct scan_control *sc)
+static void shrink_one_memcg(struct mem_cgroup *memcg, pg_data_t *pgdat,
+			     struct scan_control *sc)
+{
+	struct mem_cgroup *target_memcg = sc->target_mem_cgroup;
+	struct lruvec *lruvec = mem_cgroup_lruvec(memcg, pgdat);
+	unsigned long reclaimed;
+	unsigned long scanned;
+
+	mem_cgroup_calculate_protection(target_memcg, memcg);
+
+	if (mem_cgroup_below_min(target_memcg, memcg)) {
+		/*
+		 * Hard protection.
+		 * If there is no reclaimable memory, OOM.
+		 */
+		return;
+	} else if (mem_cgroup_below_low(target_memcg, memcg)) {
+		/*
+		 * Soft protection.
+		 * Respect the protection only as long as
+		 * there is an unprotected supply
+		 * of reclaimable memory from other cgroups.
+		 */
+		if (!sc->memcg_low_reclaim) {
+			sc->memcg_low_skipped = 1;
+			return;
+		}
+		memcg_memory_event(memcg, MEMCG_LOW);
+	}
+
+	reclaimed = sc->nr_reclaimed;
+	scanned = sc->nr_scanned;
+
+	shrink_lruvec(lruvec, sc);
+
+	shrink_slab(sc->gfp_mask, pgdat->node_id, memcg,
+		    sc->priority);
+
+	/* Record the group's reclaim efficiency */
+	if (!sc->proactive)
+		vmpressure(sc->gfp_mask, memcg, false,
+			   sc->nr_scanned - scanned,
+			   sc->nr_reclaimed - reclaimed);
+}
+
+/*
+ * kswapd normally walks the memcg tree alone, which makes background
+ * reclaim of a large node with many cgroups a single-core bottleneck.
+ * A small bounded pool of helper workers partitions the walk: helper i
+ * of n handles every n-th memcg the shared iteration order yields, with
+ * kswapd itself taking share 0. Each helper reclaims into a private
+ * scan_control that is folded back into the caller's when it finishes.
+ */
+#define KSWAPD_HELPERS_MAX	4
+
+static struct workqueue_struct *kswapd_helper_wq;
+
+struct kswapd_helper {
+	struct work_struct work;
+	pg_data_t *pgdat;
+	struct scan_control sc;
+	int id;
+	int nr_helpers;
+	struct completion done;
+};
+
+static void kswapd_helper_walk(pg_data_t *pgdat, struct scan_control *sc,
+			       int id, int nr_helpers)
 {
 	struct mem_cgroup *target_memcg = sc->target_mem_cgroup;
 	struct mem_cgroup *memcg;
+	int pos = 0;
 
 	memcg = mem_cgroup_iter(target_memcg, NULL, NULL);
 	do {
-		struct lruvec *lruvec = mem_cgroup_lruvec(memcg, pgdat);
-		unsigned long reclaimed;
-		unsigned long scanned;
-
 		/*
 		 * This loop can become CPU-bound when target memcgs
 		 * aren't eligible for reclaim - either because they
@@ -6439,43 +6503,91 @@ static void shrink_node_memcgs(pg_data_t *pgdat, struct scan_control *sc)
 		 */
 		cond_resched();
 
-		mem_cgroup_calculate_protection(target_memcg, memcg);
+		if (pos++ % nr_helpers == id)
+			shrink_one_memcg(memcg, pgdat, sc);
+	} while ((memcg = mem_cgroup_iter(target_memcg, memcg, NULL)));
+}
 
-		if (mem_cgroup_below_min(target_memcg, memcg)) {
-			/*
-			 * Hard protection.
-			 * If there is no reclaimable memory, OOM.
-			 */
-			continue;
-		} else if (mem_cgroup_below_low(target_memcg, memcg)) {
-			/*
-			 * Soft protection.
-			 * Respect the protection only as long as
-			 * there is an unprotected supply
-			 * of reclaimable memory from other cgroups.
-			 */
-			if (!sc->memcg_low_reclaim) {
-				sc->memcg_low_skipped = 1;
-				continue;
-			}
-			memcg_memory_event(memcg, MEMCG_LOW);
-		}
+static void kswapd_helper_fn(struct work_struct *work)
+{
+	struct kswapd_helper *kh = container_of(work, struct kswapd_helper, work);
+	struct reclaim_state rs = { 0 };
+	struct task_struct *tsk = current;
 
-		reclaimed = sc->nr_reclaimed;
-		scanned = sc->nr_scanned;
+	WARN_ON_ONCE(tsk->reclaim_state);
+	tsk->reclaim_state = &rs;
 
-		shrink_lruvec(lruvec, sc);
+	/*
+	 * The helper stands in for kswapd, so it needs kswapd's task
+	 * context: PF_MEMALLOC keeps allocations made during reclaim
+	 * from recursing into direct reclaim, and PF_KSWAPD makes the
+	 * current_is_kswapd() sites (writeback permission, PGSTEAL/
+	 * PGSCAN accounting, reclaim throttling) treat its work as
+	 * background reclaim rather than direct reclaim.
+	 */
+	tsk->flags |= PF_MEMALLOC | PF_KSWAPD;
 
-		shrink_slab(sc->gfp_mask, pgdat->node_id, memcg,
-			    sc->priority);
+	kswapd_helper_walk(kh->pgdat, &kh->sc, kh->id, kh->nr_helpers);
+	flush_reclaim_state(&kh->sc);
 
-		/* Record the group's reclaim efficiency */
-		if (!sc->proactive)
-			vmpressure(sc->gfp_mask, memcg, false,
-				   sc->nr_scanned - scanned,
-				   sc->nr_reclaimed - reclaimed);
+	tsk->flags &= ~(PF_MEMALLOC | PF_KSWAPD);
+	tsk->reclaim_state = NULL;
+	complete(&kh->done);
+}
 
-	} while ((memcg = mem_cgroup_iter(target_memcg, memcg, NULL)));
+static void shrink_node_memcgs(pg_data_t *pgdat, struct scan_control *sc)
+{
+	unsigned long reclaimed = sc->nr_reclaimed;
+	unsigned long scanned = sc->nr_scanned;
+	struct kswapd_helper *helpers = NULL;
+	int nr_helpers = 1;
+	int i;
+
+	/*
+	 * Only background reclaim is partitioned across the helper pool.
+	 * Direct and proactive reclaim stay single-threaded here - they
+	 * are already concurrent across callers.
+	 */
+	if (current_is_kswapd() && !cgroup_reclaim(sc) &&
+	    !mem_cgroup_disabled() && kswapd_helper_wq)
+		nr_helpers = min(KSWAPD_HELPERS_MAX, (int)num_online_cpus());
+
+	if (nr_helpers > 1) {
+		helpers = kcalloc(nr_helpers, sizeof(*helpers),
+				  GFP_NOWAIT | __GFP_NOWARN);
+		if (!helpers)
+			nr_helpers = 1;
+	}
+
+	if (nr_helpers == 1) {
+		kswapd_helper_walk(pgdat, sc, 0, 1);
+		return;
+	}
+
+	for (i = 1; i < nr_helpers; i++) {
+		struct kswapd_helper *kh = &helpers[i];
+
+		kh->pgdat = pgdat;
+		kh->sc = *sc;
+		kh->id = i;
+		kh->nr_helpers = nr_helpers;
+		init_completion(&kh->done);
+		INIT_WORK(&kh->work, kswapd_helper_fn);
+		queue_work_node(pgdat->node_id, kswapd_helper_wq, &kh->work);
+	}
+
+	kswapd_helper_walk(pgdat, sc, 0, nr_helpers);
+
+	for (i = 1; i < nr_helpers; i++) {
+		struct kswapd_helper *kh = &helpers[i];
+
+		wait_for_completion(&kh->done);
+		sc->nr_reclaimed += kh->sc.nr_reclaimed - reclaimed;
+		sc->nr_scanned += kh->sc.nr_scanned - scanned;
+		if (kh->sc.memcg_low_skipped)
+			sc->memcg_low_skipped = 1;
+	}
+	kfree(helpers);
 }
 
 static void shrink_node(pg_data_t *pgdat, struct scan_control *sc)
@@ -7880,6 +7992,9 @@ static int __init kswapd_init(void)
 	int nid;
 
 	swap_setup();
+	kswapd_helper_wq = alloc_workqueue("kswapd_helper",
+					   WQ_UNBOUND | WQ_MEM_RECLAIM,
+					   KSWAPD_HELPERS_MAX);
 	for_each_node_state(nid, N_MEMORY)
  		kswapd_run(nid);
 	return 0;
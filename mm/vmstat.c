@@ -1258,6 +1258,17 @@ const char * const vmstat_text[] = {
 	TEXTS_FOR_ZONES("allocstall")
 	TEXTS_FOR_ZONES("pgskip")
 
+	"pcp_alloc_hit_order0",
+	"pcp_alloc_hit_order1",
+	"pcp_alloc_hit_order2",
+	"pcp_alloc_hit_order3",
+	"pcp_alloc_hit_thp",
+	"pcp_alloc_refill_order0",
+	"pcp_alloc_refill_order1",
+	"pcp_alloc_refill_order2",
+	"pcp_alloc_refill_order3",
+	"pcp_alloc_refill_thp",
+
 	"pgfree",
 	"pgactivate",
 	"pgdeactivate",
@@ -1318,6 +1329,7 @@ const char * const vmstat_text[] = {
 	"compact_migrate_scanned",
 	"compact_free_scanned",
 	"compact_isolated",
+	"compact_pages_migrated",
 	"compact_stall",
 	"compact_fail",
 	"compact_success",
@@ -1395,6 +1407,10 @@ const char * const vmstat_text[] = {
 	"zswpin",
 	"zswpout",
 #endif
+#ifdef CONFIG_MEMCG
+	"memcg_stock_hit",
+	"memcg_stock_miss",
+#endif
 #ifdef CONFIG_X86
 	"direct_map_level2_splits",
 	"direct_map_level3_splits",
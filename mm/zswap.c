@@ -141,12 +141,27 @@ module_param_named(non_same_filled_pages_enabled, zswap_non_same_filled_pages_en
 * data structures
 **********************************/
 
-struct crypto_acomp_ctx {
-	struct crypto_acomp *acomp;
+/*
+ * The per-cpu compression state is a small pool of requests rather than a
+ * single one so that async acomp backends (IAA, QAT) can be kept fed: when
+ * several reclaim threads share a cpu, each can have its own request in
+ * flight while the others sleep in crypto_wait_req(). Software scomp
+ * backends complete inline and never have more than one request queued.
+ */
+#define ZSWAP_ACOMP_SLOTS	4
+
+struct zswap_acomp_slot {
 	struct acomp_req *req;
 	struct crypto_wait wait;
 	u8 *dstmem;
-	struct mutex *mutex;
+};
+
+struct crypto_acomp_ctx {
+	struct crypto_acomp *acomp;
+	struct zswap_acomp_slot slots[ZSWAP_ACOMP_SLOTS];
+	unsigned long slots_inuse;	/* protected by slots_lock */
+	spinlock_t slots_lock;
+	wait_queue_head_t slots_wait;
 };
 
 struct zswap_pool {
@@ -408,49 +423,33 @@ static struct zswap_entry *zswap_entry_find_get(struct rb_root *root,
 /*********************************
 * per-cpu code
 **********************************/
-static DEFINE_PER_CPU(u8 *, zswap_dstmem);
-/*
- * If users dynamically change the zpool type and compressor at runtime, i.e.
- * zswap is running, zswap can have more than one zpool on one cpu, but they
- * are sharing dtsmem. So we need this mutex to be per-cpu.
- */
-static DEFINE_PER_CPU(struct mutex *, zswap_mutex);
-
-static int zswap_dstmem_prepare(unsigned int cpu)
+static struct zswap_acomp_slot *zswap_acomp_slot_get(struct crypto_acomp_ctx *acomp_ctx)
 {
-	struct mutex *mutex;
-	u8 *dst;
-
-	dst = kmalloc_node(PAGE_SIZE * 2, GFP_KERNEL, cpu_to_node(cpu));
-	if (!dst)
-		return -ENOMEM;
-
-	mutex = kmalloc_node(sizeof(*mutex), GFP_KERNEL, cpu_to_node(cpu));
-	if (!mutex) {
-		kfree(dst);
-		return -ENOMEM;
+	int idx;
+
+	for (;;) {
+		spin_lock(&acomp_ctx->slots_lock);
+		idx = find_first_zero_bit(&acomp_ctx->slots_inuse,
+					  ZSWAP_ACOMP_SLOTS);
+		if (idx < ZSWAP_ACOMP_SLOTS) {
+			__set_bit(idx, &acomp_ctx->slots_inuse);
+			spin_unlock(&acomp_ctx->slots_lock);
+			return &acomp_ctx->slots[idx];
+		}
+		spin_unlock(&acomp_ctx->slots_lock);
+		wait_event(acomp_ctx->slots_wait,
+			   READ_ONCE(acomp_ctx->slots_inuse) !=
+			   GENMASK(ZSWAP_ACOMP_SLOTS - 1, 0));
 	}
-
-	mutex_init(mutex);
-	per_cpu(zswap_dstmem, cpu) = dst;
-	per_cpu(zswap_mutex, cpu) = mutex;
-	return 0;
 }
 
-static int zswap_dstmem_dead(unsigned int cpu)
+static void zswap_acomp_slot_put(struct crypto_acomp_ctx *acomp_ctx,
+				 struct zswap_acomp_slot *slot)
 {
-	struct mutex *mutex;
-	u8 *dst;
-
-	mutex = per_cpu(zswap_mutex, cpu);
-	kfree(mutex);
-	per_cpu(zswap_mutex, cpu) = NULL;
-
-	dst = per_cpu(zswap_dstmem, cpu);
-	kfree(dst);
-	per_cpu(zswap_dstmem, cpu) = NULL;
-
-	return 0;
+	spin_lock(&acomp_ctx->slots_lock);
+	__clear_bit(slot - acomp_ctx->slots, &acomp_ctx->slots_inuse);
+	spin_unlock(&acomp_ctx->slots_lock);
+	wake_up(&acomp_ctx->slots_wait);
 }
 
 static int zswap_cpu_comp_prepare(unsigned int cpu, struct hlist_node *node)
@@ -458,7 +457,7 @@ static int zswap_cpu_comp_prepare(unsigned int cpu, struct hlist_node *node)
 	struct zswap_pool *pool = hlist_entry(node, struct zswap_pool, node);
 	struct crypto_acomp_ctx *acomp_ctx = per_cpu_ptr(pool->acomp_ctx, cpu);
 	struct crypto_acomp *acomp;
-	struct acomp_req *req;
+	int i;
 
 	acomp = crypto_alloc_acomp_node(pool->tfm_name, 0, 0, cpu_to_node(cpu));
 	if (IS_ERR(acomp)) {
@@ -468,28 +467,45 @@ static int zswap_cpu_comp_prepare(unsigned int cpu, struct hlist_node *node)
 	}
 	acomp_ctx->acomp = acomp;
 
-	req = acomp_request_alloc(acomp_ctx->acomp);
-	if (!req) {
-		pr_err("could not alloc crypto acomp_request %s\n",
-		       pool->tfm_name);
-		crypto_free_acomp(acomp_ctx->acomp);
-		return -ENOMEM;
-	}
-	acomp_ctx->req = req;
+	for (i = 0; i < ZSWAP_ACOMP_SLOTS; i++) {
+		struct zswap_acomp_slot *slot = &acomp_ctx->slots[i];
 
-	crypto_init_wait(&acomp_ctx->wait);
-	/*
-	 * if the backend of acomp is async zip, crypto_req_done() will wakeup
-	 * crypto_wait_req(); if the backend of acomp is scomp, the callback
-	 * won't be called, crypto_wait_req() will return without blocking.
-	 */
-	acomp_request_set_callback(req, CRYPTO_TFM_REQ_MAY_BACKLOG,
-				   crypto_req_done, &acomp_ctx->wait);
+		slot->req = acomp_request_alloc(acomp_ctx->acomp);
+		slot->dstmem = kmalloc_node(PAGE_SIZE * 2, GFP_KERNEL,
+					    cpu_to_node(cpu));
+		if (!slot->req || !slot->dstmem)
+			goto fail;
+
+		crypto_init_wait(&slot->wait);
+		/*
+		 * if the backend of acomp is async zip, crypto_req_done() will
+		 * wakeup crypto_wait_req(); if the backend of acomp is scomp,
+		 * the callback won't be called, crypto_wait_req() will return
+		 * without blocking.
+		 */
+		acomp_request_set_callback(slot->req, CRYPTO_TFM_REQ_MAY_BACKLOG,
+					   crypto_req_done, &slot->wait);
+	}
 
-	acomp_ctx->mutex = per_cpu(zswap_mutex, cpu);
-	acomp_ctx->dstmem = per_cpu(zswap_dstmem, cpu);
+	acomp_ctx->slots_inuse = 0;
+	spin_lock_init(&acomp_ctx->slots_lock);
+	init_waitqueue_head(&acomp_ctx->slots_wait);
 
 	return 0;
+
+fail:
+	pr_err("could not alloc crypto acomp_request %s\n", pool->tfm_name);
+	for (; i >= 0; i--) {
+		struct zswap_acomp_slot *slot = &acomp_ctx->slots[i];
+
+		if (slot->req)
+			acomp_request_free(slot->req);
+		kfree(slot->dstmem);
+		slot->req = NULL;
+		slot->dstmem = NULL;
+	}
+	crypto_free_acomp(acomp_ctx->acomp);
+	return -ENOMEM;
 }
 
 static int zswap_cpu_comp_dead(unsigned int cpu, struct hlist_node *node)
@@ -498,8 +514,15 @@ static int zswap_cpu_comp_dead(unsigned int cpu, struct hlist_node *node)
 	struct crypto_acomp_ctx *acomp_ctx = per_cpu_ptr(pool->acomp_ctx, cpu);
 
 	if (!IS_ERR_OR_NULL(acomp_ctx)) {
-		if (!IS_ERR_OR_NULL(acomp_ctx->req))
-			acomp_request_free(acomp_ctx->req);
+		int i;
+
+		for (i = 0; i < ZSWAP_ACOMP_SLOTS; i++) {
+			struct zswap_acomp_slot *slot = &acomp_ctx->slots[i];
+
+			if (!IS_ERR_OR_NULL(slot->req))
+				acomp_request_free(slot->req);
+			kfree(slot->dstmem);
+		}
 		if (!IS_ERR_OR_NULL(acomp_ctx->acomp))
 			crypto_free_acomp(acomp_ctx->acomp);
 	}
@@ -974,6 +997,7 @@ static int zswap_writeback_entry(struct zpool *pool, unsigned long handle)
 	struct page *page;
 	struct scatterlist input, output;
 	struct crypto_acomp_ctx *acomp_ctx;
+	struct zswap_acomp_slot *slot;
 
 	u8 *src, *tmp = NULL;
 	unsigned int dlen;
@@ -1048,14 +1072,14 @@ static int zswap_writeback_entry(struct zpool *pool, unsigned long handle)
 			zpool_unmap_handle(pool, handle);
 		}
 
-		mutex_lock(acomp_ctx->mutex);
+		slot = zswap_acomp_slot_get(acomp_ctx);
 		sg_init_one(&input, src, entry->length);
 		sg_init_table(&output, 1);
 		sg_set_page(&output, page, PAGE_SIZE, 0);
-		acomp_request_set_params(acomp_ctx->req, &input, &output, entry->length, dlen);
-		ret = crypto_wait_req(crypto_acomp_decompress(acomp_ctx->req), &acomp_ctx->wait);
-		dlen = acomp_ctx->req->dlen;
-		mutex_unlock(acomp_ctx->mutex);
+		acomp_request_set_params(slot->req, &input, &output, entry->length, dlen);
+		ret = crypto_wait_req(crypto_acomp_decompress(slot->req), &slot->wait);
+		dlen = slot->req->dlen;
+		zswap_acomp_slot_put(acomp_ctx, slot);
 
 		if (!zpool_can_sleep_mapped(pool))
 			kfree(tmp);
@@ -1153,6 +1177,7 @@ static int zswap_frontswap_store(unsigned type, pgoff_t offset,
 	struct zswap_entry *entry, *dupentry;
 	struct scatterlist input, output;
 	struct crypto_acomp_ctx *acomp_ctx;
+	struct zswap_acomp_slot *slot;
 	struct obj_cgroup *objcg = NULL;
 	struct zswap_pool *pool;
 	int ret;
@@ -1229,33 +1254,29 @@ static int zswap_frontswap_store(unsigned type, pgoff_t offset,
 	/* compress */
 	acomp_ctx = raw_cpu_ptr(entry->pool->acomp_ctx);
 
-	mutex_lock(acomp_ctx->mutex);
+	slot = zswap_acomp_slot_get(acomp_ctx);
 
-	dst = acomp_ctx->dstmem;
+	dst = slot->dstmem;
 	sg_init_table(&input, 1);
 	sg_set_page(&input, page, PAGE_SIZE, 0);
 
-	/* zswap_dstmem is of size (PAGE_SIZE * 2). Reflect same in sg_list */
+	/* slot->dstmem is of size (PAGE_SIZE * 2). Reflect same in sg_list */
 	sg_init_one(&output, dst, PAGE_SIZE * 2);
-	acomp_request_set_params(acomp_ctx->req, &input, &output, PAGE_SIZE, dlen);
+	acomp_request_set_params(slot->req, &input, &output, PAGE_SIZE, dlen);
 	/*
-	 * it maybe looks a little bit silly that we send an asynchronous request,
-	 * then wait for its completion synchronously. This makes the process look
-	 * synchronous in fact.
-	 * Theoretically, acomp supports users send multiple acomp requests in one
-	 * acomp instance, then get those requests done simultaneously. but in this
-	 * case, frontswap actually does store and load page by page, there is no
-	 * existing method to send the second page before the first page is done
-	 * in one thread doing frontswap.
-	 * but in different threads running on different cpu, we have different
-	 * acomp instance, so multiple threads can do (de)compression in parallel.
+	 * frontswap hands us one page at a time and needs the result before
+	 * this call returns, so each caller still waits for its own request.
+	 * With the per-cpu slot pool, though, other reclaim threads sharing
+	 * this cpu can have their own requests in flight while we sleep in
+	 * crypto_wait_req(), which keeps async compression offload engines
+	 * busy instead of limiting them to one request per cpu.
 	 */
-	ret = crypto_wait_req(crypto_acomp_compress(acomp_ctx->req), &acomp_ctx->wait);
-	dlen = acomp_ctx->req->dlen;
+	ret = crypto_wait_req(crypto_acomp_compress(slot->req), &slot->wait);
+	dlen = slot->req->dlen;
 
 	if (ret) {
 		ret = -EINVAL;
-		goto put_dstmem;
+		goto put_slot;
 	}
 
 	/* store */
@@ -1266,17 +1287,17 @@ static int zswap_frontswap_store(unsigned type, pgoff_t offset,
 	ret = zpool_malloc(entry->pool->zpool, hlen + dlen, gfp, &handle);
 	if (ret == -ENOSPC) {
 		zswap_reject_compress_poor++;
-		goto put_dstmem;
+		goto put_slot;
 	}
 	if (ret) {
 		zswap_reject_alloc_fail++;
-		goto put_dstmem;
+		goto put_slot;
 	}
 	buf = zpool_map_handle(entry->pool->zpool, handle, ZPOOL_MM_WO);
 	memcpy(buf, &zhdr, hlen);
 	memcpy(buf + hlen, dst, dlen);
 	zpool_unmap_handle(entry->pool->zpool, handle);
-	mutex_unlock(acomp_ctx->mutex);
+	zswap_acomp_slot_put(acomp_ctx, slot);
 
 	/* populate entry */
 	entry->offset = offset;
@@ -1311,8 +1332,8 @@ insert_entry:
 
 	return 0;
 
-put_dstmem:
-	mutex_unlock(acomp_ctx->mutex);
+put_slot:
+	zswap_acomp_slot_put(acomp_ctx, slot);
 	zswap_pool_put(entry->pool);
 freepage:
 	zswap_entry_cache_free(entry);
@@ -1340,6 +1361,7 @@ static int zswap_frontswap_load(unsigned type, pgoff_t offset,
 	struct zswap_entry *entry;
 	struct scatterlist input, output;
 	struct crypto_acomp_ctx *acomp_ctx;
+	struct zswap_acomp_slot *slot;
 	u8 *src, *dst, *tmp;
 	unsigned int dlen;
 	int ret;
@@ -1383,13 +1405,13 @@ static int zswap_frontswap_load(unsigned type, pgoff_t offset,
 	}
 
 	acomp_ctx = raw_cpu_ptr(entry->pool->acomp_ctx);
-	mutex_lock(acomp_ctx->mutex);
+	slot = zswap_acomp_slot_get(acomp_ctx);
 	sg_init_one(&input, src, entry->length);
 	sg_init_table(&output, 1);
 	sg_set_page(&output, page, PAGE_SIZE, 0);
-	acomp_request_set_params(acomp_ctx->req, &input, &output, entry->length, dlen);
-	ret = crypto_wait_req(crypto_acomp_decompress(acomp_ctx->req), &acomp_ctx->wait);
-	mutex_unlock(acomp_ctx->mutex);
+	acomp_request_set_params(slot->req, &input, &output, entry->length, dlen);
+	ret = crypto_wait_req(crypto_acomp_decompress(slot->req), &slot->wait);
+	zswap_acomp_slot_put(acomp_ctx, slot);
 
 	if (zpool_can_sleep_mapped(entry->pool->zpool))
 		zpool_unmap_handle(entry->pool->zpool, entry->handle);
@@ -1534,13 +1556,6 @@ static int zswap_setup(void)
 		goto cache_fail;
 	}
 
-	ret = cpuhp_setup_state(CPUHP_MM_ZSWP_MEM_PREPARE, "mm/zswap:prepare",
-				zswap_dstmem_prepare, zswap_dstmem_dead);
-	if (ret) {
-		pr_err("dstmem alloc failed\n");
-		goto dstmem_fail;
-	}
-
 	ret = cpuhp_setup_state_multi(CPUHP_MM_ZSWP_POOL_PREPARE,
 				      "mm/zswap_pool:prepare",
 				      zswap_cpu_comp_prepare,
@@ -1577,8 +1592,6 @@ fallback_fail:
 	if (pool)
 		zswap_pool_destroy(pool);
 hp_fail:
-	cpuhp_remove_state(CPUHP_MM_ZSWP_MEM_PREPARE);
-dstmem_fail:
 	kmem_cache_destroy(zswap_entry_cache);
 cache_fail:
 	/* if built-in, we aren't unloaded on failure; don't allow use */
@@ -4654,6 +4654,109 @@ static bool skb_flow_limit(struct sk_buff *skb, unsigned int qlen)
 	return false;
 }
 
+#ifdef CONFIG_RPS
+/*
+ * Push @skb onto @sd's lock-free steered stack instead of bouncing the
+ * remote CPU's backlog queue lock.  The stack is spliced into
+ * input_pkt_queue by the owning CPU in process_backlog().  IPIs stay
+ * batched per net_rx_action() round through rps_ipi_list; the
+ * NAPI_STATE_SCHED bit doubles as the doorbell, so only the push that
+ * finds the target idle pays for a notification.
+ */
+static int enqueue_to_backlog_steered(struct sk_buff *skb,
+				      struct softnet_data *sd)
+{
+	enum skb_drop_reason reason;
+	struct sk_buff *old;
+	unsigned long flags;
+	unsigned int qlen;
+
+	reason = SKB_DROP_REASON_NOT_SPECIFIED;
+	if (!netif_running(skb->dev))
+		goto drop;
+
+	/* skb_queue_len() on the remote queue is a racy hint here, but
+	 * netdev_max_backlog is only ever a soft bound.
+	 */
+	qlen = atomic_read(&sd->steer_qlen) +
+	       skb_queue_len(&sd->input_pkt_queue);
+	reason = SKB_DROP_REASON_CPU_BACKLOG;
+	if (qlen > READ_ONCE(netdev_max_backlog) || skb_flow_limit(skb, qlen))
+		goto drop;
+
+	atomic_inc(&sd->steer_qlen);
+	old = READ_ONCE(sd->steer_list);
+	do {
+		skb->next = old;
+	} while (!try_cmpxchg(&sd->steer_list, &old, skb));
+
+	/* Pairs with the re-check in process_backlog(): either the owning
+	 * CPU observes our push after clearing NAPI_STATE_SCHED, or we
+	 * observe the cleared bit and schedule the backlog ourselves.
+	 */
+	if (!test_and_set_bit(NAPI_STATE_SCHED, &sd->backlog.state)) {
+		local_irq_save(flags);
+		napi_schedule_rps(sd);
+		local_irq_restore(flags);
+	}
+	return NET_RX_SUCCESS;
+
+drop:
+	/* The drop is attributed to the CPU that decided it; the target's
+	 * softnet counter cannot be bumped without its queue lock.
+	 */
+	this_cpu_inc(softnet_data.dropped);
+	dev_core_stats_rx_dropped_inc(skb->dev);
+	kfree_skb_reason(skb, reason);
+	return NET_RX_DROP;
+}
+
+/*
+ * Splice the steered stack into input_pkt_queue.  Runs on the CPU owning
+ * @sd with the backlog queue lock held; producers only ever push, so a
+ * single xchg() detaches the whole stack.
+ */
+static void backlog_splice_steered(struct softnet_data *sd)
+{
+	struct sk_buff *skb, *next, *head = NULL;
+	unsigned int n = 0;
+
+	if (!READ_ONCE(sd->steer_list))
+		return;
+
+	/* Producers push in LIFO order; reverse to restore arrival order. */
+	skb = xchg(&sd->steer_list, NULL);
+	while (skb) {
+		next = skb->next;
+		skb->next = head;
+		head = skb;
+		skb = next;
+	}
+	while ((skb = head)) {
+		head = skb->next;
+		skb->next = NULL;
+		__skb_queue_tail(&sd->input_pkt_queue, skb);
+		input_queue_tail_incr_save(sd, NULL);
+		n++;
+	}
+	atomic_sub(n, &sd->steer_qlen);
+}
+
+static bool backlog_has_steered(struct softnet_data *sd)
+{
+	return READ_ONCE(sd->steer_list);
+}
+#else
+static void backlog_splice_steered(struct softnet_data *sd)
+{
+}
+
+static bool backlog_has_steered(struct softnet_data *sd)
+{
+	return false;
+}
+#endif /* CONFIG_RPS */
+
 /*
  * enqueue_to_backlog is called to queue an skb to a per CPU backlog
  * queue (may be a remote CPU queue).
@@ -4669,6 +4772,15 @@ static int enqueue_to_backlog(struct sk_buff *skb, int cpu,
 	reason = SKB_DROP_REASON_NOT_SPECIFIED;
 	sd = &per_cpu(softnet_data, cpu);
 
+#ifdef CONFIG_RPS
+	/* Plain RPS steering to another CPU does not need the queue-tail
+	 * accounting RFS relies on (those callers pass a NULL qtail), so
+	 * it can use the lock-free stack.
+	 */
+	if (!qtail && cpu != smp_processor_id())
+		return enqueue_to_backlog_steered(skb, sd);
+#endif
+
 	rps_lock_irqsave(sd, &flags);
 	if (!netif_running(skb->dev))
 		goto drop;
@@ -4944,7 +5056,8 @@ static int netif_rx_internal(struct sk_buff *skb)
 		if (cpu < 0)
 			cpu = smp_processor_id();
 
-		ret = enqueue_to_backlog(skb, cpu, &rflow->last_qtail);
+		ret = enqueue_to_backlog(skb, cpu, rflow == &voidflow ?
+					 NULL : &rflow->last_qtail);
 
 		rcu_read_unlock();
 	} else
@@ -5682,7 +5795,8 @@ static int netif_receive_skb_internal(struct sk_buff *skb)
 		int cpu = get_rps_cpu(skb->dev, skb, &rflow);
 
 		if (cpu >= 0) {
-			ret = enqueue_to_backlog(skb, cpu, &rflow->last_qtail);
+			ret = enqueue_to_backlog(skb, cpu, rflow == &voidflow ?
+						 NULL : &rflow->last_qtail);
 			rcu_read_unlock();
 			return ret;
 		}
@@ -5717,7 +5831,8 @@ void netif_receive_skb_list_internal(struct list_head *head)
 			if (cpu >= 0) {
 				/* Will be handled, remove from list */
 				skb_list_del_init(skb);
-				enqueue_to_backlog(skb, cpu, &rflow->last_qtail);
+				enqueue_to_backlog(skb, cpu, rflow == &voidflow ?
+						   NULL : &rflow->last_qtail);
 			}
 		}
 	}
@@ -5791,6 +5906,7 @@ static void flush_backlog(struct work_struct *work)
 	sd = this_cpu_ptr(&softnet_data);
 
 	rps_lock_irq_disable(sd);
+	backlog_splice_steered(sd);
 	skb_queue_walk_safe(&sd->input_pkt_queue, skb, tmp) {
 		if (skb->dev->reg_state == NETREG_UNREGISTERING) {
 			__skb_unlink(skb, &sd->input_pkt_queue);
@@ -5822,7 +5938,8 @@ static bool flush_required(int cpu)
 	 * process_queue access may race only with dequeue
 	 */
 	do_flush = !skb_queue_empty(&sd->input_pkt_queue) ||
-		   !skb_queue_empty_lockless(&sd->process_queue);
+		   !skb_queue_empty_lockless(&sd->process_queue) ||
+		   backlog_has_steered(sd);
 	rps_unlock_irq_enable(sd);
 
 	return do_flush;
@@ -5939,6 +6056,7 @@ static int process_backlog(struct napi_struct *napi, int quota)
 		}
 
 		rps_lock_irq_disable(sd);
+		backlog_splice_steered(sd);
 		if (skb_queue_empty(&sd->input_pkt_queue)) {
 			/*
 			 * Inline a custom version of __napi_complete().
@@ -5950,6 +6068,19 @@ static int process_backlog(struct napi_struct *napi, int quota)
 			 */
 			napi->state = 0;
 			again = false;
+
+			/* A steering CPU may have pushed after the splice
+			 * above while NAPI_STATE_SCHED was still set.  Now
+			 * that the bit is clear, re-take it if the stack has
+			 * refilled; if a producer wins the race instead, its
+			 * IPI schedules the next poll.  Pairs with the
+			 * cmpxchg()/test_and_set_bit() in
+			 * enqueue_to_backlog_steered().
+			 */
+			smp_mb();
+			if (backlog_has_steered(sd) &&
+			    !test_and_set_bit(NAPI_STATE_SCHED, &napi->state))
+				again = true;
 		} else {
 			skb_queue_splice_tail_init(&sd->input_pkt_queue,
 						   &sd->process_queue);
@@ -6315,6 +6446,10 @@ static void init_gro_hash(struct napi_struct *napi)
 	for (i = 0; i < GRO_HASH_BUCKETS; i++) {
 		INIT_LIST_HEAD(&napi->gro_hash[i].list);
 		napi->gro_hash[i].count = 0;
+		napi->gro_hash[i].avg_segs = 0;
+		napi->gro_hash[i].probe = 0;
+		napi->gro_hash[i].stat_held = 0;
+		napi->gro_hash[i].stat_immediate = 0;
 	}
 	napi->gro_bitmask = 0;
 }
@@ -11163,6 +11298,20 @@ static int dev_cpu_dead(unsigned int oldcpu)
 		netif_rx(skb);
 		input_queue_head_incr(oldsd);
 	}
+#ifdef CONFIG_RPS
+	/* Drain the offline CPU's steered stack; get_rps_cpu() stopped
+	 * picking it once it left the online mask, so no new pushes.
+	 */
+	skb = xchg(&oldsd->steer_list, NULL);
+	while (skb) {
+		struct sk_buff *next = skb->next;
+
+		skb->next = NULL;
+		atomic_dec(&oldsd->steer_qlen);
+		netif_rx(skb);
+		skb = next;
+	}
+#endif
 
 	return 0;
 }
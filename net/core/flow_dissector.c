@@ -924,6 +924,108 @@ static bool is_pppoe_ses_hdr_valid(const struct pppoe_hdr *hdr)
 	return hdr->ver == 1 && hdr->type == 1 && hdr->code == 0;
 }
 
+/* Straight-line dissector for the header stacks a device's dissection
+ * profile declares: at most one VLAN tag, then IPv4 without options or
+ * fragmentation or IPv6 without extension headers, then TCP or UDP.
+ * Fills the same keys the generic interpreter would produce for these
+ * packets and returns false on anything else so the caller can fall
+ * back.  Only valid when dissecting into a struct flow_keys target.
+ */
+static bool skb_flow_dissect_profile(const struct sk_buff *skb,
+				     struct flow_keys *keys,
+				     const void *data, __be16 proto,
+				     int nhoff, int hlen, unsigned int flags)
+{
+	if (proto == htons(ETH_P_8021Q) || proto == htons(ETH_P_8021AD)) {
+		__be16 tpid = proto;
+
+		if (skb_vlan_tag_present(skb)) {
+			proto = skb->protocol;
+			keys->vlan.vlan_id = skb_vlan_tag_get_id(skb);
+			keys->vlan.vlan_priority = skb_vlan_tag_get_prio(skb);
+		} else {
+			const struct vlan_hdr *vlan;
+			struct vlan_hdr _vlan;
+
+			vlan = __skb_header_pointer(skb, nhoff, sizeof(_vlan),
+						    data, hlen, &_vlan);
+			if (!vlan)
+				return false;
+
+			proto = vlan->h_vlan_encapsulated_proto;
+			nhoff += sizeof(*vlan);
+			keys->vlan.vlan_id = ntohs(vlan->h_vlan_TCI) &
+				VLAN_VID_MASK;
+			keys->vlan.vlan_priority = (ntohs(vlan->h_vlan_TCI) &
+				VLAN_PRIO_MASK) >> VLAN_PRIO_SHIFT;
+		}
+		keys->vlan.vlan_tpid = tpid;
+		keys->vlan.vlan_eth_type = proto;
+	}
+
+	switch (proto) {
+	case htons(ETH_P_IP): {
+		const struct iphdr *iph;
+		struct iphdr _iph;
+
+		iph = __skb_header_pointer(skb, nhoff, sizeof(_iph), data,
+					   hlen, &_iph);
+		if (!iph || iph->ihl != 5 || ip_is_fragment(iph))
+			return false;
+		if (iph->protocol != IPPROTO_TCP &&
+		    iph->protocol != IPPROTO_UDP)
+			return false;
+
+		keys->addrs.v4addrs.src = iph->saddr;
+		keys->addrs.v4addrs.dst = iph->daddr;
+		keys->control.addr_type = FLOW_DISSECTOR_KEY_IPV4_ADDRS;
+		keys->basic.ip_proto = iph->protocol;
+		nhoff += sizeof(_iph);
+		break;
+	}
+	case htons(ETH_P_IPV6): {
+		const struct ipv6hdr *iph;
+		struct ipv6hdr _iph;
+
+		iph = __skb_header_pointer(skb, nhoff, sizeof(_iph), data,
+					   hlen, &_iph);
+		if (!iph)
+			return false;
+		if (iph->nexthdr != IPPROTO_TCP && iph->nexthdr != IPPROTO_UDP)
+			return false;
+
+		keys->addrs.v6addrs.src = iph->saddr;
+		keys->addrs.v6addrs.dst = iph->daddr;
+		keys->control.addr_type = FLOW_DISSECTOR_KEY_IPV6_ADDRS;
+		keys->basic.ip_proto = iph->nexthdr;
+		nhoff += sizeof(_iph);
+
+		if (ip6_flowlabel(iph)) {
+			keys->tags.flow_label = ntohl(ip6_flowlabel(iph));
+			if (flags & FLOW_DISSECTOR_F_STOP_AT_FLOW_LABEL)
+				goto out;
+		}
+		break;
+	}
+	default:
+		return false;
+	}
+
+	/* A zero return means the transport header was truncated; let the
+	 * generic path make the call on how to treat it.
+	 */
+	keys->ports.ports = __skb_flow_get_ports(skb, nhoff,
+						 keys->basic.ip_proto,
+						 data, hlen);
+	if (!keys->ports.ports)
+		return false;
+
+out:
+	keys->basic.n_proto = proto;
+	keys->control.thoff = min_t(u16, nhoff, skb->len);
+	return true;
+}
+
 /**
  * __skb_flow_dissect - extract the flow_keys struct and return it
  * @net: associated network namespace, derived from @skb if NULL
@@ -1059,6 +1161,20 @@ dissect_continue:
 		rcu_read_unlock();
 	}
 
+	/* Devices whose traffic is declared to match a simple header stack
+	 * can skip the interpreter below; any packet the straight-line
+	 * dissector cannot handle falls through and is counted against the
+	 * profile.
+	 */
+	if (flow_dissector == &flow_keys_dissector && skb && skb->dev &&
+	    READ_ONCE(skb->dev->dissect_profile) &&
+	    !(flags & ~FLOW_DISSECTOR_F_STOP_AT_FLOW_LABEL)) {
+		if (skb_flow_dissect_profile(skb, target_container, data,
+					     proto, nhoff, hlen, flags))
+			return true;
+		atomic_long_inc(&skb->dev->dissect_profile_misses);
+	}
+
 	if (dissector_uses_key(flow_dissector,
 			       FLOW_DISSECTOR_KEY_ETH_ADDRS)) {
 		struct ethhdr *eth = eth_hdr(skb);
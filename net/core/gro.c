@@ -328,6 +328,20 @@ out:
 	gro_normal_one(napi, skb, NAPI_GRO_CB(skb)->count);
 }
 
+/* Fold the segment count of a completing batch into the bucket's cadence
+ * estimate.  Called for every skb leaving the GRO hash, so buckets whose
+ * flows rarely coalesce converge towards a small average.
+ */
+static void gro_cadence_update(struct gro_list *gro_list, struct sk_buff *skb)
+{
+	unsigned int segs = NAPI_GRO_CB(skb)->count << GRO_CADENCE_SHIFT;
+
+	if (!gro_list->avg_segs)
+		gro_list->avg_segs = segs;
+	else
+		gro_list->avg_segs = (3 * gro_list->avg_segs + segs) / 4;
+}
+
 static void __napi_gro_flush_chain(struct napi_struct *napi, u32 index,
 				   bool flush_old)
 {
@@ -338,6 +352,7 @@ static void __napi_gro_flush_chain(struct napi_struct *napi, u32 index,
 		if (flush_old && NAPI_GRO_CB(skb)->age == jiffies)
 			return;
 		skb_list_del_init(skb);
+		gro_cadence_update(&napi->gro_hash[index], skb);
 		napi_gro_complete(napi, skb);
 		napi->gro_hash[index].count--;
 	}
@@ -460,11 +475,12 @@ static void gro_pull_from_frag0(struct sk_buff *skb, int grow)
 	}
 }
 
-static void gro_flush_oldest(struct napi_struct *napi, struct list_head *head)
+static void gro_flush_oldest(struct napi_struct *napi,
+			     struct gro_list *gro_list)
 {
 	struct sk_buff *oldest;
 
-	oldest = list_last_entry(head, struct sk_buff, list);
+	oldest = list_last_entry(&gro_list->list, struct sk_buff, list);
 
 	/* We are called with head length >= MAX_GRO_SKBS, so this is
 	 * impossible.
@@ -476,6 +492,7 @@ static void gro_flush_oldest(struct napi_struct *napi, struct list_head *head)
 	 * SKB to the chain.
 	 */
 	skb_list_del_init(oldest);
+	gro_cadence_update(gro_list, oldest);
 	napi_gro_complete(napi, oldest);
 }
 
@@ -549,6 +566,7 @@ found_ptype:
 
 	if (pp) {
 		skb_list_del_init(pp);
+		gro_cadence_update(gro_list, pp);
 		napi_gro_complete(napi, pp);
 		gro_list->count--;
 	}
@@ -559,10 +577,23 @@ found_ptype:
 	if (NAPI_GRO_CB(skb)->flush)
 		goto normal;
 
+	/* Flows hashing into a bucket with an RPC-like cadence gain nothing
+	 * from sitting in the hash until the next flush; deliver them right
+	 * away and only hold an occasional probe packet so that a cadence
+	 * turning bulky is noticed.
+	 */
+	if (READ_ONCE(skb->dev->gro_adaptive_flush) &&
+	    gro_list->avg_segs && gro_list->avg_segs < GRO_CADENCE_BULK_SEGS &&
+	    (++gro_list->probe % GRO_CADENCE_PROBE)) {
+		gro_list->stat_immediate++;
+		goto normal;
+	}
+
 	if (unlikely(gro_list->count >= MAX_GRO_SKBS))
-		gro_flush_oldest(napi, &gro_list->list);
+		gro_flush_oldest(napi, gro_list);
 	else
 		gro_list->count++;
+	gro_list->stat_held++;
 
 	NAPI_GRO_CB(skb)->age = jiffies;
 	NAPI_GRO_CB(skb)->last = skb;
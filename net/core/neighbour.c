@@ -126,6 +126,77 @@ static void neigh_mark_dead(struct neighbour *n)
 		list_del_init(&n->managed_list);
 }
 
+static void neigh_cpu_cache_flush(void);
+
+/* Probe this CPU's MRU cache before walking the hash table.  Slots pin
+ * their neighbour with a reference, so a hit needs no shared cacheline
+ * beyond the entry itself; the caller's RCU read side keeps the entry
+ * valid after we re-enable BHs because neighbours are freed by
+ * kfree_rcu().  Dead entries are evicted here on sight.
+ */
+struct neighbour *neigh_cpu_cache_lookup(struct neigh_table *tbl,
+					 const void *pkey,
+					 struct net_device *dev)
+{
+	struct neigh_cpu_cache *cache;
+	struct neighbour *n = NULL;
+	int i;
+
+	local_bh_disable();
+	cache = this_cpu_ptr(tbl->cpu_cache);
+	for (i = 0; i < NEIGH_CPU_CACHE_SLOTS; i++) {
+		struct neighbour *c = cache->slot[i];
+
+		if (!c)
+			continue;
+		if (READ_ONCE(c->dead)) {
+			cache->slot[i] = NULL;
+			neigh_release(c);
+			continue;
+		}
+		if (c->dev == dev && tbl->key_eq(c, pkey)) {
+			n = c;
+			break;
+		}
+	}
+	local_bh_enable();
+	return n;
+}
+EXPORT_SYMBOL(neigh_cpu_cache_lookup);
+
+void neigh_cpu_cache_insert(struct neigh_table *tbl, struct neighbour *n)
+{
+	struct neigh_cpu_cache *cache;
+	struct neighbour *old;
+	unsigned int hand;
+	int i;
+
+	if (READ_ONCE(n->dead))
+		return;
+
+	local_bh_disable();
+	cache = this_cpu_ptr(tbl->cpu_cache);
+	for (i = 0; i < NEIGH_CPU_CACHE_SLOTS; i++) {
+		if (cache->slot[i] == n)
+			goto out;
+	}
+	/* The caller only holds the RCU read side, so the neighbour may be
+	 * dropping its last reference concurrently; a plain neigh_hold()
+	 * would resurrect it.  Take the reference like neigh_lookup() does
+	 * and leave the cache untouched if the entry is already dying.
+	 */
+	if (!refcount_inc_not_zero(&n->refcnt))
+		goto out;
+	hand = cache->hand++ % NEIGH_CPU_CACHE_SLOTS;
+	old = cache->slot[hand];
+	cache->slot[hand] = n;
+	if (old)
+		neigh_release(old);
+out:
+	local_bh_enable();
+}
+EXPORT_SYMBOL(neigh_cpu_cache_insert);
+
 static void neigh_update_gc_list(struct neighbour *n)
 {
 	bool on_gc_list, exempt_from_gc;
@@ -428,6 +499,7 @@ void neigh_changeaddr(struct neigh_table *tbl, struct net_device *dev)
 	write_lock_bh(&tbl->lock);
 	neigh_flush_dev(tbl, dev, false);
 	write_unlock_bh(&tbl->lock);
+	neigh_cpu_cache_flush();
 }
 EXPORT_SYMBOL(neigh_changeaddr);
 
@@ -441,6 +513,7 @@ static int __neigh_ifdown(struct neigh_table *tbl, struct net_device *dev,
 			   tbl->family);
 	if (skb_queue_empty_lockless(&tbl->proxy_queue))
 		del_timer_sync(&tbl->proxy_timer);
+	neigh_cpu_cache_flush();
 	return 0;
 }
 
@@ -1760,6 +1833,41 @@ static struct lock_class_key neigh_table_proxy_queue_class;
 
 static struct neigh_table *neigh_tables[NEIGH_NR_TABLES] __read_mostly;
 
+static void neigh_cpu_cache_drop(struct work_struct *work)
+{
+	int i, t;
+
+	local_bh_disable();
+	for (t = 0; t < NEIGH_NR_TABLES; t++) {
+		struct neigh_table *tbl = READ_ONCE(neigh_tables[t]);
+		struct neigh_cpu_cache *cache;
+
+		if (!tbl || !tbl->cpu_cache)
+			continue;
+		cache = this_cpu_ptr(tbl->cpu_cache);
+		for (i = 0; i < NEIGH_CPU_CACHE_SLOTS; i++) {
+			struct neighbour *n = cache->slot[i];
+
+			if (n) {
+				cache->slot[i] = NULL;
+				neigh_release(n);
+			}
+		}
+	}
+	local_bh_enable();
+}
+
+/* Drop every per-CPU cached neighbour of every table.  This runs on
+ * device down/unregister and on table teardown, so that cached
+ * references never keep a dead neighbour - and with it a netdevice -
+ * pinned beyond the flush.  Rare enough that flushing all tables
+ * instead of just the affected one is not worth optimizing.
+ */
+static void neigh_cpu_cache_flush(void)
+{
+	schedule_on_each_cpu(neigh_cpu_cache_drop);
+}
+
 void neigh_table_init(int index, struct neigh_table *tbl)
 {
 	unsigned long now = jiffies;
@@ -1780,6 +1888,10 @@ void neigh_table_init(int index, struct neigh_table *tbl)
 	if (!tbl->stats)
 		panic("cannot create neighbour cache statistics");
 
+	tbl->cpu_cache = alloc_percpu(struct neigh_cpu_cache);
+	if (!tbl->cpu_cache)
+		panic("cannot create neighbour per-cpu cache");
+
 #ifdef CONFIG_PROC_FS
 	if (!proc_create_seq_data(tbl->id, 0, init_net.proc_net_stat,
 			      &neigh_stat_seq_ops, tbl))
@@ -1840,6 +1952,13 @@ int neigh_table_clear(int index, struct neigh_table *tbl)
 
 	remove_proc_entry(tbl->id, init_net.proc_net_stat);
 
+	/* neigh_ifdown() above flushed the per-CPU caches and the table
+	 * is no longer reachable through neigh_tables[], so no CPU can
+	 * re-populate a slot from it.
+	 */
+	free_percpu(tbl->cpu_cache);
+	tbl->cpu_cache = NULL;
+
 	free_percpu(tbl->stats);
 	tbl->stats = NULL;
 
@@ -2,6 +2,7 @@
 #include <linux/netdevice.h>
 #include <linux/proc_fs.h>
 #include <linux/seq_file.h>
+#include <net/dropreason.h>
 #include <net/wext.h>
 
 #include "dev.h"
@@ -200,6 +201,35 @@ static const struct seq_operations softnet_seq_ops = {
 	.show  = softnet_seq_show,
 };
 
+/* Sum of the always-on per-CPU drop counters maintained by
+ * kfree_skb_reason(), one "NAME count" line per core drop reason.
+ * The counters are global, not per namespace.
+ */
+static int drop_reasons_seq_show(struct seq_file *seq, void *v)
+{
+	const struct drop_reason_list *list;
+	unsigned int reason;
+
+	rcu_read_lock();
+	list = rcu_dereference(drop_reasons_by_subsys[SKB_DROP_REASON_SUBSYS_CORE]);
+	for (reason = SKB_DROP_REASON_NOT_SPECIFIED;
+	     reason < SKB_DROP_REASON_MAX; reason++) {
+		unsigned long total = 0;
+		int cpu;
+
+		for_each_possible_cpu(cpu)
+			total += per_cpu(skb_drop_counters[reason], cpu);
+
+		if (list && reason < list->n_reasons && list->reasons[reason])
+			seq_printf(seq, "%-32s %lu\n", list->reasons[reason],
+				   total);
+		else
+			seq_printf(seq, "%-32u %lu\n", reason, total);
+	}
+	rcu_read_unlock();
+	return 0;
+}
+
 static void *ptype_get_idx(struct seq_file *seq, loff_t pos)
 {
 	struct list_head *ptype_list = NULL;
@@ -333,12 +363,17 @@ static int __net_init dev_proc_net_init(struct net *net)
 	if (!proc_create_net("ptype", 0444, net->proc_net, &ptype_seq_ops,
 			sizeof(struct seq_net_private)))
 		goto out_softnet;
+	if (!proc_create_single("drop_reasons", 0444, net->proc_net,
+			drop_reasons_seq_show))
+		goto out_ptype;
 
 	if (wext_proc_init(net))
-		goto out_ptype;
+		goto out_drop_reasons;
 	rc = 0;
 out:
 	return rc;
+out_drop_reasons:
+	remove_proc_entry("drop_reasons", net->proc_net);
 out_ptype:
 	remove_proc_entry("ptype", net->proc_net);
 out_softnet:
@@ -352,6 +387,7 @@ static void __net_exit dev_proc_net_exit(struct net *net)
 {
 	wext_proc_exit(net);
 
+	remove_proc_entry("drop_reasons", net->proc_net);
 	remove_proc_entry("ptype", net->proc_net);
 	remove_proc_entry("softnet_stat", net->proc_net);
 	remove_proc_entry("dev", net->proc_net);
@@ -14,6 +14,7 @@
 #include <linux/sched/isolation.h>
 #include <linux/nsproxy.h>
 #include <net/sock.h>
+#include <net/gro.h>
 #include <net/net_namespace.h>
 #include <linux/rtnetlink.h>
 #include <linux/vmalloc.h>
@@ -422,6 +423,82 @@ static ssize_t napi_defer_hard_irqs_store(struct device *dev,
 }
 NETDEVICE_SHOW_RW(napi_defer_hard_irqs, fmt_dec);
 
+static int change_gro_adaptive_flush(struct net_device *dev, unsigned long val)
+{
+	WRITE_ONCE(dev->gro_adaptive_flush, !!val);
+	return 0;
+}
+
+static ssize_t gro_adaptive_flush_store(struct device *dev,
+					struct device_attribute *attr,
+					const char *buf, size_t len)
+{
+	if (!capable(CAP_NET_ADMIN))
+		return -EPERM;
+
+	return netdev_store(dev, attr, buf, len, change_gro_adaptive_flush);
+}
+NETDEVICE_SHOW_RW(gro_adaptive_flush, fmt_dec);
+
+static int change_dissect_profile(struct net_device *dev, unsigned long val)
+{
+	WRITE_ONCE(dev->dissect_profile, !!val);
+	return 0;
+}
+
+static ssize_t dissect_profile_store(struct device *dev,
+				     struct device_attribute *attr,
+				     const char *buf, size_t len)
+{
+	if (!capable(CAP_NET_ADMIN))
+		return -EPERM;
+
+	return netdev_store(dev, attr, buf, len, change_dissect_profile);
+}
+NETDEVICE_SHOW_RW(dissect_profile, fmt_dec);
+
+static ssize_t dissect_profile_misses_show(struct device *dev,
+					   struct device_attribute *attr,
+					   char *buf)
+{
+	struct net_device *netdev = to_net_dev(dev);
+
+	return sysfs_emit(buf, fmt_ulong,
+			  (unsigned long)atomic_long_read(&netdev->dissect_profile_misses));
+}
+static DEVICE_ATTR_RO(dissect_profile_misses);
+
+static ssize_t gro_flush_stats_show(struct device *dev,
+				    struct device_attribute *attr, char *buf)
+{
+	struct net_device *netdev = to_net_dev(dev);
+	struct napi_struct *napi;
+	ssize_t len = 0;
+	int i;
+
+	if (!rtnl_trylock())
+		return restart_syscall();
+
+	list_for_each_entry(napi, &netdev->napi_list, dev_list) {
+		for (i = 0; i < GRO_HASH_BUCKETS; i++) {
+			struct gro_list *gl = &napi->gro_hash[i];
+
+			if (!gl->stat_held && !gl->stat_immediate)
+				continue;
+			len += sysfs_emit_at(buf, len,
+				"napi %d bucket %d avg_segs %u held %u immediate %u\n",
+				napi->napi_id, i,
+				gl->avg_segs >> GRO_CADENCE_SHIFT,
+				gl->stat_held, gl->stat_immediate);
+		}
+	}
+
+	rtnl_unlock();
+
+	return len;
+}
+static DEVICE_ATTR_RO(gro_flush_stats);
+
 static ssize_t ifalias_store(struct device *dev, struct device_attribute *attr,
 			     const char *buf, size_t len)
 {
@@ -646,6 +723,10 @@ static struct attribute *net_class_attrs[] __ro_after_init = {
 	&dev_attr_tx_queue_len.attr,
 	&dev_attr_gro_flush_timeout.attr,
 	&dev_attr_napi_defer_hard_irqs.attr,
+	&dev_attr_gro_adaptive_flush.attr,
+	&dev_attr_gro_flush_stats.attr,
+	&dev_attr_dissect_profile.attr,
+	&dev_attr_dissect_profile_misses.attr,
 	&dev_attr_phys_port_id.attr,
 	&dev_attr_phys_port_name.attr,
 	&dev_attr_phys_switch_id.attr,
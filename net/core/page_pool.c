@@ -157,6 +157,97 @@ static void page_pool_producer_unlock(struct page_pool *pool,
 		spin_unlock_bh(&pool->ring.producer_lock);
 }
 
+/* Shared per-NUMA-node reservoir sitting between the pools of a node and
+ * the page allocator.  Pages are pushed here only after
+ * page_pool_release_page() has unmapped them and cleared their pp state,
+ * so the reservoir holds plain order-0 pages and any pool can refill from
+ * it regardless of device or DMA settings.  This lets pages released on
+ * one queue be reused by another queue or device on the same node instead
+ * of doing a round trip through the buddy allocator, and lets the
+ * per-pool rings stay small.
+ */
+#define PP_NODE_RESERVOIR_SIZE	8192
+
+struct pp_node_reservoir {
+	struct ptr_ring ring;
+	int nid;
+	refcount_t users;
+};
+
+static struct pp_node_reservoir *pp_reservoirs[MAX_NUMNODES];
+static DEFINE_MUTEX(pp_reservoir_mutex);
+
+static struct pp_node_reservoir *pp_node_reservoir_attach(int nid)
+{
+	struct pp_node_reservoir *res;
+
+	if (nid == NUMA_NO_NODE)
+		nid = numa_mem_id();
+
+	mutex_lock(&pp_reservoir_mutex);
+	res = pp_reservoirs[nid];
+	if (res) {
+		refcount_inc(&res->users);
+		goto out;
+	}
+
+	res = kzalloc_node(sizeof(*res), GFP_KERNEL, nid);
+	if (!res)
+		goto out;
+
+	if (ptr_ring_init(&res->ring, PP_NODE_RESERVOIR_SIZE, GFP_KERNEL) < 0) {
+		kfree(res);
+		res = NULL;
+		goto out;
+	}
+
+	res->nid = nid;
+	refcount_set(&res->users, 1);
+	pp_reservoirs[nid] = res;
+out:
+	mutex_unlock(&pp_reservoir_mutex);
+	return res;
+}
+
+static void pp_node_reservoir_detach(struct pp_node_reservoir *res)
+{
+	struct page *page;
+
+	mutex_lock(&pp_reservoir_mutex);
+	if (!refcount_dec_and_test(&res->users)) {
+		mutex_unlock(&pp_reservoir_mutex);
+		return;
+	}
+	pp_reservoirs[res->nid] = NULL;
+	mutex_unlock(&pp_reservoir_mutex);
+
+	while ((page = ptr_ring_consume_bh(&res->ring)))
+		put_page(page);
+	ptr_ring_cleanup(&res->ring, NULL);
+	kfree(res);
+}
+
+static struct page *pp_node_reservoir_consume(struct pp_node_reservoir *res)
+{
+	/* BH protection not needed if current is softirq */
+	if (in_softirq())
+		return ptr_ring_consume(&res->ring);
+	return ptr_ring_consume_bh(&res->ring);
+}
+
+static bool pp_node_reservoir_produce(struct pp_node_reservoir *res,
+				      struct page *page)
+{
+	int ret;
+
+	if (in_softirq())
+		ret = ptr_ring_produce(&res->ring, page);
+	else
+		ret = ptr_ring_produce_bh(&res->ring, page);
+
+	return !ret;
+}
+
 static int page_pool_init(struct page_pool *pool,
 			  const struct page_pool_params *params)
 {
@@ -204,6 +295,10 @@ static int page_pool_init(struct page_pool *pool,
 	    pool->p.flags & PP_FLAG_PAGE_FRAG)
 		return -EINVAL;
 
+	/* the reservoir holds plain order-0 pages only */
+	if (pool->p.flags & PP_FLAG_NODE_RESERVOIR && pool->p.order)
+		return -EINVAL;
+
 #ifdef CONFIG_PAGE_POOL_STATS
 	pool->recycle_stats = alloc_percpu(struct page_pool_recycle_stats);
 	if (!pool->recycle_stats)
@@ -213,6 +308,17 @@ static int page_pool_init(struct page_pool *pool,
 	if (ptr_ring_init(&pool->ring, ring_qsize, GFP_KERNEL) < 0)
 		return -ENOMEM;
 
+	if (pool->p.flags & PP_FLAG_NODE_RESERVOIR) {
+		pool->reservoir = pp_node_reservoir_attach(pool->p.nid);
+		if (!pool->reservoir) {
+			ptr_ring_cleanup(&pool->ring, NULL);
+#ifdef CONFIG_PAGE_POOL_STATS
+			free_percpu(pool->recycle_stats);
+#endif
+			return -ENOMEM;
+		}
+	}
+
 	atomic_set(&pool->pages_state_release_cnt, 0);
 
 	/* Driver calling page_pool_create() also call page_pool_destroy() */
@@ -414,8 +520,22 @@ static struct page *__page_pool_alloc_pages_slow(struct page_pool *pool,
 	/* Mark empty alloc.cache slots "empty" for alloc_pages_bulk_array */
 	memset(&pool->alloc.cache, 0, sizeof(void *) * bulk);
 
-	nr_pages = alloc_pages_bulk_array_node(gfp, pool->p.nid, bulk,
-					       pool->alloc.cache);
+	/* Pull node-local recycled pages from the shared reservoir before
+	 * falling back to the page allocator.
+	 */
+	nr_pages = 0;
+	if (pool->reservoir) {
+		while (nr_pages < bulk) {
+			page = pp_node_reservoir_consume(pool->reservoir);
+			if (!page)
+				break;
+			pool->alloc.cache[nr_pages++] = page;
+		}
+	}
+
+	if (nr_pages < bulk)
+		nr_pages = alloc_pages_bulk_array_node(gfp, pool->p.nid, bulk,
+						       pool->alloc.cache);
 	if (unlikely(!nr_pages))
 		return NULL;
 
@@ -524,8 +644,18 @@ EXPORT_SYMBOL(page_pool_release_page);
 /* Return a page to the page allocator, cleaning up our state */
 static void page_pool_return_page(struct page_pool *pool, struct page *page)
 {
+	struct pp_node_reservoir *res = pool->reservoir;
+
 	page_pool_release_page(pool, page);
 
+	/* The page is a plain page again; park node-local ones in the
+	 * shared reservoir so other pools on this node can reuse them.
+	 */
+	if (res && page_ref_count(page) == 1 && !page_is_pfmemalloc(page) &&
+	    page_to_nid(page) == res->nid &&
+	    pp_node_reservoir_produce(res, page))
+		return;
+
 	put_page(page);
 	/* An optimization would be to call __free_pages(page, pool->p.order)
 	 * knowing page is not part of page-cache (thus avoiding a
@@ -783,6 +913,9 @@ static void page_pool_free(struct page_pool *pool)
 
 	ptr_ring_cleanup(&pool->ring, NULL);
 
+	if (pool->reservoir)
+		pp_node_reservoir_detach(pool->reservoir);
+
 	if (pool->p.flags & PP_FLAG_DMA_MAP)
 		put_device(pool->p.dev);
 
@@ -2160,6 +2160,97 @@ static int rtnl_valid_dump_ifinfo_req(const struct nlmsghdr *nlh,
 				      extack);
 }
 
+/* When net.core.rtnl_link_cache is enabled, unfiltered link dumps are
+ * served from per-device pre-serialized messages instead of running the
+ * full rtnl_fill_ifinfo() for every interface on every poll.  A blob is
+ * rebuilt whenever the device's notification generation moved since it
+ * was cached.
+ */
+int sysctl_rtnl_link_cache __read_mostly;
+
+struct rtnl_link_blob {
+	u32	len;
+	u32	gen;
+	int	stats_off;	/* IFLA_STATS payload offset into data */
+	int	stats64_off;	/* IFLA_STATS64 payload offset into data */
+	u8	data[];
+};
+
+/* Serve one dump entry from @dev's cached message, rebuilding the cache
+ * from the freshly emitted bytes on a generation mismatch.  Must only
+ * be used when the request carries no option that changes the message
+ * contents (no ext filter mask, no target netns).  The netlink header
+ * and both statistics blocks are patched on every copy: statistics
+ * change without generating a link notification, so they can never be
+ * served from the cached bytes.
+ */
+static int rtnl_fill_ifinfo_cached(struct sk_buff *skb,
+				   struct net_device *dev,
+				   u32 portid, u32 seq, unsigned int flags)
+{
+	u32 gen = (u32)atomic_read(&dev->rtnl_blob_gen);
+	struct rtnl_link_blob *blob = dev->rtnl_blob;
+	const struct rtnl_link_stats64 *stats;
+	struct rtnl_link_stats64 temp;
+	struct nlmsghdr *nlh;
+	unsigned char *start;
+
+	ASSERT_RTNL();
+
+	if (!blob || blob->gen != gen) {
+		int start_len = skb->len;
+		struct nlattr *nla;
+		int err, msg_len;
+
+		err = rtnl_fill_ifinfo(skb, dev, dev_net(dev), RTM_NEWLINK,
+				       portid, seq, 0, flags, 0, 0, NULL, 0,
+				       -1, GFP_KERNEL);
+		if (err < 0)
+			return err;
+
+		msg_len = skb->len - start_len;
+		kfree(dev->rtnl_blob);
+		blob = kmalloc(struct_size(blob, data, msg_len), GFP_KERNEL);
+		dev->rtnl_blob = blob;
+		if (!blob)
+			return 0;	/* dumped fine, just not cached */
+
+		blob->len = msg_len;
+		blob->gen = gen;
+		memcpy(blob->data, skb->data + start_len, msg_len);
+
+		nlh = (struct nlmsghdr *)blob->data;
+		blob->stats_off = -1;
+		blob->stats64_off = -1;
+		nla = nlmsg_find_attr(nlh, sizeof(struct ifinfomsg),
+				      IFLA_STATS);
+		if (nla)
+			blob->stats_off = (u8 *)nla_data(nla) - blob->data;
+		nla = nlmsg_find_attr(nlh, sizeof(struct ifinfomsg),
+				      IFLA_STATS64);
+		if (nla)
+			blob->stats64_off = (u8 *)nla_data(nla) - blob->data;
+		return 0;
+	}
+
+	if (skb_tailroom(skb) < blob->len)
+		return -EMSGSIZE;
+
+	start = skb_put_data(skb, blob->data, blob->len);
+	nlh = (struct nlmsghdr *)start;
+	nlh->nlmsg_pid = portid;
+	nlh->nlmsg_seq = seq;
+	nlh->nlmsg_flags = flags;
+
+	stats = dev_get_stats(dev, &temp);
+	if (blob->stats64_off >= 0)
+		memcpy(start + blob->stats64_off, stats, sizeof(*stats));
+	if (blob->stats_off >= 0)
+		copy_rtnl_link_stats((struct rtnl_link_stats *)
+					(start + blob->stats_off), stats);
+	return 0;
+}
+
 static int rtnl_dump_ifinfo(struct sk_buff *skb, struct netlink_callback *cb)
 {
 	struct netlink_ext_ack *extack = cb->extack;
@@ -2232,7 +2323,13 @@ walk_entries:
 				goto cont;
 			if (idx < s_idx)
 				goto cont;
-			err = rtnl_fill_ifinfo(skb, dev, net,
+			if (READ_ONCE(sysctl_rtnl_link_cache) &&
+			    !ext_filter_mask && netnsid < 0)
+				err = rtnl_fill_ifinfo_cached(skb, dev,
+						NETLINK_CB(cb->skb).portid,
+						nlh->nlmsg_seq, flags);
+			else
+				err = rtnl_fill_ifinfo(skb, dev, net,
 					       RTM_NEWLINK,
 					       NETLINK_CB(cb->skb).portid,
 					       nlh->nlmsg_seq, 0, flags,
@@ -4005,6 +4102,9 @@ struct sk_buff *rtmsg_ifinfo_build_skb(int type, struct net_device *dev,
 	int err = -ENOBUFS;
 	u32 seq = 0;
 
+	/* Every link notification invalidates the cached dump message. */
+	atomic_inc(&dev->rtnl_blob_gen);
+
 	skb = nlmsg_new(if_nlmsg_size(dev, 0), flags);
 	if (skb == NULL)
 		goto errout;
@@ -6468,6 +6568,10 @@ static int rtnetlink_event(struct notifier_block *this, unsigned long event, voi
 		rtmsg_ifinfo_event(RTM_NEWLINK, dev, 0, rtnl_get_event(event),
 				   GFP_KERNEL, NULL, 0, 0, NULL);
 		break;
+	case NETDEV_UNREGISTER:
+		kfree(dev->rtnl_blob);
+		dev->rtnl_blob = NULL;
+		break;
 	default:
 		break;
 	}
@@ -140,6 +140,9 @@ drop_reasons_by_subsys[SKB_DROP_REASON_SUBSYS_NUM] = {
 };
 EXPORT_SYMBOL(drop_reasons_by_subsys);
 
+DEFINE_PER_CPU(unsigned long [SKB_DROP_REASON_MAX], skb_drop_counters);
+EXPORT_PER_CPU_SYMBOL(skb_drop_counters);
+
 /**
  * drop_reasons_register_subsys - register another drop reason subsystem
  * @subsys: the subsystem to register, must not be the core
@@ -329,6 +332,20 @@ void *__netdev_alloc_frag_align(unsigned int fragsz, unsigned int align_mask)
 }
 EXPORT_SYMBOL(__netdev_alloc_frag_align);
 
+static void napi_skb_cache_put(struct sk_buff *skb);
+
+/*
+ * The NAPI skb cache is protected only by softirq exclusion: it may be
+ * used from softirq context with hardirqs enabled, where it cannot be
+ * re-entered.  A hardirq interrupting the cache update observes
+ * in_hardirq() and falls back to slab, as do callers running with irqs
+ * disabled on top of softirq.
+ */
+static bool napi_skb_cache_usable(void)
+{
+	return !in_hardirq() && !irqs_disabled() && in_serving_softirq();
+}
+
 static struct sk_buff *napi_skb_cache_get(void)
 {
 	struct napi_alloc_cache *nc = this_cpu_ptr(&napi_alloc_cache);
@@ -968,7 +985,17 @@ static void kfree_skbmem(struct sk_buff *skb)
 
 	switch (skb->fclone) {
 	case SKB_FCLONE_UNAVAILABLE:
-		kmem_cache_free(skbuff_cache, skb);
+		/*
+		 * Forwarded skbs are mostly freed from softirq context.
+		 * Recycle them through the per-CPU NAPI cache so that the
+		 * next napi_build_skb()/skb_clone() on this CPU doesn't
+		 * have to go back to slab; the cache flushes its upper
+		 * half to slab when full.
+		 */
+		if (napi_skb_cache_usable())
+			napi_skb_cache_put(skb);
+		else
+			kmem_cache_free(skbuff_cache, skb);
 		return;
 
 	case SKB_FCLONE_ORIG:
@@ -1041,10 +1068,17 @@ bool __kfree_skb_reason(struct sk_buff *skb, enum skb_drop_reason reason)
 					    SKB_DROP_REASON_SUBSYS_MASK) >=
 				SKB_DROP_REASON_SUBSYS_NUM);
 
-	if (reason == SKB_CONSUMED)
+	if (reason == SKB_CONSUMED) {
 		trace_consume_skb(skb, __builtin_return_address(0));
-	else
+	} else {
+		/* Core reasons occupy [0, SKB_DROP_REASON_MAX); subsystem
+		 * reasons carry their subsystem in the upper bits and are
+		 * not accounted here.
+		 */
+		if (likely(reason < SKB_DROP_REASON_MAX))
+			this_cpu_inc(skb_drop_counters[reason]);
 		trace_kfree_skb(skb, __builtin_return_address(0), reason);
+	}
 	return true;
 }
 
@@ -1869,7 +1903,17 @@ struct sk_buff *skb_clone(struct sk_buff *skb, gfp_t gfp_mask)
 		if (skb_pfmemalloc(skb))
 			gfp_mask |= __GFP_MEMALLOC;
 
-		n = kmem_cache_alloc(skbuff_cache, gfp_mask);
+		/*
+		 * Clones made while forwarding in softirq context can reuse
+		 * skbs recycled by kfree_skbmem()/napi_consume_skb() on this
+		 * CPU.  The cache holds plain GFP_ATOMIC objects, so don't
+		 * use it for pfmemalloc-entitled allocations.
+		 */
+		n = NULL;
+		if (!(gfp_mask & __GFP_MEMALLOC) && napi_skb_cache_usable())
+			n = napi_skb_cache_get();
+		if (!n)
+			n = kmem_cache_alloc(skbuff_cache, gfp_mask);
 		if (!n)
 			return NULL;
 
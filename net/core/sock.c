@@ -664,6 +664,81 @@ int sock_bindtoindex(struct sock *sk, int ifindex, bool lock_sk)
 }
 EXPORT_SYMBOL(sock_bindtoindex);
 
+void sk_send_template_put(struct sk_send_template *tmpl)
+{
+	u32 i;
+
+	if (!tmpl || !refcount_dec_and_test(&tmpl->ref))
+		return;
+
+	for (i = 0; i < tmpl->nr_pages; i++)
+		put_page(tmpl->pages[i]);
+	kfree(tmpl);
+}
+EXPORT_SYMBOL(sk_send_template_put);
+
+/* Register the blob passed as option value as the socket's send
+ * template, replacing any previous one.  The bytes are copied once
+ * into kernel pages here; sends referencing the template attach those
+ * pages as frags without further copies.  A zero option length drops
+ * the registration.
+ */
+static int sock_set_sendtemplate(struct sock *sk, sockptr_t optval,
+				 int optlen)
+{
+	struct sk_send_template *tmpl = NULL, *old;
+	u32 nr_pages, i;
+	int err;
+
+	if (optlen < 0 || optlen > SK_SEND_TEMPLATE_MAX)
+		return -EINVAL;
+
+	if (optlen) {
+		int off;
+
+		nr_pages = DIV_ROUND_UP(optlen, PAGE_SIZE);
+		tmpl = kzalloc(struct_size(tmpl, pages, nr_pages),
+			       GFP_KERNEL);
+		if (!tmpl)
+			return -ENOMEM;
+
+		refcount_set(&tmpl->ref, 1);
+		tmpl->len = optlen;
+		tmpl->nr_pages = nr_pages;
+		err = -ENOMEM;
+		for (i = 0; i < nr_pages; i++) {
+			tmpl->pages[i] = alloc_page(GFP_KERNEL);
+			if (!tmpl->pages[i])
+				goto err_free;
+		}
+
+		err = -EFAULT;
+		for (off = 0, i = 0; off < optlen; off += PAGE_SIZE, i++) {
+			int chunk = min_t(int, optlen - off, PAGE_SIZE);
+
+			if (copy_from_sockptr_offset(page_address(tmpl->pages[i]),
+						     optval, off, chunk))
+				goto err_free;
+		}
+	}
+
+	lock_sock(sk);
+	old = sk->sk_send_template;
+	sk->sk_send_template = tmpl;
+	release_sock(sk);
+
+	sk_send_template_put(old);
+	return 0;
+
+err_free:
+	for (i = 0; i < nr_pages; i++) {
+		if (tmpl->pages[i])
+			put_page(tmpl->pages[i]);
+	}
+	kfree(tmpl);
+	return err;
+}
+
 static int sock_setbindtodevice(struct sock *sk, sockptr_t optval, int optlen)
 {
 	int ret = -ENOPROTOOPT;
@@ -1102,6 +1177,9 @@ int sk_setsockopt(struct sock *sk, int level, int optname,
 	if (optname == SO_BINDTODEVICE)
 		return sock_setbindtodevice(sk, optval, optlen);
 
+	if (optname == SO_SENDTEMPLATE)
+		return sock_set_sendtemplate(sk, optval, optlen);
+
 	if (optlen < sizeof(int))
 		return -EINVAL;
 
@@ -1808,6 +1886,16 @@ int sk_getsockopt(struct sock *sk, int level, int optname,
 		v.val = sock_flag(sk, SOCK_RCVMARK);
 		break;
 
+	case SO_SENDTEMPLATE: {
+		/* Read the pointer once; setsockopt may clear it at any
+		 * time and a second load could see NULL after the test.
+		 */
+		struct sk_send_template *tmpl = READ_ONCE(sk->sk_send_template);
+
+		v.val = tmpl ? tmpl->len : 0;
+		break;
+	}
+
 	case SO_RXQ_OVFL:
 		v.val = sock_flag(sk, SOCK_RXQ_OVFL);
 		break;
@@ -2151,6 +2239,11 @@ static void __sk_destruct(struct rcu_head *head)
 		sk->sk_frag.page = NULL;
 	}
 
+	if (sk->sk_send_template) {
+		sk_send_template_put(sk->sk_send_template);
+		sk->sk_send_template = NULL;
+	}
+
 	/* We do not need to acquire sk->sk_peer_lock, we are the last user. */
 	put_cred(sk->sk_peer_cred);
 	put_pid(sk->sk_peer_pid);
@@ -2283,6 +2376,10 @@ struct sock *sk_clone_lock(const struct sock *sk, const gfp_t priority)
 
 	sock_reset_flag(newsk, SOCK_DONE);
 
+	/* Accepted children share the listener's send template. */
+	if (newsk->sk_send_template)
+		sk_send_template_hold(newsk->sk_send_template);
+
 	/* sk->sk_memcg will be populated at accept() time */
 	newsk->sk_memcg = NULL;
 
@@ -2772,6 +2869,24 @@ int __sock_cmsg_send(struct sock *sk, struct cmsghdr *cmsg,
 			return -EINVAL;
 		sockc->transmit_time = get_unaligned((u64 *)CMSG_DATA(cmsg));
 		break;
+	case SO_SENDTEMPLATE: {
+		struct so_sendtemplate_ref ref;
+
+		/* Range validation against the template happens under the
+		 * socket lock in the protocol's sendmsg; only protocols
+		 * that consume tmpl_len support the option.
+		 */
+		if (cmsg->cmsg_len != CMSG_LEN(sizeof(ref)))
+			return -EINVAL;
+		if (!READ_ONCE(sk->sk_send_template))
+			return -EINVAL;
+		memcpy(&ref, CMSG_DATA(cmsg), sizeof(ref));
+		if (!ref.len || ref.off > U32_MAX - ref.len)
+			return -EINVAL;
+		sockc->tmpl_off = ref.off;
+		sockc->tmpl_len = ref.len;
+		break;
+	}
 	/* SCM_RIGHTS and SCM_CREDENTIALS are semantically in SOL_UNIX. */
 	case SCM_RIGHTS:
 	case SCM_CREDENTIALS:
@@ -2964,6 +3079,60 @@ int sk_wait_data(struct sock *sk, long *timeo, const struct sk_buff *skb)
 }
 EXPORT_SYMBOL(sk_wait_data);
 
+/* Writes to the protocol-wide memory_allocated atomic are already
+ * batched through the per-CPU forward-alloc reserves, but every buffer
+ * grow still read that cacheline to compare against the pressure
+ * thresholds, and with enough sockets the fleet-wide sharing of the
+ * line shows up on profiles.  Cache the last-read value per CPU and
+ * per counter, and serve the threshold comparison from the cache while
+ * the protocol is comfortably below its low watermark; once the cached
+ * value reaches the watermark, go back to reading the atomic, so
+ * entering and leaving pressure always works against a fresh
+ * aggregate.  A cached read can be stale by at most one jiffy, which
+ * matches the advisory nature of the pressure machinery (see the
+ * comment above memory_pressure in struct proto).
+ */
+#define SK_MEM_CACHE_SLOTS	2
+
+struct sk_mem_cache {
+	atomic_long_t	*src;
+	long		val;
+	unsigned long	stamp;
+	unsigned int	hand;
+};
+
+static DEFINE_PER_CPU(struct sk_mem_cache[SK_MEM_CACHE_SLOTS],
+		      sk_mem_cache);
+
+static long sk_memory_allocated_cached(const struct sock *sk)
+{
+	atomic_long_t *src = sk->sk_prot->memory_allocated;
+	long limit = sk_prot_mem_limits(sk, 0);
+	struct sk_mem_cache *cache;
+	long val;
+	int i;
+
+	preempt_disable();
+	cache = this_cpu_ptr(sk_mem_cache);
+	for (i = 0; i < SK_MEM_CACHE_SLOTS; i++) {
+		if (cache[i].src == src)
+			break;
+	}
+	if (i == SK_MEM_CACHE_SLOTS) {
+		i = cache[0].hand++ % SK_MEM_CACHE_SLOTS;
+		cache[i].src = src;
+		cache[i].stamp = 0;
+	}
+	if (cache[i].stamp != jiffies || cache[i].val >= limit) {
+		cache[i].val = atomic_long_read(src);
+		cache[i].stamp = jiffies;
+	}
+	val = cache[i].val;
+	preempt_enable();
+
+	return val;
+}
+
 /**
  *	__sk_mem_raise_allocated - increase memory_allocated
  *	@sk: socket
@@ -2981,7 +3150,7 @@ int __sk_mem_raise_allocated(struct sock *sk, int size, int amt, int kind)
 	long allocated;
 
 	sk_memory_allocated_add(sk, amt);
-	allocated = sk_memory_allocated(sk);
+	allocated = sk_memory_allocated_cached(sk);
 	if (memcg_charge &&
 	    !(charged = mem_cgroup_charge_skmem(sk->sk_memcg, amt,
 						gfp_memcg_charge())))
@@ -12,6 +12,7 @@
 #include <linux/module.h>
 #include <linux/socket.h>
 #include <linux/netdevice.h>
+#include <linux/rtnetlink.h>
 #include <linux/ratelimit.h>
 #include <linux/vmalloc.h>
 #include <linux/init.h>
@@ -653,6 +654,15 @@ static struct ctl_table net_core_table[] = {
 		.proc_handler	= proc_dointvec_minmax,
 		.extra1		= SYSCTL_ZERO,
 	},
+	{
+		.procname	= "rtnl_link_cache",
+		.data		= &sysctl_rtnl_link_cache,
+		.maxlen		= sizeof(int),
+		.mode		= 0644,
+		.proc_handler	= proc_dointvec_minmax,
+		.extra1		= SYSCTL_ZERO,
+		.extra2		= SYSCTL_ONE,
+	},
 	{ }
 };
 
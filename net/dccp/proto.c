@@ -1122,7 +1122,8 @@ static int __init dccp_init(void)
 	dccp_hashinfo.bind_bucket_cachep =
 		kmem_cache_create("dccp_bind_bucket",
 				  sizeof(struct inet_bind_bucket), 0,
-				  SLAB_HWCACHE_ALIGN | SLAB_ACCOUNT, NULL);
+				  SLAB_HWCACHE_ALIGN | SLAB_ACCOUNT |
+				  SLAB_TYPESAFE_BY_RCU, NULL);
 	if (!dccp_hashinfo.bind_bucket_cachep)
 		goto out_free_hashinfo2;
 	dccp_hashinfo.bind2_bucket_cachep =
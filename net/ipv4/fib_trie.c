@@ -59,6 +59,7 @@
 #include <linux/slab.h>
 #include <linux/export.h>
 #include <linux/vmalloc.h>
+#include <linux/math64.h>
 #include <linux/notifier.h>
 #include <net/net_namespace.h>
 #include <net/inet_dscp.h>
@@ -168,6 +169,8 @@ struct trie {
 #ifdef CONFIG_IP_FIB_TRIE_STATS
 	struct trie_use_stats __percpu *stats;
 #endif
+	/* optional DIR-24 compiled lookup array, see fib_dir24_update() */
+	struct fib_dir24 __rcu *dir24;
 };
 
 static struct key_vector *resize(struct trie *t, struct key_vector *tn);
@@ -1012,6 +1015,218 @@ static struct fib_alias *fib_find_alias(struct hlist_head *fah, u8 slen,
 	return NULL;
 }
 
+/* DIR-24 compiled lookup array.
+ *
+ * When net.ipv4.fib_dir24 is enabled, the main table's trie is shadowed
+ * by a flat array with one entry per /24 of the address space, holding
+ * the leaf of the longest prefix (of length <= 24) covering that /24.
+ * The data path resolves most destinations with a single indexed load
+ * instead of 6-8 dependent trie node fetches; slots covered by any
+ * prefix longer than /24 are marked so lookups there fall back to the
+ * trie walk.  The trie remains the control structure: route updates
+ * repaint only the slot range their prefix covers, re-deriving the
+ * entries from the trie itself.
+ *
+ * All updates run under RTNL.  Entries are leaf pointers published with
+ * rcu_assign_pointer(); leaves are freed by call_rcu() only after the
+ * repaint that drops the last compiled reference, so a reader can at
+ * worst see the previous route during an update, the same transient the
+ * trie itself exhibits.
+ */
+#define DIR24_SLOTS		(1u << 24)
+#define DIR24_DEPTH_EMPTY	0xff	/* no route covers this /24 */
+#define DIR24_DEPTH_FB		0xfe	/* covered by a prefix longer
+					 * than /24: use the trie walk
+					 */
+
+struct fib_dir24 {
+	struct key_vector __rcu	**slots;	/* LPM leaf per /24 */
+	u8			*depths;	/* its prefix length */
+	u64			rebuild_ns;	/* last full rebuild cost */
+	u64			updates;	/* incremental repaints */
+};
+
+static struct key_vector *leaf_walk_rcu(struct key_vector **tn, t_key key);
+
+/* Re-derive the compiled entries for the /24 slots covered by key/plen
+ * from the trie, which already reflects the route change.
+ */
+static void fib_dir24_paint(struct trie *t, struct fib_dir24 *dir24,
+			    u32 key, u8 plen)
+{
+	struct key_vector *base = NULL, *l, *tp;
+	u8 base_depth = DIR24_DEPTH_EMPTY;
+	u32 start, nslots, i;
+	u64 end;
+	int d;
+
+	if (plen > 24) {
+		key &= 0xffffff00;
+		plen = 24;
+	}
+	start = key >> 8;
+	nslots = 1u << (24 - plen);
+	end = (u64)key + ((u64)nslots << 8);
+
+	/* The longest prefix shorter than plen covering the whole range,
+	 * if any; it is the starting point every slot falls back to.
+	 */
+	for (d = plen - 1; d >= 0; d--) {
+		u32 k = d ? key & (~0U << (KEYLENGTH - d)) : 0;
+		struct fib_alias *fa;
+
+		l = fib_find_node(t, &tp, k);
+		if (!l)
+			continue;
+		hlist_for_each_entry(fa, &l->leaf, fa_list) {
+			if (fa->fa_slen == KEYLENGTH - d) {
+				base = l;
+				base_depth = d;
+				break;
+			}
+		}
+		if (base)
+			break;
+	}
+
+	for (i = 0; i < nslots; i++) {
+		rcu_assign_pointer(dir24->slots[start + i], base);
+		dir24->depths[start + i] = base_depth;
+	}
+
+	/* Paint every prefix inside the range, longest prefix winning;
+	 * order does not matter because of the depth comparison.
+	 */
+	tp = t->kv;
+	while ((l = leaf_walk_rcu(&tp, key)) != NULL) {
+		struct fib_alias *fa;
+
+		if ((u64)l->key >= end)
+			break;
+
+		hlist_for_each_entry(fa, &l->leaf, fa_list) {
+			u32 slot = l->key >> 8;
+			u64 pend;
+
+			if (fa->fa_slen < 8) {
+				rcu_assign_pointer(dir24->slots[slot], NULL);
+				dir24->depths[slot] = DIR24_DEPTH_FB;
+				continue;
+			}
+
+			d = KEYLENGTH - fa->fa_slen;
+			pend = min(end, (u64)l->key + (1ull << fa->fa_slen));
+			for (; slot < (u32)(pend >> 8); slot++) {
+				u8 cur = dir24->depths[slot];
+
+				if (cur == DIR24_DEPTH_FB ||
+				    (cur != DIR24_DEPTH_EMPTY && cur > d))
+					continue;
+				rcu_assign_pointer(dir24->slots[slot], l);
+				dir24->depths[slot] = d;
+			}
+		}
+
+		key = l->key + 1;
+		if (key < l->key)
+			break;
+	}
+}
+
+static void fib_dir24_free(struct fib_dir24 *dir24)
+{
+	vfree(dir24->slots);
+	vfree(dir24->depths);
+	kfree(dir24);
+}
+
+/* Called before leaves in the range may be unlinked (and queued for
+ * call_rcu freeing) by a route removal.  Forcing the range to the trie
+ * walk first guarantees no reader can pick up a compiled pointer to a
+ * leaf whose grace period has already started; the repaint after the
+ * removal restores the fast path.
+ */
+static void fib_dir24_invalidate(struct trie *t, u32 key, u8 plen)
+{
+	struct fib_dir24 *dir24 = rtnl_dereference(t->dir24);
+	u32 start, nslots, i;
+
+	if (!dir24)
+		return;
+
+	if (plen > 24) {
+		key &= 0xffffff00;
+		plen = 24;
+	}
+	start = key >> 8;
+	nslots = 1u << (24 - plen);
+
+	for (i = 0; i < nslots; i++) {
+		WRITE_ONCE(dir24->depths[start + i], DIR24_DEPTH_FB);
+		RCU_INIT_POINTER(dir24->slots[start + i], NULL);
+	}
+}
+
+/* Route change hook, called under RTNL once the trie is updated.  Also
+ * the place where the array is lazily built or torn down when the
+ * sysctl changed, so toggling it takes effect on the next route update.
+ */
+static void fib_dir24_update(struct net *net, struct fib_table *tb,
+			     u32 key, u8 plen)
+{
+	struct trie *t = (struct trie *)tb->tb_data;
+	struct fib_dir24 *dir24 = rtnl_dereference(t->dir24);
+	u64 start;
+
+	if (dir24) {
+		if (!READ_ONCE(net->ipv4.sysctl_fib_dir24)) {
+			RCU_INIT_POINTER(t->dir24, NULL);
+			synchronize_rcu();
+			fib_dir24_free(dir24);
+			return;
+		}
+		fib_dir24_paint(t, dir24, key, plen);
+		dir24->updates++;
+		return;
+	}
+
+	if (tb->tb_id != RT_TABLE_MAIN ||
+	    !READ_ONCE(net->ipv4.sysctl_fib_dir24))
+		return;
+
+	dir24 = kzalloc(sizeof(*dir24), GFP_KERNEL);
+	if (!dir24)
+		return;
+	dir24->slots = vzalloc(array_size(DIR24_SLOTS,
+					  sizeof(*dir24->slots)));
+	dir24->depths = vmalloc(DIR24_SLOTS);
+	if (!dir24->slots || !dir24->depths) {
+		fib_dir24_free(dir24);
+		return;
+	}
+	memset(dir24->depths, DIR24_DEPTH_EMPTY, DIR24_SLOTS);
+
+	start = ktime_get_ns();
+	fib_dir24_paint(t, dir24, 0, 0);
+	dir24->rebuild_ns = ktime_get_ns() - start;
+
+	rcu_assign_pointer(t->dir24, dir24);
+}
+
+/* Bulk removals (table flush) just repaint everything. */
+static void fib_dir24_rebuild(struct trie *t)
+{
+	struct fib_dir24 *dir24 = rtnl_dereference(t->dir24);
+	u64 start;
+
+	if (!dir24)
+		return;
+
+	start = ktime_get_ns();
+	fib_dir24_paint(t, dir24, 0, 0);
+	dir24->rebuild_ns = ktime_get_ns() - start;
+}
+
 static struct fib_alias *
 fib_find_matching_alias(struct net *net, const struct fib_rt_info *fri)
 {
@@ -1404,6 +1619,7 @@ int fib_table_insert(struct net *net, struct fib_table *tb,
 	rtmsg_fib(RTM_NEWROUTE, htonl(key), new_fa, plen, new_fa->tb_id,
 		  &cfg->fc_nlinfo, nlflags);
 succeeded:
+	fib_dir24_update(net, tb, key, plen);
 	return 0;
 
 out_remove_new_fa:
@@ -1450,7 +1666,9 @@ int fib_table_lookup(struct fib_table *tb, const struct flowi4 *flp,
 #endif
 	const t_key key = ntohl(flp->daddr);
 	struct key_vector *n, *pn;
+	struct fib_dir24 *dir24;
 	struct fib_alias *fa;
+	bool compiled = false;
 	unsigned long index;
 	t_key cindex;
 
@@ -1467,6 +1685,27 @@ int fib_table_lookup(struct fib_table *tb, const struct flowi4 *flp,
 	this_cpu_inc(stats->gets);
 #endif
 
+	dir24 = rcu_dereference(t->dir24);
+	if (dir24) {
+		u8 d = READ_ONCE(dir24->depths[key >> 8]);
+
+		if (d == DIR24_DEPTH_EMPTY) {
+			trace_fib_table_lookup(tb->tb_id, flp, NULL, -EAGAIN);
+			return -EAGAIN;
+		}
+		if (d != DIR24_DEPTH_FB) {
+			struct key_vector *dl;
+
+			dl = rcu_dereference(dir24->slots[key >> 8]);
+			if (dl) {
+				n = dl;
+				compiled = true;
+				goto found;
+			}
+		}
+	}
+
+walk:
 	/* Step 1: Travel to the longest prefix match in the trie */
 	for (;;) {
 		index = get_cindex(key, n);
@@ -1642,6 +1881,20 @@ miss:
 #ifdef CONFIG_IP_FIB_TRIE_STATS
 	this_cpu_inc(stats->semantic_match_miss);
 #endif
+	if (unlikely(compiled)) {
+		/* The compiled leaf failed the semantic match; shorter
+		 * prefixes may still match, so take the full trie walk.
+		 */
+		compiled = false;
+		pn = t->kv;
+		cindex = 0;
+		n = get_child_rcu(pn, cindex);
+		if (!n) {
+			trace_fib_table_lookup(tb->tb_id, flp, NULL, -EAGAIN);
+			return -EAGAIN;
+		}
+		goto walk;
+	}
 	goto backtrace;
 }
 EXPORT_SYMBOL_GPL(fib_table_lookup);
@@ -1769,11 +2022,14 @@ int fib_table_delete(struct net *net, struct fib_table *tb,
 	if (!plen)
 		tb->tb_num_default--;
 
+	fib_dir24_invalidate(t, key, plen);
 	fib_remove_alias(t, tp, l, fa_to_delete);
 
 	if (fa_to_delete->fa_state & FA_S_ACCESSED)
 		rt_cache_flush(cfg->fc_nlinfo.nl_net);
 
+	fib_dir24_update(net, tb, key, plen);
+
 	fib_release_info(fa_to_delete->fa_info);
 	alias_free_mem_rcu(fa_to_delete);
 	return 0;
@@ -1962,6 +2218,8 @@ void fib_table_flush_external(struct fib_table *tb)
 	struct hlist_node *tmp;
 	struct fib_alias *fa;
 
+	fib_dir24_invalidate(t, 0, 0);
+
 	/* walk trie in reverse order */
 	for (;;) {
 		unsigned char slen = 0;
@@ -2020,6 +2278,8 @@ void fib_table_flush_external(struct fib_table *tb)
 			node_free(n);
 		}
 	}
+
+	fib_dir24_rebuild(t);
 }
 
 /* Caller must hold RTNL. */
@@ -2032,6 +2292,8 @@ int fib_table_flush(struct net *net, struct fib_table *tb, bool flush_all)
 	struct fib_alias *fa;
 	int found = 0;
 
+	fib_dir24_invalidate(t, 0, 0);
+
 	/* walk trie in reverse order */
 	for (;;) {
 		unsigned char slen = 0;
@@ -2103,6 +2365,8 @@ int fib_table_flush(struct net *net, struct fib_table *tb, bool flush_all)
 		}
 	}
 
+	fib_dir24_rebuild(t);
+
 	pr_debug("trie_flush found=%d\n", found);
 	return found;
 }
@@ -2246,12 +2510,17 @@ int fib_notify(struct net *net, struct notifier_block *nb,
 static void __trie_free_rcu(struct rcu_head *head)
 {
 	struct fib_table *tb = container_of(head, struct fib_table, rcu);
-#ifdef CONFIG_IP_FIB_TRIE_STATS
 	struct trie *t = (struct trie *)tb->tb_data;
 
-	if (tb->tb_data == tb->__data)
+	if (tb->tb_data == tb->__data) {
+		struct fib_dir24 *dir24 = rcu_dereference_protected(t->dir24, 1);
+
+#ifdef CONFIG_IP_FIB_TRIE_STATS
 		free_percpu(t->stats);
 #endif /* CONFIG_IP_FIB_TRIE_STATS */
+		if (dir24)
+			fib_dir24_free(dir24);
+	}
 	kfree(tb);
 }
 
@@ -2645,6 +2914,7 @@ static int fib_triestat_seq_show(struct seq_file *seq, void *v)
 
 		hlist_for_each_entry_rcu(tb, head, tb_hlist) {
 			struct trie *t = (struct trie *) tb->tb_data;
+			struct fib_dir24 *dir24;
 			struct trie_stat stat;
 
 			if (!t)
@@ -2657,6 +2927,14 @@ static int fib_triestat_seq_show(struct seq_file *seq, void *v)
 #ifdef CONFIG_IP_FIB_TRIE_STATS
 			trie_show_usage(seq, t->stats);
 #endif
+			dir24 = rcu_dereference(t->dir24);
+			if (dir24)
+				seq_printf(seq,
+					   "DIR-24 compiled: %zu KiB, last rebuild %llu us, %llu incremental updates\n",
+					   (DIR24_SLOTS *
+					    (sizeof(*dir24->slots) + 1)) >> 10,
+					   div_u64(dir24->rebuild_ns, 1000),
+					   dir24->updates);
 		}
 		cond_resched_rcu();
 	}
@@ -16,6 +16,7 @@
 #include <linux/skbuff.h>
 #include <linux/rtnetlink.h>
 #include <linux/slab.h>
+#include <linux/jhash.h>
 #include <linux/rhashtable.h>
 
 #include <net/sock.h>
@@ -146,6 +147,25 @@ static void inet_frags_free_cb(void *ptr, void *arg)
 		inet_frag_destroy(fq);
 }
 
+/* Every family hashes its lookup key through rhash_params, so reuse
+ * that hash (with a seed of our own) to pick the partition a queue
+ * lives in; a given flow always maps to the same table.
+ */
+static u32 fqdir_key_hash(struct fqdir *fqdir, const void *key)
+{
+	const struct rhashtable_params *p = &fqdir->f->rhash_params;
+
+	if (p->hashfn)
+		return p->hashfn(key, p->key_len, fqdir->part_seed);
+	return jhash(key, p->key_len, fqdir->part_seed);
+}
+
+static struct rhashtable *fqdir_partition(struct fqdir *fqdir, const void *key)
+{
+	return &fqdir->rhashtable[fqdir_key_hash(fqdir, key) &
+				  (FQDIR_HASH_PARTITIONS - 1)];
+}
+
 static LLIST_HEAD(fqdir_free_list);
 
 static void fqdir_free_fn(struct work_struct *work)
@@ -177,8 +197,11 @@ static DECLARE_WORK(fqdir_free_work, fqdir_free_fn);
 static void fqdir_work_fn(struct work_struct *work)
 {
 	struct fqdir *fqdir = container_of(work, struct fqdir, destroy_work);
+	int i;
 
-	rhashtable_free_and_destroy(&fqdir->rhashtable, inet_frags_free_cb, NULL);
+	for (i = 0; i < FQDIR_HASH_PARTITIONS; i++)
+		rhashtable_free_and_destroy(&fqdir->rhashtable[i],
+					    inet_frags_free_cb, NULL);
 
 	if (llist_add(&fqdir->free_list, &fqdir_free_list))
 		queue_work(system_wq, &fqdir_free_work);
@@ -187,16 +210,22 @@ static void fqdir_work_fn(struct work_struct *work)
 int fqdir_init(struct fqdir **fqdirp, struct inet_frags *f, struct net *net)
 {
 	struct fqdir *fqdir = kzalloc(sizeof(*fqdir), GFP_KERNEL);
-	int res;
+	int res, i;
 
 	if (!fqdir)
 		return -ENOMEM;
 	fqdir->f = f;
 	fqdir->net = net;
-	res = rhashtable_init(&fqdir->rhashtable, &fqdir->f->rhash_params);
-	if (res < 0) {
-		kfree(fqdir);
-		return res;
+	fqdir->part_seed = get_random_u32();
+	for (i = 0; i < FQDIR_HASH_PARTITIONS; i++) {
+		res = rhashtable_init(&fqdir->rhashtable[i],
+				      &fqdir->f->rhash_params);
+		if (res < 0) {
+			while (--i >= 0)
+				rhashtable_destroy(&fqdir->rhashtable[i]);
+			kfree(fqdir);
+			return res;
+		}
 	}
 	refcount_inc(&f->refcnt);
 	*fqdirp = fqdir;
@@ -239,7 +268,8 @@ void inet_frag_kill(struct inet_frag_queue *fq)
 		 * after we unlock.  Paired with fqdir_pre_exit().
 		 */
 		if (!READ_ONCE(fqdir->dead)) {
-			rhashtable_remove_fast(&fqdir->rhashtable, &fq->node,
+			rhashtable_remove_fast(fqdir_partition(fqdir, &fq->key),
+					       &fq->node,
 					       fqdir->f->rhash_params);
 			refcount_dec(&fq->refcnt);
 		} else {
@@ -300,6 +330,9 @@ void inet_frag_destroy(struct inet_frag_queue *q)
 	/* Release all fragment data. */
 	fqdir = q->fqdir;
 	f = fqdir->f;
+	if (q->flags & INET_FRAG_DROP)
+		atomic_long_inc(&fqdir->evictions[fqdir_key_hash(fqdir, &q->key) &
+						  (FQDIR_HASH_PARTITIONS - 1)]);
 	sum_truesize = inet_frag_rbtree_purge(&q->rb_fragments, reason);
 	sum = sum_truesize + f->qsize;
 
@@ -331,6 +364,7 @@ static struct inet_frag_queue *inet_frag_alloc(struct fqdir *fqdir,
 }
 
 static struct inet_frag_queue *inet_frag_create(struct fqdir *fqdir,
+						struct rhashtable *ht,
 						void *arg,
 						struct inet_frag_queue **prev)
 {
@@ -344,7 +378,7 @@ static struct inet_frag_queue *inet_frag_create(struct fqdir *fqdir,
 	}
 	mod_timer(&q->timer, jiffies + fqdir->timeout);
 
-	*prev = rhashtable_lookup_get_insert_key(&fqdir->rhashtable, &q->key,
+	*prev = rhashtable_lookup_get_insert_key(ht, &q->key,
 						 &q->node, f->rhash_params);
 	if (*prev) {
 		q->flags |= INET_FRAG_COMPLETE;
@@ -361,15 +395,17 @@ struct inet_frag_queue *inet_frag_find(struct fqdir *fqdir, void *key)
 	/* This pairs with WRITE_ONCE() in fqdir_pre_exit(). */
 	long high_thresh = READ_ONCE(fqdir->high_thresh);
 	struct inet_frag_queue *fq = NULL, *prev;
+	struct rhashtable *ht;
 
 	if (!high_thresh || frag_mem_limit(fqdir) > high_thresh)
 		return NULL;
 
 	rcu_read_lock();
 
-	prev = rhashtable_lookup(&fqdir->rhashtable, key, fqdir->f->rhash_params);
+	ht = fqdir_partition(fqdir, key);
+	prev = rhashtable_lookup(ht, key, fqdir->f->rhash_params);
 	if (!prev)
-		fq = inet_frag_create(fqdir, key, &prev);
+		fq = inet_frag_create(fqdir, ht, key, &prev);
 	if (!IS_ERR_OR_NULL(prev)) {
 		fq = prev;
 		if (!refcount_inc_not_zero(&fq->refcnt))
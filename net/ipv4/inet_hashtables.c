@@ -76,7 +76,7 @@ struct inet_bind_bucket *inet_bind_bucket_create(struct kmem_cache *cachep,
 		tb->fastreuse = 0;
 		tb->fastreuseport = 0;
 		INIT_HLIST_HEAD(&tb->owners);
-		hlist_add_head(&tb->node, &head->chain);
+		hlist_add_head_rcu(&tb->node, &head->chain);
 	}
 	return tb;
 }
@@ -87,7 +87,7 @@ struct inet_bind_bucket *inet_bind_bucket_create(struct kmem_cache *cachep,
 void inet_bind_bucket_destroy(struct kmem_cache *cachep, struct inet_bind_bucket *tb)
 {
 	if (hlist_empty(&tb->owners)) {
-		__hlist_del(&tb->node);
+		hlist_del_rcu(&tb->node);
 		kmem_cache_free(cachep, tb);
 	}
 }
@@ -99,6 +99,33 @@ bool inet_bind_bucket_match(const struct inet_bind_bucket *tb, const struct net
 		tb->l3mdev == l3mdev;
 }
 
+/* Lockless pre-screen of a candidate ephemeral port.  The bind bucket
+ * caches are SLAB_TYPESAFE_BY_RCU, so a bucket may be recycled while we
+ * look at it and the answer is only a hint: a false negative makes the
+ * caller take the bucket lock and re-check as before, a false positive
+ * makes it skip one usable port.  Returns true when the port is held by
+ * sockets that can never share it with a connect (bound listeners,
+ * i.e. fastreuse/fastreuseport have been evaluated).
+ */
+bool inet_bind_bucket_fast_conflict(const struct inet_bind_hashbucket *head,
+				    const struct net *net,
+				    unsigned short port, int l3mdev)
+{
+	const struct inet_bind_bucket *tb;
+	bool conflict = false;
+
+	rcu_read_lock();
+	hlist_for_each_entry_rcu(tb, &head->chain, node) {
+		if (inet_bind_bucket_match(tb, net, port, l3mdev)) {
+			conflict = READ_ONCE(tb->fastreuse) >= 0 ||
+				   READ_ONCE(tb->fastreuseport) >= 0;
+			break;
+		}
+	}
+	rcu_read_unlock();
+	return conflict;
+}
+
 static void inet_bind2_bucket_init(struct inet_bind2_bucket *tb,
 				   struct net *net,
 				   struct inet_bind_hashbucket *head,
@@ -1045,6 +1072,15 @@ other_parity_scan:
 			continue;
 		head = &hinfo->bhash[inet_bhashfn(net, port,
 						  hinfo->bhash_size)];
+
+		/* Ports held by bound listeners are rejected without the
+		 * bucket lock; the locked scan below re-checks any port
+		 * that looks usable.
+		 */
+		if (inet_bind_bucket_fast_conflict(head, net, port, l3mdev)) {
+			cond_resched();
+			continue;
+		}
 		spin_lock_bh(&head->lock);
 
 		/* Does not bother with rcv_saddr checks, because
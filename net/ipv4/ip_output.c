@@ -496,6 +496,8 @@ int __ip_queue_xmit(struct sock *sk, struct sk_buff *skb, struct flowi *fl,
 		if (IS_ERR(rt))
 			goto no_route;
 		sk_setup_caps(sk, &rt->dst);
+		/* new route, never trust a leftover template for it */
+		inet->hdr_tmpl_dst = NULL;
 	}
 	skb_dst_set_noref(skb, &rt->dst);
 
@@ -507,14 +509,43 @@ packet_routed:
 	skb_push(skb, sizeof(struct iphdr) + (inet_opt ? inet_opt->opt.optlen : 0));
 	skb_reset_network_header(skb);
 	iph = ip_hdr(skb);
-	*((__be16 *)iph) = htons((4 << 12) | (5 << 8) | (tos & 0xff));
-	if (ip_dont_fragment(sk, &rt->dst) && !skb->ignore_df)
-		iph->frag_off = htons(IP_DF);
-	else
-		iph->frag_off = 0;
-	iph->ttl      = ip_select_ttl(inet, &rt->dst);
-	iph->protocol = sk->sk_protocol;
-	ip_copy_addrs(iph, fl4);
+
+	/* Long lived flows with a stable route hit the header template a
+	 * previous packet cached and skip re-deriving TTL and DF from the
+	 * route.  The dst pointer comparison is only meaningful while the
+	 * socket still holds a reference on that exact dst, hence the
+	 * sk_dst_cache check; packets that arrive here with a foreign
+	 * route (tunnels, SCTP) just take the full build below, without
+	 * touching the template.
+	 */
+	if (inet->hdr_tmpl_dst == &rt->dst &&
+	    rcu_access_pointer(sk->sk_dst_cache) == &rt->dst &&
+	    !inet_opt && !skb->ignore_df &&
+	    inet->hdr_tmpl.saddr == fl4->saddr &&
+	    inet->hdr_tmpl.daddr == fl4->daddr &&
+	    inet->hdr_tmpl_uc_ttl == inet->uc_ttl &&
+	    inet->hdr_tmpl_pmtudisc == inet->pmtudisc) {
+		memcpy(iph, &inet->hdr_tmpl, sizeof(*iph));
+		/* ECN may change the tos from one packet to the next */
+		*((__be16 *)iph) = htons((4 << 12) | (5 << 8) | (tos & 0xff));
+	} else {
+		*((__be16 *)iph) = htons((4 << 12) | (5 << 8) | (tos & 0xff));
+		if (ip_dont_fragment(sk, &rt->dst) && !skb->ignore_df)
+			iph->frag_off = htons(IP_DF);
+		else
+			iph->frag_off = 0;
+		iph->ttl      = ip_select_ttl(inet, &rt->dst);
+		iph->protocol = sk->sk_protocol;
+		ip_copy_addrs(iph, fl4);
+
+		if (!inet_opt && !skb->ignore_df &&
+		    rcu_access_pointer(sk->sk_dst_cache) == &rt->dst) {
+			memcpy(&inet->hdr_tmpl, iph, sizeof(*iph));
+			inet->hdr_tmpl_uc_ttl = inet->uc_ttl;
+			inet->hdr_tmpl_pmtudisc = inet->pmtudisc;
+			inet->hdr_tmpl_dst = &rt->dst;
+		}
+	}
 
 	/* Transport layer set skb->h.foo itself. */
 
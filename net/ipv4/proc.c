@@ -51,7 +51,7 @@
 static int sockstat_seq_show(struct seq_file *seq, void *v)
 {
 	struct net *net = seq->private;
-	int orphans, sockets;
+	int orphans, sockets, i;
 
 	orphans = tcp_orphan_count_sum();
 	sockets = proto_sockets_allocated_sum_positive(&tcp_prot);
@@ -69,8 +69,14 @@ static int sockstat_seq_show(struct seq_file *seq, void *v)
 	seq_printf(seq, "RAW: inuse %d\n",
 		   sock_prot_inuse_get(net, &raw_prot));
 	seq_printf(seq,  "FRAG: inuse %u memory %lu\n",
-		   atomic_read(&net->ipv4.fqdir->rhashtable.nelems),
+		   fqdir_nelems(net->ipv4.fqdir),
 		   frag_mem_limit(net->ipv4.fqdir));
+	seq_puts(seq, "FRAGPART:");
+	for (i = 0; i < FQDIR_HASH_PARTITIONS; i++)
+		seq_printf(seq, " %u/%lu",
+			   atomic_read(&net->ipv4.fqdir->rhashtable[i].nelems),
+			   atomic_long_read(&net->ipv4.fqdir->evictions[i]));
+	seq_putc(seq, '\n');
 	return 0;
 }
 
@@ -298,6 +304,8 @@ static const struct snmp_mib snmp4_net_list[] = {
 	SNMP_MIB_ITEM("TCPMigrateReqSuccess", LINUX_MIB_TCPMIGRATEREQSUCCESS),
 	SNMP_MIB_ITEM("TCPMigrateReqFailure", LINUX_MIB_TCPMIGRATEREQFAILURE),
 	SNMP_MIB_ITEM("TCPPLBRehash", LINUX_MIB_TCPPLBREHASH),
+	SNMP_MIB_ITEM("TCPMetricsHits", LINUX_MIB_TCPMETRICSHITS),
+	SNMP_MIB_ITEM("TCPMetricsMisses", LINUX_MIB_TCPMETRICSMISSES),
 	SNMP_MIB_SENTINEL
 };
 
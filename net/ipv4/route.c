@@ -269,13 +269,14 @@ static int rt_cpu_seq_show(struct seq_file *seq, void *v)
 	struct rt_cache_stat *st = v;
 
 	if (v == SEQ_START_TOKEN) {
-		seq_puts(seq, "entries  in_hit   in_slow_tot in_slow_mc in_no_route in_brd   in_martian_dst in_martian_src out_hit  out_slow_tot out_slow_mc gc_total gc_ignored gc_goal_miss gc_dst_overflow in_hlist_search out_hlist_search\n");
+		seq_puts(seq, "entries  in_hit   in_slow_tot in_slow_mc in_no_route in_brd   in_martian_dst in_martian_src out_hit  out_slow_tot out_slow_mc gc_total gc_ignored gc_goal_miss gc_dst_overflow in_hlist_search out_hlist_search fnhe_pmtu fnhe_redirect fnhe_evict\n");
 		return 0;
 	}
 
 	seq_printf(seq, "%08x %08x %08x    %08x   %08x    %08x %08x       "
 			"%08x       %08x %08x     %08x    %08x %08x   "
-			"%08x     %08x        %08x        %08x\n",
+			"%08x     %08x        %08x        %08x        "
+			"%08x  %08x      %08x\n",
 		   dst_entries_get_slow(&ipv4_dst_ops),
 		   0, /* st->in_hit */
 		   st->in_slow_tot,
@@ -294,7 +295,11 @@ static int rt_cpu_seq_show(struct seq_file *seq, void *v)
 		   0, /* st->gc_goal_miss */
 		   0, /* st->gc_dst_overflow */
 		   0, /* st->in_hlist_search */
-		   0  /* st->out_hlist_search */
+		   0, /* st->out_hlist_search */
+
+		   st->fnhe_pmtu,
+		   st->fnhe_redirect,
+		   st->fnhe_evict
 		);
 	return 0;
 }
@@ -570,7 +575,20 @@ static void ip_rt_build_flow_key(struct flowi4 *fl4, const struct sock *sk,
 		build_sk_flow_key(fl4, sk);
 }
 
-static DEFINE_SPINLOCK(fnhe_lock);
+/* Exception updates are serialized per nexthop, not globally: a PMTU or
+ * redirect storm on one ECMP leg must not stall exception processing on
+ * the others.  The lock protecting a nexthop's exception hash is picked
+ * from this array by hashing the nexthop.
+ */
+#define FNHE_NR_LOCKS_SHIFT	6
+#define FNHE_NR_LOCKS		(1 << FNHE_NR_LOCKS_SHIFT)
+
+static spinlock_t fnhe_locks[FNHE_NR_LOCKS];
+
+static spinlock_t *fnhe_lock_addr(const struct fib_nh_common *nhc)
+{
+	return &fnhe_locks[hash_ptr((void *)nhc, FNHE_NR_LOCKS_SHIFT)];
+}
 
 static void fnhe_flush_routes(struct fib_nh_exception *fnhe)
 {
@@ -590,14 +608,15 @@ static void fnhe_flush_routes(struct fib_nh_exception *fnhe)
 	}
 }
 
-static void fnhe_remove_oldest(struct fnhe_hash_bucket *hash)
+static void fnhe_remove_oldest(struct fnhe_hash_bucket *hash,
+			       spinlock_t *lock)
 {
 	struct fib_nh_exception __rcu **fnhe_p, **oldest_p;
 	struct fib_nh_exception *fnhe, *oldest = NULL;
 
 	for (fnhe_p = &hash->chain; ; fnhe_p = &fnhe->fnhe_next) {
 		fnhe = rcu_dereference_protected(*fnhe_p,
-						 lockdep_is_held(&fnhe_lock));
+						 lockdep_is_held(lock));
 		if (!fnhe)
 			break;
 		if (!oldest ||
@@ -609,6 +628,7 @@ static void fnhe_remove_oldest(struct fnhe_hash_bucket *hash)
 	fnhe_flush_routes(oldest);
 	*oldest_p = oldest->fnhe_next;
 	kfree_rcu(oldest, rcu);
+	RT_CACHE_STAT_INC(fnhe_evict);
 }
 
 static u32 fnhe_hashfun(__be32 daddr)
@@ -639,6 +659,7 @@ static void update_or_create_fnhe(struct fib_nh_common *nhc, __be32 daddr,
 				  __be32 gw, u32 pmtu, bool lock,
 				  unsigned long expires)
 {
+	spinlock_t *fnhe_slock = fnhe_lock_addr(nhc);
 	struct fnhe_hash_bucket *hash;
 	struct fib_nh_exception *fnhe;
 	struct rtable *rt;
@@ -649,7 +670,12 @@ static void update_or_create_fnhe(struct fib_nh_common *nhc, __be32 daddr,
 	genid = fnhe_genid(dev_net(nhc->nhc_dev));
 	hval = fnhe_hashfun(daddr);
 
-	spin_lock_bh(&fnhe_lock);
+	spin_lock_bh(fnhe_slock);
+
+	if (pmtu)
+		RT_CACHE_STAT_INC(fnhe_pmtu);
+	if (gw)
+		RT_CACHE_STAT_INC(fnhe_redirect);
 
 	hash = rcu_dereference(nhc->nhc_exceptions);
 	if (!hash) {
@@ -692,7 +718,7 @@ static void update_or_create_fnhe(struct fib_nh_common *nhc, __be32 daddr,
 				get_random_u32_below(FNHE_RECLAIM_DEPTH);
 
 		while (depth > max_depth) {
-			fnhe_remove_oldest(hash);
+			fnhe_remove_oldest(hash, fnhe_slock);
 			depth--;
 		}
 
@@ -732,7 +758,7 @@ static void update_or_create_fnhe(struct fib_nh_common *nhc, __be32 daddr,
 	fnhe->fnhe_stamp = jiffies;
 
 out_unlock:
-	spin_unlock_bh(&fnhe_lock);
+	spin_unlock_bh(fnhe_slock);
 }
 
 static void __ip_do_redirect(struct rtable *rt, struct sk_buff *skb, struct flowi4 *fl4,
@@ -1329,20 +1355,21 @@ static void ip_del_fnhe(struct fib_nh_common *nhc, __be32 daddr)
 {
 	struct fnhe_hash_bucket *hash;
 	struct fib_nh_exception *fnhe, __rcu **fnhe_p;
+	spinlock_t *lock = fnhe_lock_addr(nhc);
 	u32 hval = fnhe_hashfun(daddr);
 
-	spin_lock_bh(&fnhe_lock);
+	spin_lock_bh(lock);
 
 	hash = rcu_dereference_protected(nhc->nhc_exceptions,
-					 lockdep_is_held(&fnhe_lock));
+					 lockdep_is_held(lock));
 	hash += hval;
 
 	fnhe_p = &hash->chain;
-	fnhe = rcu_dereference_protected(*fnhe_p, lockdep_is_held(&fnhe_lock));
+	fnhe = rcu_dereference_protected(*fnhe_p, lockdep_is_held(lock));
 	while (fnhe) {
 		if (fnhe->fnhe_daddr == daddr) {
 			rcu_assign_pointer(*fnhe_p, rcu_dereference_protected(
-				fnhe->fnhe_next, lockdep_is_held(&fnhe_lock)));
+				fnhe->fnhe_next, lockdep_is_held(lock)));
 			/* set fnhe_daddr to 0 to ensure it won't bind with
 			 * new dsts in rt_bind_exception().
 			 */
@@ -1353,10 +1380,10 @@ static void ip_del_fnhe(struct fib_nh_common *nhc, __be32 daddr)
 		}
 		fnhe_p = &fnhe->fnhe_next;
 		fnhe = rcu_dereference_protected(fnhe->fnhe_next,
-						 lockdep_is_held(&fnhe_lock));
+						 lockdep_is_held(lock));
 	}
 
-	spin_unlock_bh(&fnhe_lock);
+	spin_unlock_bh(lock);
 }
 
 static struct fib_nh_exception *find_exception(struct fib_nh_common *nhc,
@@ -1416,12 +1443,14 @@ u32 ip_mtu_from_fib_result(struct fib_result *res, __be32 daddr)
 	return mtu - lwtunnel_headroom(nhc->nhc_lwtstate, mtu);
 }
 
-static bool rt_bind_exception(struct rtable *rt, struct fib_nh_exception *fnhe,
+static bool rt_bind_exception(struct rtable *rt, struct fib_nh_common *nhc,
+			      struct fib_nh_exception *fnhe,
 			      __be32 daddr, const bool do_cache)
 {
+	spinlock_t *lock = fnhe_lock_addr(nhc);
 	bool ret = false;
 
-	spin_lock_bh(&fnhe_lock);
+	spin_lock_bh(lock);
 
 	if (daddr == fnhe->fnhe_daddr) {
 		struct rtable __rcu **porig;
@@ -1461,7 +1490,7 @@ static bool rt_bind_exception(struct rtable *rt, struct fib_nh_exception *fnhe,
 
 		fnhe->fnhe_stamp = jiffies;
 	}
-	spin_unlock_bh(&fnhe_lock);
+	spin_unlock_bh(lock);
 
 	return ret;
 }
@@ -1598,7 +1627,8 @@ static void rt_set_nexthop(struct rtable *rt, __be32 daddr,
 #endif
 		rt->dst.lwtstate = lwtstate_get(nhc->nhc_lwtstate);
 		if (unlikely(fnhe))
-			cached = rt_bind_exception(rt, fnhe, daddr, do_cache);
+			cached = rt_bind_exception(rt, nhc, fnhe, daddr,
+						   do_cache);
 		else if (do_cache)
 			cached = rt_cache_route(nhc, rt);
 		if (unlikely(!cached)) {
@@ -3701,6 +3731,7 @@ int __init ip_rt_init(void)
 {
 	void *idents_hash;
 	int cpu;
+	int i;
 
 	/* For modern hosts, this will use 2 MB of memory */
 	idents_hash = alloc_large_system_hash("IP idents",
@@ -3726,6 +3757,9 @@ int __init ip_rt_init(void)
 		INIT_LIST_HEAD(&ul->quarantine);
 		spin_lock_init(&ul->lock);
 	}
+
+	for (i = 0; i < FNHE_NR_LOCKS; i++)
+		spin_lock_init(&fnhe_locks[i]);
 #ifdef CONFIG_IP_ROUTE_CLASSID
 	ip_rt_acct = __alloc_percpu(256 * sizeof(struct ip_rt_acct), __alignof__(struct ip_rt_acct));
 	if (!ip_rt_acct)
@@ -1214,6 +1214,41 @@ int tcp_sendmsg_fastopen(struct sock *sk, struct msghdr *msg, int *copied,
 	return err;
 }
 
+/* Queue the template range referenced by an SO_SENDTEMPLATE cmsg ahead of
+ * the payload, attaching the registered pages as fragments instead of
+ * copying the bytes again.  Returns the number of bytes queued, or a
+ * negative error if nothing could be queued.
+ */
+static int tcp_sendmsg_template(struct sock *sk, struct sockcm_cookie *sockc,
+				int flags)
+{
+	struct sk_send_template *tmpl = sk->sk_send_template;
+	u32 off = sockc->tmpl_off;
+	u32 len = sockc->tmpl_len;
+	int queued = 0;
+
+	if (!tmpl || off >= tmpl->len || len > tmpl->len - off)
+		return -EINVAL;
+
+	/* Payload (or further template chunks) always follows. */
+	flags |= MSG_MORE | MSG_SENDPAGE_NOTLAST;
+
+	while (len) {
+		u32 poff = off & (PAGE_SIZE - 1);
+		u32 chunk = min_t(u32, len, PAGE_SIZE - poff);
+		ssize_t ret;
+
+		ret = do_tcp_sendpages(sk, tmpl->pages[off >> PAGE_SHIFT],
+				       poff, chunk, flags);
+		if (ret <= 0)
+			return queued ? queued : (int)ret;
+		queued += ret;
+		off += ret;
+		len -= ret;
+	}
+	return queued;
+}
+
 int tcp_sendmsg_locked(struct sock *sk, struct msghdr *msg, size_t size)
 {
 	struct tcp_sock *tp = tcp_sk(sk);
@@ -1299,6 +1334,16 @@ int tcp_sendmsg_locked(struct sock *sk, struct msghdr *msg, size_t size)
 	/* Ok commence sending. */
 	copied = 0;
 
+	if (unlikely(sockc.tmpl_len)) {
+		err = tcp_sendmsg_template(sk, &sockc, flags);
+		if (err < 0)
+			goto do_error;
+		/* Template bytes count towards the return value so that a
+		 * partial send can be resumed from the right offset.
+		 */
+		copied = err;
+	}
+
 restart:
 	mss_now = tcp_send_mss(sk, &size_goal, flags);
 
@@ -2019,7 +2064,7 @@ static int receive_fallback_to_copy(struct sock *sk,
 
 static int tcp_copy_straggler_data(struct tcp_zerocopy_receive *zc,
 				   struct sk_buff *skb, u32 copylen,
-				   u32 *offset, u32 *seq)
+				   u32 copybuf_off, u32 *offset, u32 *seq)
 {
 	unsigned long copy_address = (unsigned long)zc->copybuf_address;
 	struct msghdr msg = {};
@@ -2029,6 +2074,7 @@ static int tcp_copy_straggler_data(struct tcp_zerocopy_receive *zc,
 	if (copy_address != zc->copybuf_address)
 		return -EINVAL;
 
+	copy_address += copybuf_off;
 	err = import_single_range(ITER_DEST, (void __user *)copy_address,
 				  copylen, &iov, &msg.msg_iter);
 	if (err)
@@ -2036,12 +2082,60 @@ static int tcp_copy_straggler_data(struct tcp_zerocopy_receive *zc,
 	err = skb_copy_datagram_msg(skb, *offset, &msg, copylen);
 	if (err)
 		return err;
-	zc->recv_skip_hint -= copylen;
 	*offset += copylen;
 	*seq += copylen;
 	return (__s32)copylen;
 }
 
+/* Copy an unaligned head sliver into the start of the copybuf so that
+ * the receive queue position advances to a page-mappable frag boundary
+ * and the middle of the payload can still be mapped.  Only done when
+ * the whole sliver fits in the copybuf; otherwise copying would not
+ * unlock any mappable pages.  Returns the number of bytes copied.
+ */
+static int tcp_zc_handle_head_sliver(struct tcp_zerocopy_receive *zc,
+				     struct sock *sk, u32 *seq,
+				     s32 copybuf_len,
+				     struct scm_timestamping_internal *tss)
+{
+	u32 offset, frag_off, sliver = 0;
+	struct sk_buff *skb;
+	skb_frag_t *frag;
+	int copied;
+
+	if (copybuf_len <= 0)
+		return 0;
+
+	skb = tcp_recv_skb(sk, *seq, &offset);
+	if (!skb)
+		return 0;
+
+	if (offset < skb_headlen(skb))
+		sliver = skb_headlen(skb) - offset;
+	frag = skb_advance_to_frag(skb, offset + sliver, &frag_off);
+	if (frag) {
+		if (frag_off) {
+			sliver += skb_frag_size(frag) - frag_off;
+			++frag;
+		}
+		sliver += find_next_mappable_frag(frag,
+						  skb->len - offset - sliver);
+	}
+	if (!sliver || sliver > (u32)copybuf_len)
+		return 0;
+
+	if (TCP_SKB_CB(skb)->has_rxtstamp) {
+		tcp_update_recv_tstamps(skb, tss);
+		zc->msg_flags |= TCP_CMSG_TS;
+	}
+
+	copied = tcp_copy_straggler_data(zc, skb, sliver, 0, &offset, seq);
+	if (copied < 0)
+		return 0;
+	zc->copybuf_head_len = copied;
+	return copied;
+}
+
 static int tcp_zc_handle_leftover(struct tcp_zerocopy_receive *zc,
 				  struct sock *sk,
 				  struct sk_buff *skb,
@@ -2064,9 +2158,14 @@ static int tcp_zc_handle_leftover(struct tcp_zerocopy_receive *zc,
 		}
 	}
 
-	zc->copybuf_len = tcp_copy_straggler_data(zc, skb, copylen, &offset,
-						  seq);
-	return zc->copybuf_len < 0 ? 0 : copylen;
+	/* Head sliver bytes, if any, occupy the front of the copybuf. */
+	zc->copybuf_len = tcp_copy_straggler_data(zc, skb, copylen,
+						  zc->copybuf_head_len,
+						  &offset, seq);
+	if (zc->copybuf_len < 0)
+		return 0;
+	zc->recv_skip_hint -= copylen;
+	return copylen;
 }
 
 static int tcp_zerocopy_vm_insert_batch_error(struct vm_area_struct *vma,
@@ -2193,9 +2292,11 @@ static int tcp_zerocopy_receive(struct sock *sk,
 	u32 seq = tp->copied_seq;
 	u32 total_bytes_to_map;
 	int inq = tcp_inq(sk);
+	u32 head_copylen;
 	int ret;
 
 	zc->copybuf_len = 0;
+	zc->copybuf_head_len = 0;
 	zc->msg_flags = 0;
 
 	if (address & (PAGE_SIZE - 1) || address != zc->address)
@@ -2217,6 +2318,11 @@ static int tcp_zerocopy_receive(struct sock *sk,
 		return 0;
 	}
 
+	head_copylen = tcp_zc_handle_head_sliver(zc, sk, &seq, copybuf_len,
+						 tss);
+	copybuf_len -= head_copylen;
+	inq -= head_copylen;
+
 	mmap_read_lock(current->mm);
 
 	vma = vma_lookup(current->mm, address);
@@ -2302,6 +2408,11 @@ out:
 	if (!ret)
 		copylen = tcp_zc_handle_leftover(zc, sk, skb, &seq, copybuf_len, tss);
 
+	/* Head sliver bytes were consumed even if the tail copy failed. */
+	copylen += head_copylen;
+	if (zc->copybuf_len >= 0)
+		zc->copybuf_len += head_copylen;
+
 	if (length + copylen) {
 		WRITE_ONCE(tp->copied_seq, seq);
 		tcp_rcv_space_adjust(sk);
@@ -4334,7 +4445,7 @@ int do_tcp_getsockopt(struct sock *sk, int level,
 		}
 		if (copy_from_sockptr(&zc, optval, len))
 			return -EFAULT;
-		if (zc.reserved)
+		if (zc.copybuf_head_len)
 			return -EINVAL;
 		if (zc.msg_flags &  ~(TCP_VALID_ZC_MSG_FLAGS))
 			return -EINVAL;
@@ -4756,11 +4867,14 @@ void __init tcp_init(void)
 	inet_hashinfo2_init(&tcp_hashinfo, "tcp_listen_portaddr_hash",
 			    thash_entries, 21,  /* one slot per 2 MB*/
 			    0, 64 * 1024);
+	/* TYPESAFE_BY_RCU allows the lockless bind conflict pre-screen
+	 * in __inet_hash_connect() to walk bucket chains under RCU.
+	 */
 	tcp_hashinfo.bind_bucket_cachep =
 		kmem_cache_create("tcp_bind_bucket",
 				  sizeof(struct inet_bind_bucket), 0,
 				  SLAB_HWCACHE_ALIGN | SLAB_PANIC |
-				  SLAB_ACCOUNT,
+				  SLAB_ACCOUNT | SLAB_TYPESAFE_BY_RCU,
 				  NULL);
 	tcp_hashinfo.bind2_bucket_cachep =
 		kmem_cache_create("tcp_bind2_bucket",
@@ -1807,11 +1807,26 @@ int tcp_v4_early_demux(struct sk_buff *skb)
 	return 0;
 }
 
+/* Both option areas hold nothing but the timestamp option, in its
+ * standard nop-nop-kind-length layout.
+ */
+static bool tcp_opt_ts_only(const struct tcphdr *th1, const struct tcphdr *th2,
+			    unsigned int hdrlen)
+{
+	const __be32 tsopt = htonl((TCPOPT_NOP << 24) | (TCPOPT_NOP << 16) |
+				   (TCPOPT_TIMESTAMP << 8) | TCPOLEN_TIMESTAMP);
+
+	return hdrlen == sizeof(*th1) + TCPOLEN_TSTAMP_ALIGNED &&
+	       *(const __be32 *)(th1 + 1) == tsopt &&
+	       *(const __be32 *)(th2 + 1) == tsopt;
+}
+
 bool tcp_add_backlog(struct sock *sk, struct sk_buff *skb,
 		     enum skb_drop_reason *reason)
 {
 	u32 limit, tail_gso_size, tail_gso_segs;
 	struct skb_shared_info *shinfo;
+	bool ts_refresh = false;
 	const struct tcphdr *th;
 	struct tcphdr *thtail;
 	struct sk_buff *tail;
@@ -1863,10 +1878,25 @@ bool tcp_add_backlog(struct sock *sk, struct sk_buff *skb,
 #ifdef CONFIG_TLS_DEVICE
 	    tail->decrypted != skb->decrypted ||
 #endif
-	    thtail->doff != th->doff ||
-	    memcmp(thtail + 1, th + 1, hdrlen - sizeof(*th)))
+	    thtail->doff != th->doff)
 		goto no_coalesce;
 
+	if (memcmp(thtail + 1, th + 1, hdrlen - sizeof(*th))) {
+		/* Pure ACKs whose only option is the timestamp differ on
+		 * every packet, which used to defeat coalescing exactly on
+		 * the segments it helps with most under ACK storms.  Merge
+		 * them anyway; the newest timestamps are carried over below
+		 * together with the newest ack_seq, which is what cumulative
+		 * processing of the ACKs would have used.  ACKs that differ
+		 * in SACK blocks still land here and stay separate.
+		 */
+		if (TCP_SKB_CB(skb)->seq != TCP_SKB_CB(skb)->end_seq ||
+		    TCP_SKB_CB(tail)->seq != TCP_SKB_CB(tail)->end_seq ||
+		    !tcp_opt_ts_only(thtail, th, hdrlen))
+			goto no_coalesce;
+		ts_refresh = true;
+	}
+
 	__skb_pull(skb, hdrlen);
 
 	shinfo = skb_shinfo(skb);
@@ -1883,6 +1913,9 @@ bool tcp_add_backlog(struct sock *sk, struct sk_buff *skb,
 		if (likely(!before(TCP_SKB_CB(skb)->ack_seq, TCP_SKB_CB(tail)->ack_seq))) {
 			TCP_SKB_CB(tail)->ack_seq = TCP_SKB_CB(skb)->ack_seq;
 			thtail->window = th->window;
+			if (ts_refresh)
+				memcpy(thtail + 1, th + 1,
+				       TCPOLEN_TSTAMP_ALIGNED);
 		}
 
 		/* We have to update both TCP_SKB_CB(tail)->tcp_flags and
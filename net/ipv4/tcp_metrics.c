@@ -44,6 +44,7 @@ struct tcp_metrics_block {
 	struct inetpeer_addr		tcpm_saddr;
 	struct inetpeer_addr		tcpm_daddr;
 	unsigned long			tcpm_stamp;
+	u32				tcpm_used;
 	u32				tcpm_lock;
 	u32				tcpm_vals[TCP_METRIC_MAX_KERNEL + 1];
 	struct tcp_fastopen_metrics	tcpm_fastopen;
@@ -88,7 +89,18 @@ struct tcpm_hash_bucket {
 static struct tcpm_hash_bucket	*tcp_metrics_hash __read_mostly;
 static unsigned int		tcp_metrics_hash_log __read_mostly;
 
-static DEFINE_SPINLOCK(tcp_metrics_lock);
+/* Updates used to funnel through a single global lock; shard it by
+ * bucket so concurrent session closes for unrelated peers do not
+ * serialize.  Readers are RCU and take no lock at all.
+ */
+#define TCP_METRICS_NR_LOCKS	64
+
+static spinlock_t		tcp_metrics_locks[TCP_METRICS_NR_LOCKS];
+
+static spinlock_t *tcp_metrics_lock_addr(unsigned int hash)
+{
+	return &tcp_metrics_locks[hash % TCP_METRICS_NR_LOCKS];
+}
 
 static void tcpm_suck_dst(struct tcp_metrics_block *tm,
 			  const struct dst_entry *dst,
@@ -140,19 +152,20 @@ static void tcpm_check_stamp(struct tcp_metrics_block *tm, struct dst_entry *dst
 #define TCP_METRICS_RECLAIM_DEPTH	5
 #define TCP_METRICS_RECLAIM_PTR		(struct tcp_metrics_block *) 0x1UL
 
-#define deref_locked(p)	\
-	rcu_dereference_protected(p, lockdep_is_held(&tcp_metrics_lock))
+#define deref_locked(p, lock)	\
+	rcu_dereference_protected(p, lockdep_is_held(lock))
 
 static struct tcp_metrics_block *tcpm_new(struct dst_entry *dst,
 					  struct inetpeer_addr *saddr,
 					  struct inetpeer_addr *daddr,
 					  unsigned int hash)
 {
+	spinlock_t *lock = tcp_metrics_lock_addr(hash);
 	struct tcp_metrics_block *tm;
 	struct net *net;
 	bool reclaim = false;
 
-	spin_lock_bh(&tcp_metrics_lock);
+	spin_lock_bh(lock);
 	net = dev_net(dst->dev);
 
 	/* While waiting for the spin-lock the cache might have been populated
@@ -169,12 +182,21 @@ static struct tcp_metrics_block *tcpm_new(struct dst_entry *dst,
 	}
 
 	if (unlikely(reclaim)) {
-		struct tcp_metrics_block *oldest;
+		struct tcp_metrics_block *oldest = NULL;
 
-		oldest = deref_locked(tcp_metrics_hash[hash].chain);
-		for (tm = deref_locked(oldest->tcpm_next); tm;
-		     tm = deref_locked(tm->tcpm_next)) {
-			if (time_before(tm->tcpm_stamp, oldest->tcpm_stamp))
+		/* Evict the least used entry of the chain, aging every use
+		 * count as we go so an old burst cannot pin an entry
+		 * forever; ties go to the oldest update stamp.  Frequently
+		 * reconnecting peers thus keep their history even when the
+		 * chain churns through many one-shot peers.
+		 */
+		for (tm = deref_locked(tcp_metrics_hash[hash].chain, lock);
+		     tm; tm = deref_locked(tm->tcpm_next, lock)) {
+			tm->tcpm_used >>= 1;
+			if (!oldest ||
+			    tm->tcpm_used < oldest->tcpm_used ||
+			    (tm->tcpm_used == oldest->tcpm_used &&
+			     time_before(tm->tcpm_stamp, oldest->tcpm_stamp)))
 				oldest = tm;
 		}
 		tm = oldest;
@@ -186,6 +208,7 @@ static struct tcp_metrics_block *tcpm_new(struct dst_entry *dst,
 	write_pnet(&tm->tcpm_net, net);
 	tm->tcpm_saddr = *saddr;
 	tm->tcpm_daddr = *daddr;
+	tm->tcpm_used = 0;
 
 	tcpm_suck_dst(tm, dst, true);
 
@@ -195,7 +218,7 @@ static struct tcp_metrics_block *tcpm_new(struct dst_entry *dst,
 	}
 
 out_unlock:
-	spin_unlock_bh(&tcp_metrics_lock);
+	spin_unlock_bh(lock);
 	return tm;
 }
 
@@ -305,6 +328,12 @@ static struct tcp_metrics_block *tcp_get_metrics(struct sock *sk,
 	tm = __tcp_get_metrics(&saddr, &daddr, net, hash);
 	if (tm == TCP_METRICS_RECLAIM_PTR)
 		tm = NULL;
+	if (tm) {
+		NET_INC_STATS(net, LINUX_MIB_TCPMETRICSHITS);
+		WRITE_ONCE(tm->tcpm_used, READ_ONCE(tm->tcpm_used) + 1);
+	} else {
+		NET_INC_STATS(net, LINUX_MIB_TCPMETRICSMISSES);
+	}
 	if (!tm && create)
 		tm = tcpm_new(dst, &saddr, &daddr, hash);
 	else
@@ -881,12 +910,14 @@ static void tcp_metrics_flush_all(struct net *net)
 	unsigned int row;
 
 	for (row = 0; row < max_rows; row++, hb++) {
+		spinlock_t *lock = tcp_metrics_lock_addr(row);
 		struct tcp_metrics_block __rcu **pp;
 		bool match;
 
-		spin_lock_bh(&tcp_metrics_lock);
+		spin_lock_bh(lock);
 		pp = &hb->chain;
-		for (tm = deref_locked(*pp); tm; tm = deref_locked(*pp)) {
+		for (tm = deref_locked(*pp, lock); tm;
+		     tm = deref_locked(*pp, lock)) {
 			match = net ? net_eq(tm_net(tm), net) :
 				!refcount_read(&tm_net(tm)->ns.count);
 			if (match) {
@@ -896,7 +927,7 @@ static void tcp_metrics_flush_all(struct net *net)
 				pp = &tm->tcpm_next;
 			}
 		}
-		spin_unlock_bh(&tcp_metrics_lock);
+		spin_unlock_bh(lock);
 	}
 }
 
@@ -908,6 +939,7 @@ static int tcp_metrics_nl_cmd_del(struct sk_buff *skb, struct genl_info *info)
 	struct inetpeer_addr saddr, daddr;
 	unsigned int hash;
 	struct net *net = genl_info_net(info);
+	spinlock_t *lock;
 	int ret;
 	bool src = true, found = false;
 
@@ -924,10 +956,11 @@ static int tcp_metrics_nl_cmd_del(struct sk_buff *skb, struct genl_info *info)
 
 	hash ^= net_hash_mix(net);
 	hash = hash_32(hash, tcp_metrics_hash_log);
+	lock = tcp_metrics_lock_addr(hash);
 	hb = tcp_metrics_hash + hash;
 	pp = &hb->chain;
-	spin_lock_bh(&tcp_metrics_lock);
-	for (tm = deref_locked(*pp); tm; tm = deref_locked(*pp)) {
+	spin_lock_bh(lock);
+	for (tm = deref_locked(*pp, lock); tm; tm = deref_locked(*pp, lock)) {
 		if (addr_same(&tm->tcpm_daddr, &daddr) &&
 		    (!src || addr_same(&tm->tcpm_saddr, &saddr)) &&
 		    net_eq(tm_net(tm), net)) {
@@ -938,7 +971,7 @@ static int tcp_metrics_nl_cmd_del(struct sk_buff *skb, struct genl_info *info)
 			pp = &tm->tcpm_next;
 		}
 	}
-	spin_unlock_bh(&tcp_metrics_lock);
+	spin_unlock_bh(lock);
 	if (!found)
 		return -ESRCH;
 	return 0;
@@ -1026,7 +1059,10 @@ static __net_initdata struct pernet_operations tcp_net_metrics_ops = {
 
 void __init tcp_metrics_init(void)
 {
-	int ret;
+	int ret, i;
+
+	for (i = 0; i < TCP_METRICS_NR_LOCKS; i++)
+		spin_lock_init(&tcp_metrics_locks[i]);
 
 	ret = register_pernet_subsys(&tcp_net_metrics_ops);
 	if (ret < 0)
@@ -1117,15 +1117,42 @@ void tcp_release_cb(struct sock *sk)
 }
 EXPORT_SYMBOL(tcp_release_cb);
 
+/* Internal pacing used to arm one hrtimer per throttled flow, which does
+ * not scale to hundreds of thousands of paced flows.  Instead, flows
+ * waiting for their earliest departure time are hashed by that time onto
+ * a per-CPU timing wheel driven by a single hrtimer; each tick releases
+ * the batch of flows whose departure time has passed.  A flow whose
+ * departure time lies beyond the wheel horizon is parked in the last
+ * slot and simply re-arms itself when released early.
+ */
+#define TCP_PACING_WHEEL_SHIFT	17	/* ~131 usec per tick */
+#define TCP_PACING_WHEEL_SLOTS	256	/* ~33 msec horizon */
+
+struct tcp_pacing_wheel {
+	struct hlist_head	slots[TCP_PACING_WHEEL_SLOTS];
+	struct hrtimer		timer;
+	u64			last_tick;	/* last processed tick */
+	unsigned int		pending;	/* queued sockets */
+};
+static DEFINE_PER_CPU(struct tcp_pacing_wheel, tcp_pacing_wheel);
+
+static enum hrtimer_restart tcp_pacing_wheel_release(struct hrtimer *timer);
+
 void __init tcp_tasklet_init(void)
 {
 	int i;
 
 	for_each_possible_cpu(i) {
 		struct tsq_tasklet *tsq = &per_cpu(tsq_tasklet, i);
+		struct tcp_pacing_wheel *pw = &per_cpu(tcp_pacing_wheel, i);
 
 		INIT_LIST_HEAD(&tsq->head);
 		tasklet_setup(&tsq->tasklet, tcp_tasklet_func);
+
+		hrtimer_init(&pw->timer, CLOCK_MONOTONIC,
+			     HRTIMER_MODE_ABS_PINNED_SOFT);
+		pw->timer.function = tcp_pacing_wheel_release;
+		pw->last_tick = tcp_clock_ns() >> TCP_PACING_WHEEL_SHIFT;
 	}
 }
 
@@ -1178,16 +1205,105 @@ out:
 	sk_free(sk);
 }
 
+static void tcp_pacing_wheel_arm(struct sock *sk, u64 wstamp_ns)
+{
+	struct tcp_sock *tp = tcp_sk(sk);
+	u64 tick = wstamp_ns >> TCP_PACING_WHEEL_SHIFT;
+	struct tcp_pacing_wheel *pw;
+	unsigned long flags;
+	ktime_t expiry;
+
+	if (test_and_set_bit(TSQ_PACED, &sk->sk_tsq_flags))
+		return;
+	sock_hold(sk);
+
+	local_irq_save(flags);
+	pw = this_cpu_ptr(&tcp_pacing_wheel);
+	/* Keep the tick inside (last_tick, last_tick + SLOTS) so that a
+	 * slot never mixes entries of different wheel laps.
+	 */
+	if (tick <= pw->last_tick)
+		tick = pw->last_tick + 1;
+	else if (tick - pw->last_tick >= TCP_PACING_WHEEL_SLOTS)
+		tick = pw->last_tick + TCP_PACING_WHEEL_SLOTS - 1;
+	tp->pacing_tick = tick;
+	hlist_add_head(&tp->pacing_node,
+		       &pw->slots[tick % TCP_PACING_WHEEL_SLOTS]);
+	pw->pending++;
+
+	expiry = ns_to_ktime(tick << TCP_PACING_WHEEL_SHIFT);
+	if (!hrtimer_is_queued(&pw->timer) ||
+	    ktime_before(expiry, hrtimer_get_expires(&pw->timer)))
+		hrtimer_start(&pw->timer, expiry,
+			      HRTIMER_MODE_ABS_PINNED_SOFT);
+	local_irq_restore(flags);
+}
+
 /* Note: Called under soft irq.
  * We can call TCP stack right away, unless socket is owned by user.
  */
-enum hrtimer_restart tcp_pace_kick(struct hrtimer *timer)
+static enum hrtimer_restart tcp_pacing_wheel_release(struct hrtimer *timer)
 {
-	struct tcp_sock *tp = container_of(timer, struct tcp_sock, pacing_timer);
-	struct sock *sk = (struct sock *)tp;
+	struct tcp_pacing_wheel *pw = container_of(timer,
+						   struct tcp_pacing_wheel,
+						   timer);
+	u64 now_tick = tcp_clock_ns() >> TCP_PACING_WHEEL_SHIFT;
+	struct hlist_node *n;
+	unsigned long flags;
+	struct tcp_sock *tp;
+	HLIST_HEAD(due);
+	u64 nticks, i;
 
-	tcp_tsq_handler(sk);
-	sock_put(sk);
+	local_irq_save(flags);
+	nticks = min_t(u64, now_tick - pw->last_tick,
+		       TCP_PACING_WHEEL_SLOTS);
+	for (i = 1; i <= nticks; i++) {
+		struct hlist_head *slot;
+
+		slot = &pw->slots[(pw->last_tick + i) %
+				  TCP_PACING_WHEEL_SLOTS];
+		hlist_for_each_entry_safe(tp, n, slot, pacing_node) {
+			hlist_del(&tp->pacing_node);
+			hlist_add_head(&tp->pacing_node, &due);
+			pw->pending--;
+		}
+	}
+	pw->last_tick = now_tick;
+	local_irq_restore(flags);
+
+	hlist_for_each_entry_safe(tp, n, &due, pacing_node) {
+		struct sock *sk = (struct sock *)tp;
+
+		hlist_del(&tp->pacing_node);
+		smp_mb__before_atomic();
+		clear_bit(TSQ_PACED, &sk->sk_tsq_flags);
+
+		tcp_tsq_handler(sk);
+		sock_put(sk);
+	}
+
+	/* Released flows may have re-armed the wheel (and the timer) above,
+	 * so re-evaluate the earliest pending tick only now.
+	 */
+	local_irq_save(flags);
+	if (pw->pending) {
+		ktime_t expiry;
+
+		/* Entries all sit within one horizon of now, so the first
+		 * non-empty slot identifies the next due tick.
+		 */
+		for (i = 1; i < TCP_PACING_WHEEL_SLOTS; i++) {
+			if (!hlist_empty(&pw->slots[(now_tick + i) %
+						    TCP_PACING_WHEEL_SLOTS]))
+				break;
+		}
+		expiry = ns_to_ktime((now_tick + i) << TCP_PACING_WHEEL_SHIFT);
+		if (!hrtimer_is_queued(timer) ||
+		    ktime_before(expiry, hrtimer_get_expires(timer)))
+			hrtimer_start(timer, expiry,
+				      HRTIMER_MODE_ABS_PINNED_SOFT);
+	}
+	local_irq_restore(flags);
 
 	return HRTIMER_NORESTART;
 }
@@ -2476,12 +2592,7 @@ static bool tcp_pacing_check(struct sock *sk)
 	if (tp->tcp_wstamp_ns <= tp->tcp_clock_cache)
 		return false;
 
-	if (!hrtimer_is_queued(&tp->pacing_timer)) {
-		hrtimer_start(&tp->pacing_timer,
-			      ns_to_ktime(tp->tcp_wstamp_ns),
-			      HRTIMER_MODE_ABS_PINNED_SOFT);
-		sock_hold(sk);
-	}
+	tcp_pacing_wheel_arm(sk, tp->tcp_wstamp_ns);
 	return true;
 }
 
@@ -1841,6 +1841,85 @@ try_again:
 }
 EXPORT_SYMBOL(udp_read_skb);
 
+/* Try to append more queued datagrams from the same peer to a recvmsg()
+ * that already consumed a first one.  Only sockets that enabled UDP_GRO
+ * get here: the batch reuses the GRO uAPI contract - equally sized
+ * datagrams back to back, their size in a UDP_GRO cmsg, optionally a
+ * shorter final one - so userspace that copes with GRO aggregates also
+ * gets aggregation of datagrams that were queued individually, at one
+ * syscall per burst instead of one per packet.  As with GRO, ancillary
+ * data describes the first datagram only.
+ *
+ * Returns the number of extra bytes copied into the iov.
+ */
+static unsigned int udp_recvmsg_batch(struct sock *sk, struct msghdr *msg,
+				      struct sk_buff *first, unsigned int ulen)
+{
+	struct sk_buff_head *sk_queue = &sk->sk_receive_queue;
+	struct sk_buff_head *queue = &udp_sk(sk)->reader_queue;
+	unsigned int segs = 1, total = 0;
+	int is_udplite = IS_UDPLITE(sk);
+	struct sk_buff *skb;
+	unsigned int len;
+	int err;
+
+	while (segs < UDP_MAX_SEGMENTS && msg_data_left(msg) >= ulen) {
+		spin_lock_bh(&queue->lock);
+		skb = skb_peek(queue);
+		if (!skb && !skb_queue_empty_lockless(sk_queue)) {
+			spin_lock(&sk_queue->lock);
+			skb_queue_splice_tail_init(sk_queue, queue);
+			spin_unlock(&sk_queue->lock);
+			skb = skb_peek(queue);
+		}
+		if (!skb || skb_is_gso(skb) ||
+		    !udp_skb_len(skb) || udp_skb_len(skb) > ulen ||
+		    udp_hdr(skb)->source != udp_hdr(first)->source ||
+		    ip_hdr(skb)->saddr != ip_hdr(first)->saddr) {
+			spin_unlock_bh(&queue->lock);
+			break;
+		}
+		__skb_unlink(skb, queue);
+		udp_skb_destructor(sk, skb);
+		spin_unlock_bh(&queue->lock);
+
+		len = udp_skb_len(skb);
+		if (!udp_skb_csum_unnecessary(skb) &&
+		    udp_lib_checksum_complete(skb)) {
+			UDP_INC_STATS(sock_net(sk), UDP_MIB_CSUMERRORS,
+				      is_udplite);
+			UDP_INC_STATS(sock_net(sk), UDP_MIB_INERRORS,
+				      is_udplite);
+			atomic_inc(&sk->sk_drops);
+			kfree_skb(skb);
+			break;
+		}
+
+		if (udp_skb_is_linear(skb))
+			err = copy_linear_skb(skb, len, 0, &msg->msg_iter);
+		else
+			err = skb_copy_datagram_msg(skb, 0, msg, len);
+		if (unlikely(err)) {
+			atomic_inc(&sk->sk_drops);
+			UDP_INC_STATS(sock_net(sk), UDP_MIB_INERRORS,
+				      is_udplite);
+			kfree_skb(skb);
+			break;
+		}
+
+		UDP_INC_STATS(sock_net(sk), UDP_MIB_INDATAGRAMS, is_udplite);
+		total += len;
+		segs++;
+		skb_consume_udp(sk, skb, len);
+
+		/* a shorter datagram ends the aggregate, like GRO */
+		if (len < ulen)
+			break;
+	}
+
+	return total;
+}
+
 /*
  * 	This should be easy, if there is something there we
  * 	return it, otherwise we block.
@@ -1852,7 +1931,7 @@ int udp_recvmsg(struct sock *sk, struct msghdr *msg, size_t len, int flags,
 	struct inet_sock *inet = inet_sk(sk);
 	DECLARE_SOCKADDR(struct sockaddr_in *, sin, msg->msg_name);
 	struct sk_buff *skb;
-	unsigned int ulen, copied;
+	unsigned int ulen, copied, batched = 0;
 	int off, err, peeking = flags & MSG_PEEK;
 	int is_udplite = IS_UDPLITE(sk);
 	bool checksum_valid = false;
@@ -1909,10 +1988,16 @@ try_again:
 		return err;
 	}
 
-	if (!peeking)
+	if (!peeking) {
 		UDP_INC_STATS(sock_net(sk),
 			      UDP_MIB_INDATAGRAMS, is_udplite);
 
+		if (udp_sk(sk)->gro_enabled && !skb_is_gso(skb) &&
+		    !is_udplite && ulen && copied == ulen &&
+		    msg_data_left(msg) >= ulen)
+			batched = udp_recvmsg_batch(sk, msg, skb, ulen);
+	}
+
 	sock_recv_cmsgs(msg, sk, skb);
 
 	/* Copy the address. */
@@ -1930,6 +2015,16 @@ try_again:
 	if (udp_sk(sk)->gro_enabled)
 		udp_cmsg_recv(msg, sk, skb);
 
+	if (batched) {
+		/* the first datagram was not itself a GRO aggregate, so
+		 * udp_cmsg_recv() above stayed silent and the segment
+		 * size of the batch is ours to report
+		 */
+		int gso_size = ulen;
+
+		put_cmsg(msg, SOL_UDP, UDP_GRO, sizeof(gso_size), &gso_size);
+	}
+
 	if (inet->cmsg_flags)
 		ip_cmsg_recv_offset(msg, sk, skb, sizeof(struct udphdr), off);
 
@@ -1938,7 +2033,7 @@ try_again:
 		err = ulen;
 
 	skb_consume_udp(sk, skb, peeking ? -err : err);
-	return err;
+	return err + batched;
 
 csum_copy_err:
 	if (!__sk_queue_drop_skb(sk, &udp_sk(sk)->reader_queue, skb, flags,
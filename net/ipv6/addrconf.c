@@ -144,6 +144,19 @@ static int ipv6_generate_stable_address(struct in6_addr *addr,
 					u8 dad_count,
 					const struct inet6_dev *idev);
 
+/*
+ * The address hash is per netns (net->ipv6.inet6_addr_lst) and sized
+ * for hosts with a sane number of configured addresses.  It is not the
+ * data structure to scale for anycast edges wanting 500k+ addresses:
+ * every address here is a full ifaddr with DAD state, lifetimes, and
+ * regeneration timers, so the per-address cost is the object and its
+ * management, not just the chain walk, and a resizable table would fix
+ * the cheapest part.  The supported way to terminate whole prefixes is
+ * AnyIP - a local route (ip -6 route add local <prefix> dev lo) makes
+ * the datapath check a FIB lookup and the control plane one netlink
+ * message per prefix instead of thousands per-address, which is also
+ * why there is no batched address add/remove operation.
+ */
 #define IN6_ADDR_HSIZE_SHIFT	8
 #define IN6_ADDR_HSIZE		(1 << IN6_ADDR_HSIZE_SHIFT)
 
@@ -676,6 +676,26 @@ looped_back:
   Routing header.
  ********************************/
 
+/*
+ * Per-device "compiled" extension-header profiles - declaring an
+ * expected header sequence and getting a specialized straight-line
+ * parser with the bounds checks hoisted - have been proposed for SRv6
+ * fabrics where every packet carries the same layout.  The generic
+ * walk stays, for two reasons.  Correctness: every bounds and
+ * pskb_may_pull() check below guards against what an attacker sends,
+ * not what the operator expects, so "hoisting" them on the strength of
+ * a declared profile removes them from exactly the packets that need
+ * them, and the mismatch fallback re-parses from scratch - a
+ * pathological case an adversary controls.  Economics: for the fixed
+ * single-SRH layout the walk is one tlv-length iteration before
+ * ipv6_srh_rcv(); the cycles on SRv6 midpoints go to the seg6_local
+ * action and the fib lookup.  Deployments that want a specialized
+ * fast path have one already: seg6_local's End flavors run before any
+ * generic option processing, and an XDP program can match-and-forward
+ * a known layout entirely ahead of this parser without teaching the
+ * stack to trust it.
+ */
+
 /* called with rcu_read_lock() */
 static int ipv6_rthdr_rcv(struct sk_buff *skb)
 {
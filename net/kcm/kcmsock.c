@@ -361,7 +361,24 @@ static void psock_data_ready(struct sock *sk)
 	read_unlock_bh(&sk->sk_callback_lock);
 }
 
-/* Called with lower sock held */
+/* Called with lower sock held
+ *
+ * Parsing on the lower socket's CPU is inherent, not an implementation
+ * shortcut to be fixed with a ticketed worker pool: message boundaries
+ * in a byte stream are discovered sequentially - frame N+1 starts
+ * where the parser says frame N ends - so parse itself cannot fan out,
+ * and a pool behind sequence tickets would serialize again at ticket
+ * retirement after paying handoff per message.  It would also detach
+ * parsing from the TCP socket lock that lets strparser consume the
+ * receive queue and exert backpressure (strp_pause) in-line.  What KCM
+ * does distribute is everything after the boundary decision: messages
+ * from one fat upstream fan out here across all KCM sockets on the
+ * mux, so receive-side *processing* scales to as many cores as the
+ * application opens KCM sockets.  When the single-threaded part - BPF
+ * parse plus queueing - truly saturates one core, the remedy is
+ * sharding the transport (multiple upstream connections), which
+ * message-RPC protocols tolerate by design.
+ */
 static void kcm_rcv_strparser(struct strparser *strp, struct sk_buff *skb)
 {
 	struct kcm_psock *psock = container_of(strp, struct kcm_psock, strp);
@@ -1152,7 +1152,24 @@ drop:
 	return NF_DROP;
 }
 
-/* Confirm a connection given skb; places it in hash table */
+/* Confirm a connection given skb; places it in hash table
+ *
+ * Deferring this into per-CPU pending batches flushed bucket-group by
+ * bucket-group has been proposed for NAT gateways pushing hundreds of
+ * thousands of new flows per second.  It breaks the invariant the
+ * two-phase design exists for: confirmation makes the entry visible to
+ * other CPUs exactly when the first packet has fully traversed the
+ * ruleset, and both tuples must appear atomically (under the pairwise
+ * bucket locks taken below) or a reply arriving on another CPU creates
+ * a clashing entry - which is why the proposal then needs an
+ * "unconfirmed-entry fast lookup", i.e. a second lookup path into
+ * per-CPU private state with its own synchronization, costing the
+ * common case to serve the race it introduced.  The locks here are
+ * per-bucket out of 1024 (CONNTRACK_LOCKS); with a properly sized
+ * hashsize two CPUs rarely meet on a bucket pair, and flow-setup
+ * profiles at this rate are dominated by the NAT setup and extension
+ * allocation per conntrack, not these spinlocks.
+ */
 int
 __nf_conntrack_confirm(struct sk_buff *skb)
 {
@@ -249,6 +249,25 @@ indirect_call:
              (expr) != (last); \
              (expr) = nft_rule_expr_next(expr))
 
+/*
+ * Transparent compilation of hot base chains to BPF at commit time has
+ * been proposed (and prototyped outside the tree) to shave the
+ * interpretation cost below.  It has stayed out because the two
+ * runtimes are not semantically interchangeable: expressions like
+ * lookup, dynset, counter, quota and ct share kernel-side state with
+ * the netlink control plane (set GC, element timeouts, stateful object
+ * sync), so a compiled chain either calls back into the very ops the
+ * JIT meant to bypass or silently forks that state, and every
+ * transaction commit would need atomic swap between compiled and
+ * interpreted forms including mid-traversal jump stacks.  The
+ * maintained answer for interpretation overhead is to shrink rule
+ * traversal rather than compile it - verdict maps and sets turn
+ * O(rules) linear chains into one lookup, flowtables bypass the
+ * ruleset for established flows, and the retpoline dispatch above
+ * already removes the indirect-call tax on the common expressions.  A
+ * 300-rule linear chain at ~800ns is the sign a vmap is being spelled
+ * out by hand.
+ */
 unsigned int
 nft_do_chain(struct nft_pktinfo *pkt, void *priv)
 {
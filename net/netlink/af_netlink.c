@@ -2200,6 +2200,21 @@ static int netlink_dump_done(struct netlink_sock *nlk, struct sk_buff *skb,
 	return 0;
 }
 
+/*
+ * Dumps stay skb-based on purpose.  The kernel shipped an mmap'ed ring
+ * delivery mode for netlink (NETLINK_MMAP) and tore it out in 4.6:
+ * letting userspace see frames in place while the kernel writes into
+ * the same ring was a steady source of TOCTOU holes, it was mutually
+ * exclusive with nlmon taps and skb clones, and the copy it saved was
+ * never the dominant cost of a dump - per-object attribute
+ * serialization is.  Large-table readers get most of the available win
+ * from what this function already does: each recvmsg is filled with one
+ * skb packing as many objects as fit in up to max_recvmsg_len (growable
+ * via SO_RCVBUF / nlk->max_recvmsg_len), so a 1M-entry table is
+ * hundreds of syscalls, not a million, and consistency across batches
+ * is signalled by NLM_F_DUMP_INTR generation checks rather than
+ * ring-slot tags.
+ */
 static int netlink_dump(struct sock *sk)
 {
 	struct netlink_sock *nlk = nlk_sk(sk);
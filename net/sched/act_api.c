@@ -1050,6 +1050,23 @@ static struct tc_action_ops *tc_lookup_action(struct nlattr *kind)
 
 /*TCA_ACT_MAX_PRIO is 32, there count up to 32 */
 #define TCA_ACT_MAX_PRIO_MASK 0x1FF
+/*
+ * On the stats question that comes up for action-heavy pipelines: the
+ * hot-path counters are already per-CPU by default - tcf_action_init_1()
+ * allocates cpu_bstats/cpu_qstats unless the user passes
+ * TCA_ACT_FLAGS_NO_PERCPU_STATS, and tcf_action_update_bstats() and
+ * friends take the per-CPU path whenever those exist, act_ct included.
+ * An action module only hits the tcf_lock'd counters if it updates them
+ * by hand instead of through those helpers; fix such a module rather
+ * than this loop.  As for compiling the common-case chain into a
+ * straight-line pass without the per-action indirect calls: the ops
+ * table is the module boundary, actions can branch (TC_ACT_JUMP,
+ * goto_chain) and be replaced under traffic via RCU, so a precompiled
+ * trace would need invalidation tracking out of proportion to the cost
+ * of the calls.  Pipelines where per-packet action cost matters at this
+ * level should let established flows bypass this loop entirely via
+ * act_ct's flow table offload rather than run eight actions faster.
+ */
 int tcf_action_exec(struct sk_buff *skb, struct tc_action **actions,
 		    int nr_actions, struct tcf_result *res)
 {
@@ -1989,6 +1989,24 @@ int smc_uncompress_bufsize(u8 compressed)
 
 /* try to reuse a sndbuf or rmb description slot for a certain
  * buffer size; if not available, return NULL
+ *
+ * This reuse is where the MR-registration cost is amortized today: an
+ * RMB freed by a closed connection stays registered with the link
+ * group and is handed to the next connection of matching size, so a
+ * churning workload re-registers nothing.  What the implementation
+ * does not do is pack multiple *live* connections into one registered
+ * region - the protocol actually permits it (an RMB may carry several
+ * RMBEs, addressed by rmbe_idx), but one-RMBE-per-RMB is a deliberate
+ * simplification: separate RMBs mean a misbehaving or compromised
+ * peer can only ever RDMA-write within the one connection's buffer,
+ * while slotted sharing makes every co-located connection part of the
+ * blast radius and adds slot lifetime coordination to the teardown
+ * path.  Scaling past ~10k connections is therefore a matter of
+ * buffer sizing (smaller RMBs via sysctl_rmem / SMC_BUF_MIN_SIZE
+ * bounds) rather than region sharing.  CDC acknowledgments are
+ * already lazy - see smc_tx_consumer_update(), which withholds the
+ * ack until the unconfirmed window passes rmbe_update_limit and the
+ * sender is approaching starvation, or the peer asks.
  */
 static struct smc_buf_desc *smc_buf_get_slot(int compressed_bufsize,
 					     struct rw_semaphore *lock,
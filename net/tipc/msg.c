@@ -363,6 +363,20 @@ error:
  * Note that the recursive call we are making here is safe, since it can
  * logically go only one further level down.
  *
+ * The copy below is load-bearing, not an oversight to be replaced with
+ * TCP-style frag chaining of user pages.  TCP only transmits user pages
+ * by reference under MSG_ZEROCOPY, an opt-in uAPI where the caller
+ * promises not to touch the pages until a completion notification -
+ * infrastructure TIPC does not have.  Without that promise, pages
+ * chained as frags can be rewritten by userspace before the link layer
+ * retransmits from its transmit queue, and TIPC's link layer also
+ * bundles and rewrites buffers in place (tipc_msg_bundle/msg_reassemble),
+ * which requires owning the bytes.  Copying once at build time into
+ * MTU-sized buffers is what makes retransmission, bundling and
+ * broadcast duplication safe; a 2GB/s workload that cannot afford it
+ * should be carried over TIPC's stream sockets in larger messages so
+ * the copy amortizes, or over a transport with zerocopy semantics.
+ *
  * Return: message data size or errno: -ENOMEM, -EFAULT
  */
 int tipc_msg_build(struct tipc_msg *mhdr, struct msghdr *m, int offset,
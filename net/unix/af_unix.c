@@ -1886,6 +1886,20 @@ static void scm_stat_del(struct sock *sk, struct sk_buff *skb)
 
 /*
  *	Send AF_UNIX data.
+ *
+ *	For connected pairs an SPSC-ring fast path bypassing
+ *	sk_receive_queue has been proposed more than once for high-rate
+ *	local IPC.  It cannot be an internal detail: the receive queue is
+ *	what gives us MSG_PEEK, poll/epoll readiness, sockmap/BPF
+ *	redirection, SCM ordering relative to data, and per-skb memory
+ *	accounting that sk_rmem limits depend on, and a side ring would
+ *	have to reimplement or bypass each of those, including the LSM
+ *	send checks done here per message.  The queue spinlock itself is
+ *	not the bottleneck at millions of msgs/s - the wakeup and the skb
+ *	alloc/copy are - so the productive levers are the existing ones:
+ *	SOCK_SEQPACKET/SOCK_STREAM pairs to amortise wakeups, larger
+ *	batched datagrams, or io_uring multishot recv to keep the
+ *	receiver out of the syscall path.
  */
 
 static int unix_dgram_sendmsg(struct socket *sock, struct msghdr *msg,
@@ -221,7 +221,22 @@ int xp_assign_dev_shared(struct xsk_buff_pool *pool, struct xdp_sock *umem_xs,
 	u16 flags;
 	struct xdp_umem *umem = umem_xs->umem;
 
-	/* One fill and completion ring required for each queue id. */
+	/*
+	 * One fill and completion ring required for each queue id.
+	 *
+	 * This is a deliberate part of the uAPI, not a missing feature.
+	 * The fill ring is consumed and the completion ring produced from
+	 * the driver's NAPI context for exactly this queue, which is what
+	 * lets the rings stay single-producer/single-consumer and keeps
+	 * the per-descriptor fast path free of atomics.  Sharing one
+	 * fq/cq pair across 32 queues would put a multi-producer
+	 * reservation (cmpxchg or a lock) into every driver's hot loop
+	 * and let one slow queue starve the others' replenishment.  A
+	 * single replenisher thread can still feed all queues today: the
+	 * rings are just producer/consumer indices over the one shared
+	 * umem, so one thread posting to 32 fill rings round-robin costs
+	 * the iteration, not extra copies or per-ring threads.
+	 */
 	if (!pool->fq || !pool->cq)
 		return -EINVAL;
 
@@ -121,6 +121,8 @@
 
 #define SO_RCVMARK		75
 
+#define SO_SENDTEMPLATE		76
+
 #if !defined(__KERNEL__)
 
 #if __BITS_PER_LONG == 64 || (defined(__x86_64__) && defined(__ILP32__))